@@ -38,13 +38,15 @@ UShellCmdClear_s uShellCmdClear = {0};    ///< UShellCmdClear object (base objec
  * \param writeSocket - UShell socket object for writing
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdClearExec(void* const cmd,
                                          UShellSocket_s* const readSocket,
                                          UShellSocket_s* const writeSocket,
                                          const int argc,
-                                         char* const argv []);
+                                         char* const argv [],
+                                         const UShellCmdCancel_s* const cancel);
 
 //=======================================================================[ PUBLIC INTERFACE FUNCTIONS ]=============================================================================
 
@@ -140,18 +142,21 @@ int UShellCmdClearDeinit()
  * \param writeSocket - UShell socket object for writing
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdClearExec(void* const cmd,
                                          UShellSocket_s* const readSocket,
                                          UShellSocket_s* const writeSocket,
                                          const int argc,
-                                         char* const argv [])
+                                         char* const argv [],
+                                         const UShellCmdCancel_s* const cancel)
 {
     /* Local variable */
     UShellCmdErr_e status = USHELL_CMD_NO_ERR;                // Variable to store command status
     UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Variable to store socket status
     (void) socketStatus;                                      // Variable to store socket status
+    (void) cancel;                                            // Suppress unused variable warning
 
     do
     {
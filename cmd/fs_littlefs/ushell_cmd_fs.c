@@ -31,91 +31,137 @@
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsCdExec(void* const cmd,
                                         UShellSocket_s* const readSocket,
                                         UShellSocket_s* const writeSocket,
                                         const int argc,
-                                        char* const argv []);
+                                        char* const argv [],
+                                        const UShellCmdCancel_s* const cancel);
 
 /**
  * \brief Execute the ls command.
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsLsExec(void* const cmd,
                                         UShellSocket_s* const readSocket,
                                         UShellSocket_s* const writeSocket,
                                         const int argc,
-                                        char* const argv []);
+                                        char* const argv [],
+                                        const UShellCmdCancel_s* const cancel);
 
 /**
  * \brief Execute the rm command.
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsRmExec(void* const cmd,
                                         UShellSocket_s* const readSocket,
                                         UShellSocket_s* const writeSocket,
                                         const int argc,
-                                        char* const argv []);
+                                        char* const argv [],
+                                        const UShellCmdCancel_s* const cancel);
 
 /**
  * \brief Execute the mkdir command.
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsMkdirExec(void* const cmd,
                                            UShellSocket_s* const readSocket,
                                            UShellSocket_s* const writeSocket,
                                            const int argc,
-                                           char* const argv []);
+                                           char* const argv [],
+                                           const UShellCmdCancel_s* const cancel);
 
 /**
  * \brief Execute the cat command.
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsCatExec(void* const cmd,
                                          UShellSocket_s* const readSocket,
                                          UShellSocket_s* const writeSocket,
                                          const int argc,
-                                         char* const argv []);
+                                         char* const argv [],
+                                         const UShellCmdCancel_s* const cancel);
 
 /**
  * \brief Execute the write command.
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsWriteExec(void* const cmd,
                                            UShellSocket_s* const readSocket,
                                            UShellSocket_s* const writeSocket,
                                            const int argc,
-                                           char* const argv []);
+                                           char* const argv [],
+                                           const UShellCmdCancel_s* const cancel);
 
 /**
  * \brief Execute the read command.
  * \param[in] cmd - UShellCmd object
  * \param[in] argc - number of arguments
  * \param[in] argv - array of arguments
+ * \param[in] cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsReadExec(void* const cmd,
                                           UShellSocket_s* const readSocket,
                                           UShellSocket_s* const writeSocket,
                                           const int argc,
-                                          char* const argv []);
+                                          char* const argv [],
+                                          const UShellCmdCancel_s* const cancel);
+
+/**
+ * \brief Execute the source command.
+ * \param[in] cmd - UShellCmd object
+ * \param[in] argc - number of arguments
+ * \param[in] argv - array of arguments
+ * \param[in] cancel - cancellation token
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdFsSourceExec(void* const cmd,
+                                            UShellSocket_s* const readSocket,
+                                            UShellSocket_s* const writeSocket,
+                                            const int argc,
+                                            char* const argv [],
+                                            const UShellCmdCancel_s* const cancel);
+
+/**
+ * \brief Execute one line of the script (source command).
+ * \note The command is found the way the shell finds it (the attached and the defined commands),
+ *       so it is executed and accounted as typed in the console.
+ * \param[in] cmd - source command (attached to the shell)
+ * \param[in] line - the line (terminated string, it is split in place)
+ * \param[in] readSocket - socket to read from
+ * \param[in] writeSocket - socket to write to
+ * \param[in] cancel - cancellation token
+ * \return UShellCmdErr_e - status of the line. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdFsSourceLineExec(UShellCmd_s* const cmd,
+                                                char* const line,
+                                                UShellSocket_s* const readSocket,
+                                                UShellSocket_s* const writeSocket,
+                                                const UShellCmdCancel_s* const cancel);
 
 /**
  * \brief Delay function for the xmodem server.
@@ -217,11 +263,64 @@ static XModemClientErr_e uShellCmdFsXModemClientTransmit(void* client,
                                                          const size_t size,
                                                          size_t timeMs);
 
+/**
+ * \brief Open the file of the redirection (cmd > file, cmd >> file).
+ * \param parent - UShellCmdFs object
+ * \param path - path of the file (relative to the current directory)
+ * \param isAppend - true to append to the file, false to truncate it
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdFsSinkOpen(void* const parent,
+                                          const char* const path,
+                                          const bool isAppend);
+
+/**
+ * \brief Write a block of the redirected output to the file.
+ * \param parent - UShellCmdFs object
+ * \param data - data to write
+ * \param size - size of the data
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdFsSinkWrite(void* const parent,
+                                           const char* const data,
+                                           const size_t size);
+
+/**
+ * \brief Close the file of the redirection.
+ * \param parent - UShellCmdFs object
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdFsSinkClose(void* const parent);
+
+/**
+ * \brief Lock the state of the fs cmds (lfs, current path, sink file, xmodem sockets).
+ * \note The lock is recursive: the source cmd runs the fs cmds of the script under it.
+ * \return none
+ */
+static void uShellCmdFsLock(void);
+
+/**
+ * \brief Unlock the state of the fs cmds.
+ * \return none
+ */
+static void uShellCmdFsUnlock(void);
+
 /**
  * \brief UShellCmdFsCd object (base object)
  */
 UShellCmdFs_s uShellCmdFs = {0};
 
+/**
+ * \brief Sink for the redirection of the shell (cmd > file)
+ */
+const UShellCmdSink_s uShellCmdFsSink =
+    {
+        .parent = &uShellCmdFs,
+        .open = uShellCmdFsSinkOpen,
+        .write = uShellCmdFsSinkWrite,
+        .close = uShellCmdFsSinkClose,
+};
+
 /**
  * \brief XModem Server Port
  */
@@ -247,6 +346,7 @@ static XModemClientPort_s uShellCmdFsXModemClientPort =
  */
 static UShellSocket_s* uShellCmdFsReadSocket = NULL;     ///< Pointer to the read socket
 static UShellSocket_s* uShellCmdFsWriteSocket = NULL;    ///< Pointer to the write socket
+static const UShellCmdCancel_s* uShellCmdFsCancel = NULL;    ///< Pointer to the cancellation token of the transfer
 
 //=======================================================================[ PUBLIC INTERFACE FUNCTIONS ]=============================================================================
 
@@ -254,24 +354,27 @@ static UShellSocket_s* uShellCmdFsWriteSocket = NULL;    ///< Pointer to the wri
  * \brief Initialize the commands for file system operations.
  * \param [in] rootCmd - pointer to the root command
  * \param [in] lfs - pointer to the lfs object
- * \param [in] vcp - pointer to the UShellVcp object
+ * \param [in] osal - pointer to the OSAL object (the lock of the fs state is created on it)
  * \param [out] none
  * \return UShellOsalErr_e - error code
  */
 int UShellCmdFsInit(UShellCmd_s* const rootCmd,
-                    lfs_t* const lfs)
+                    lfs_t* const lfs,
+                    UShellOsal_s* const osal)
 {
     /* Local variable */
-    int status = 0;                                  // Variable to store command status
-    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;    // Variable to store command status
+    int status = 0;                                     // Variable to store command status
+    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;       // Variable to store command status
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;    // Variable to store osal status
 
     do
     {
         /* Check input parameter */
         if ((lfs == NULL) ||
-            (rootCmd == NULL))
+            (rootCmd == NULL) ||
+            (osal == NULL))
         {
-            USHELL_CMD_FS_ASSERT(0);    // Set status to error if lfs or vcp is NULL
+            USHELL_CMD_FS_ASSERT(0);    // Set status to error if lfs, root cmd or osal is NULL
             status = -1;                // Set status to error
             break;                      // Exit the loop
         }
@@ -279,6 +382,17 @@ int UShellCmdFsInit(UShellCmd_s* const rootCmd,
         /* Flush  */
         memset(&uShellCmdFs, 0, sizeof(UShellCmdFs_s));    // Clear the command buffer
 
+        /* Create the lock (the cmds are called from the sessions once they are added) */
+        uShellCmdFs.osal = osal;
+        osalStatus = UShellOsalLockObjCreate(osal, &uShellCmdFs.lock);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (uShellCmdFs.lock == NULL))
+        {
+            USHELL_CMD_FS_ASSERT(0);    // Set status to error if the lock can not be created
+            status = -1;                // Set status to error
+            break;                      // Exit the loop
+        }
+
         /* Init ls command */
         cmdStatus = UShellCmdInit(&uShellCmdFs.cmdLs.cmd,
                                   USHELL_CMD_FS_LS_NAME,
@@ -396,6 +510,9 @@ int UShellCmdFsInit(UShellCmd_s* const rootCmd,
             break;                      // Exit the loop
         }
 
+        /* The transfer takes the raw input (the XModem blocks carry any byte, Ctrl-C too) */
+        UShellCmdInpSet(&uShellCmdFs.cmdWrite.cmd, USHELL_CMD_INP_RAW);
+
         /* Add cmd to root */
         cmdStatus = UShellCmdListAdd(rootCmd, &uShellCmdFs.cmdWrite.cmd);
         if (cmdStatus != USHELL_CMD_NO_ERR)
@@ -417,6 +534,9 @@ int UShellCmdFsInit(UShellCmd_s* const rootCmd,
             break;                      // Exit the loop
         }
 
+        /* The transfer takes the raw input (the XModem blocks carry any byte, Ctrl-C too) */
+        UShellCmdInpSet(&uShellCmdFs.cmdRead.cmd, USHELL_CMD_INP_RAW);
+
         /* Add cmd to root */
         cmdStatus = UShellCmdListAdd(rootCmd, &uShellCmdFs.cmdRead.cmd);
         if (cmdStatus != USHELL_CMD_NO_ERR)
@@ -426,6 +546,27 @@ int UShellCmdFsInit(UShellCmd_s* const rootCmd,
             break;                      // Exit the loop
         }
 
+        /* Init source command */
+        cmdStatus = UShellCmdInit(&uShellCmdFs.cmdSource.cmd,
+                                  USHELL_CMD_FS_SOURCE_NAME,
+                                  USHELL_CMD_FS_SOURCE_HELP,
+                                  uShellCmdFsSourceExec);
+        if (cmdStatus != USHELL_CMD_NO_ERR)
+        {
+            USHELL_CMD_FS_ASSERT(0);    // Set status to error if command initialization fails
+            status = -10;               // Set status to error
+            break;                      // Exit the loop
+        }
+
+        /* Add cmd to root */
+        cmdStatus = UShellCmdListAdd(rootCmd, &uShellCmdFs.cmdSource.cmd);
+        if (cmdStatus != USHELL_CMD_NO_ERR)
+        {
+            USHELL_CMD_FS_ASSERT(0);    // Set status to error if command attachment fails
+            status = -10;               // Set status to error
+            break;                      // Exit the loop
+        }
+
         /* Init xmodem command */
         XModemServerErr_e xmodemStatus = XModemServerInit(&uShellCmdFs.xModemServer,
                                                           &uShellCmdFsXModemServerPort,
@@ -444,6 +585,9 @@ int UShellCmdFsInit(UShellCmd_s* const rootCmd,
         /* Save the lfs object to the command object */
         uShellCmdFs.lfs = lfs;
 
+        /* Save the root command for the source command */
+        uShellCmdFs.rootCmd = rootCmd;
+
         /* Set the start path */
         strncpy(uShellCmdFs.path, USHELL_CMD_FS_START_PATH, sizeof(uShellCmdFs.path) - 1);
 
@@ -462,8 +606,9 @@ int UShellCmdFsInit(UShellCmd_s* const rootCmd,
 int UShellCmdFsDeinit()
 {
     /* Local variable */
-    int status = 0;                                  // Variable to store command status
-    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;    // Variable to store command status
+    int status = 0;                                     // Variable to store command status
+    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;       // Variable to store command status
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;    // Variable to store osal status
 
     do
     {
@@ -495,6 +640,18 @@ int UShellCmdFsDeinit()
             USHELL_CMD_FS_ASSERT(0);    // Set status to error if command deinitialization fails
         }
 
+        /* Delete the lock */
+        if (uShellCmdFs.lock != NULL)
+        {
+            osalStatus = UShellOsalLockObjDelete(uShellCmdFs.osal, uShellCmdFs.lock);
+            if (osalStatus != USHELL_OSAL_NO_ERR)
+            {
+                USHELL_CMD_FS_ASSERT(0);    // Set status to error if the lock can not be deleted
+                status = -1;                // Set status to error
+            }
+            uShellCmdFs.lock = NULL;
+        }
+
     } while (0);
 
     /* Return status */
@@ -508,23 +665,32 @@ int UShellCmdFsDeinit()
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsCdExec(void* const cmd,
                                         UShellSocket_s* const readSocket,
                                         UShellSocket_s* const writeSocket,
                                         const int argc,
-                                        char* const argv [])
+                                        char* const argv [],
+                                        const UShellCmdCancel_s* const cancel)
 {
     /* Local variable */
     UShellCmdErr_e status = USHELL_CMD_NO_ERR;                // Variable to store command status
     UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Variable to store socket status
     (void) socketStatus;
+    (void) cancel;
+    (void) cancel;
+    (void) cancel;
+    (void) cancel;
     const char* newDir = argv [0];
     char newPath [USHELL_CMD_FS_MAX_PATH] = {0};    // Buffer for the new path
     struct lfs_info info = {0};                     // Buffer for the file system info
     int statusFs = 0;                               // Variable to store file system status
 
+    /* Guard the shared state */
+    uShellCmdFsLock();
+
     do
     {
         /* Check input parameter */
@@ -606,6 +772,8 @@ static UShellCmdErr_e uShellCmdFsCdExec(void* const cmd,
 
     } while (0);
 
+    uShellCmdFsUnlock();
+
     /* Return status */
     return status;
 }
@@ -615,13 +783,15 @@ static UShellCmdErr_e uShellCmdFsCdExec(void* const cmd,
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsLsExec(void* const cmd,
                                         UShellSocket_s* const readSocket,
                                         UShellSocket_s* const writeSocket,
                                         const int argc,
-                                        char* const argv [])
+                                        char* const argv [],
+                                        const UShellCmdCancel_s* const cancel)
 {
     /* Local variable */
     UShellCmdErr_e status = USHELL_CMD_NO_ERR;                // Variable to store command status
@@ -632,6 +802,9 @@ static UShellCmdErr_e uShellCmdFsLsExec(void* const cmd,
     lfs_dir_t dir;
     struct lfs_info info;
 
+    /* Guard the shared state */
+    uShellCmdFsLock();
+
     /* Process the ls command */
     do
     {
@@ -696,6 +869,8 @@ static UShellCmdErr_e uShellCmdFsLsExec(void* const cmd,
 
     } while (0);
 
+    uShellCmdFsUnlock();
+
     return status;
 }
 
@@ -704,13 +879,15 @@ static UShellCmdErr_e uShellCmdFsLsExec(void* const cmd,
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsRmExec(void* const cmd,
                                         UShellSocket_s* const readSocket,
                                         UShellSocket_s* const writeSocket,
                                         const int argc,
-                                        char* const argv [])
+                                        char* const argv [],
+                                        const UShellCmdCancel_s* const cancel)
 {
     /* Local variable */
     UShellCmdErr_e status = USHELL_CMD_NO_ERR;
@@ -719,6 +896,9 @@ static UShellCmdErr_e uShellCmdFsRmExec(void* const cmd,
     char fullPath [USHELL_CMD_FS_MAX_PATH] = {0};
     int statusFs = 0;    // Variable to store file system status
 
+    /* Guard the shared state */
+    uShellCmdFsLock();
+
     /* Remove file or directory */
     do
     {
@@ -765,6 +945,8 @@ static UShellCmdErr_e uShellCmdFsRmExec(void* const cmd,
 
     } while (0);
 
+    uShellCmdFsUnlock();
+
     return status;
 }
 
@@ -773,13 +955,15 @@ static UShellCmdErr_e uShellCmdFsRmExec(void* const cmd,
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsMkdirExec(void* const cmd,
                                            UShellSocket_s* const readSocket,
                                            UShellSocket_s* const writeSocket,
                                            const int argc,
-                                           char* const argv [])
+                                           char* const argv [],
+                                           const UShellCmdCancel_s* const cancel)
 {
     /* Local variable */
     UShellCmdErr_e status = USHELL_CMD_NO_ERR;                // Variable to store command status
@@ -789,6 +973,9 @@ static UShellCmdErr_e uShellCmdFsMkdirExec(void* const cmd,
     char fullPath [USHELL_CMD_FS_MAX_PATH] = {0};
     int statusFs = 0;    // Variable to store file system status
 
+    /* Guard the shared state */
+    uShellCmdFsLock();
+
     /* Create directory */
     do
     {
@@ -835,6 +1022,8 @@ static UShellCmdErr_e uShellCmdFsMkdirExec(void* const cmd,
 
     } while (0);
 
+    uShellCmdFsUnlock();
+
     return status;    // Return success code
 }
 
@@ -843,13 +1032,15 @@ static UShellCmdErr_e uShellCmdFsMkdirExec(void* const cmd,
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsCatExec(void* const cmd,
                                          UShellSocket_s* const readSocket,
                                          UShellSocket_s* const writeSocket,
                                          const int argc,
-                                         char* const argv [])
+                                         char* const argv [],
+                                         const UShellCmdCancel_s* const cancel)
 {
     /* Local variable */
     UShellCmdErr_e status = USHELL_CMD_NO_ERR;                // Variable to store command status
@@ -859,8 +1050,13 @@ static UShellCmdErr_e uShellCmdFsCatExec(void* const cmd,
     char fullPath [USHELL_CMD_FS_MAX_PATH] = {0};    // Buffer for the full path
     lfs_file_t file;
     int lfsStatus = 0;
-    char buffer [32] = {0};    // Buffer for reading the file
+    char buffer [32] = {0};    // Buffer for reading the file (the stream is full)
     int bytes_read = 0;
+    UShellSocketItem_t* region = NULL;    // Region of the socket the file is read into
+    size_t regionSize = 0U;
+
+    /* Guard the shared state */
+    uShellCmdFsLock();
 
     /* Cat command */
     do
@@ -902,7 +1098,32 @@ static UShellCmdErr_e uShellCmdFsCatExec(void* const cmd,
         /* Read the file and print its content */
         while (1)
         {
-            bytes_read = lfs_file_read(uShellCmdFs.lfs, &file, buffer, sizeof(buffer));
+            /* Stop on Ctrl-C */
+            if (UShellCmdIsCanceled(cancel) == true)
+            {
+                status = USHELL_CMD_CANCELED_ERR;
+                break;
+            }
+
+            /* Read the file straight into the socket (it can be redirected) */
+            socketStatus = UShellSocketWriteReserve(writeSocket, &region, &regionSize);
+            if (socketStatus == USHELL_SOCKET_NO_ERR)
+            {
+                bytes_read = lfs_file_read(uShellCmdFs.lfs, &file, region, (lfs_size_t) regionSize);
+                socketStatus = UShellSocketWriteCommit(writeSocket,
+                                                       (bytes_read > 0) ? (size_t) bytes_read : 0U,
+                                                       USHELL_CMD_FS_CAT_WRITE_TIMEOUT_MS);
+            }
+            else
+            {
+                /* The stream is full, wait for the space by the blocking write */
+                bytes_read = lfs_file_read(uShellCmdFs.lfs, &file, buffer, sizeof(buffer));
+                socketStatus = (bytes_read > 0)
+                                   ? UShellSocketWriteBlocking(writeSocket, buffer, (size_t) bytes_read)
+                                   : USHELL_SOCKET_NO_ERR;
+            }
+            USHELL_CMD_FS_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);    // Check if the socket status is OK
+
             if (bytes_read == 0)
             {
                 break;    // End of file reached
@@ -915,7 +1136,6 @@ static UShellCmdErr_e uShellCmdFsCatExec(void* const cmd,
                 USHELL_CMD_FS_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);    // Check if the socket status is OK
                 break;
             }
-            printf("%.*s", bytes_read, buffer);
         }
 
         /* Print new line after reading the file */
@@ -929,6 +1149,8 @@ static UShellCmdErr_e uShellCmdFsCatExec(void* const cmd,
 
     } while (0);
 
+    uShellCmdFsUnlock();
+
     return status;
 }
 
@@ -937,13 +1159,15 @@ static UShellCmdErr_e uShellCmdFsCatExec(void* const cmd,
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsWriteExec(void* const cmd,
                                            UShellSocket_s* const readSocket,
                                            UShellSocket_s* const writeSocket,
                                            const int argc,
-                                           char* const argv [])
+                                           char* const argv [],
+                                           const UShellCmdCancel_s* const cancel)
 {
     UShellCmdErr_e status = USHELL_CMD_NO_ERR;
     UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
@@ -953,6 +1177,9 @@ static UShellCmdErr_e uShellCmdFsWriteExec(void* const cmd,
     int statusFs = 0;
     lfs_file_t file;
 
+    /* Guard the shared state */
+    uShellCmdFsLock();
+
     do
     {
         /* Check input parameter */
@@ -967,6 +1194,7 @@ static UShellCmdErr_e uShellCmdFsWriteExec(void* const cmd,
         /* Save socket for xmodem server */
         uShellCmdFsReadSocket = readSocket;      // Save the read socket for xmodem server
         uShellCmdFsWriteSocket = writeSocket;    // Save the write socket for xmodem server
+        uShellCmdFsCancel = cancel;              // Save the cancellation token for xmodem server
 
         /* Form the full path using the current directory and the provided file name */
         if (uShellCmdFs.path [strlen(uShellCmdFs.path) - 1] == '/')
@@ -1021,9 +1249,12 @@ static UShellCmdErr_e uShellCmdFsWriteExec(void* const cmd,
 
     } while (0);
 
-    /* Flush the socket  */
+    /* Flush the socket (under the lock, the next transfer sets them under it) */
     uShellCmdFsReadSocket = NULL;     // Save the read socket for xmodem server
     uShellCmdFsWriteSocket = NULL;    // Save the write socket for xmodem server
+    uShellCmdFsCancel = NULL;         // Save the cancellation token for xmodem server
+
+    uShellCmdFsUnlock();
 
     return status;
 }
@@ -1033,13 +1264,15 @@ static UShellCmdErr_e uShellCmdFsWriteExec(void* const cmd,
  * \param[in] cmd - UShellCmd object
  * \param[in] argc - number of arguments
  * \param[in] argv - array of arguments
+ * \param[in] cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdFsReadExec(void* const cmd,
                                           UShellSocket_s* const readSocket,
                                           UShellSocket_s* const writeSocket,
                                           const int argc,
-                                          char* const argv [])
+                                          char* const argv [],
+                                          const UShellCmdCancel_s* const cancel)
 {
     UShellCmdErr_e status = USHELL_CMD_NO_ERR;
     UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Variable to store socket status
@@ -1048,6 +1281,9 @@ static UShellCmdErr_e uShellCmdFsReadExec(void* const cmd,
     int statusFs = 0;
     lfs_file_t file;
 
+    /* Guard the shared state */
+    uShellCmdFsLock();
+
     do
     {
         /* Check input parameter */
@@ -1062,6 +1298,7 @@ static UShellCmdErr_e uShellCmdFsReadExec(void* const cmd,
         /* Save socket for xmodem server */
         uShellCmdFsReadSocket = readSocket;      // Save the read socket for xmodem server
         uShellCmdFsWriteSocket = writeSocket;    // Save the write socket for xmodem server
+        uShellCmdFsCancel = cancel;              // Save the cancellation token for xmodem server
 
         /* Form the full path using the current directory and the provided file name */
         if (uShellCmdFs.path [strlen(uShellCmdFs.path) - 1] == '/')
@@ -1115,9 +1352,454 @@ static UShellCmdErr_e uShellCmdFsReadExec(void* const cmd,
 
     } while (0);
 
-    /* Flush the socket  */
+    /* Flush the socket (under the lock, the next transfer sets them under it) */
     uShellCmdFsReadSocket = NULL;     // Save the read socket for xmodem server
     uShellCmdFsWriteSocket = NULL;    // Save the write socket for xmodem server
+    uShellCmdFsCancel = NULL;         // Save the cancellation token for xmodem server
+
+    uShellCmdFsUnlock();
+
+    return status;
+}
+
+/**
+ * \brief Execute the source command.
+ * \param[in] cmd - UShellCmd object
+ * \param[in] argc - number of arguments
+ * \param[in] argv - array of arguments
+ * \param[in] cancel - cancellation token
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ *
+ * The script is read by blocks and split into lines, every line is executed by the command list directly:
+ * there is no echo, prompt or redraw, only the status of every line and the total time are printed.
+ * Empty lines and lines starting with '#' are skipped.
+ * The fs lock is taken for every access to the script only: the lines run unlocked, so the other sessions keep
+ * the fs while the script runs. A script is bound to the session by the cancellation token of its job.
+ */
+static UShellCmdErr_e uShellCmdFsSourceExec(void* const cmd,
+                                            UShellSocket_s* const readSocket,
+                                            UShellSocket_s* const writeSocket,
+                                            const int argc,
+                                            char* const argv [],
+                                            const UShellCmdCancel_s* const cancel)
+{
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+    UShellCmdErr_e lineStatus = USHELL_CMD_NO_ERR;
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
+    (void) socketStatus;
+    UShellCmdFsSourceRun_s run = {0};    // The script buffers are on the stack, nested scripts are not allowed
+    UShellCmdFsSourceRun_s** runNode = NULL;
+    bool isNested = false;
+    const char* fileName = argv [0];
+    char fullPath [USHELL_CMD_FS_MAX_PATH] = {0};
+    char line [USHELL_CMD_FS_SOURCE_LINE_SIZE] = {0};
+    char block [32] = {0};
+    size_t lineLen = 0U;
+    bool lineIsTooLong = false;
+    bool isEof = false;
+    unsigned int lineNum = 0U;
+    unsigned int lineFailed = 0U;
+    UShellOsalTimeMs_t startMs = 0U;
+    UShellOsalTimeMs_t stopMs = 0U;
+    int bytesRead = 0;
+    int statusFs = 0;
+    lfs_file_t file;
+
+    do
+    {
+        /* Check input parameter */
+        if (argc != 1)
+        {
+            socketStatus = UShellSocketPrint(writeSocket,
+                                             "Usage: source <file>\n");
+            USHELL_CMD_FS_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);    // Check if the socket status is OK
+            break;
+        }
+
+        uShellCmdFsLock();
+
+        /* Check the script is not started by a script of the same session */
+        for (UShellCmdFsSourceRun_s* node = uShellCmdFs.cmdSource.run; node != NULL; node = node->next)
+        {
+            if (node->cancel == cancel)
+            {
+                isNested = true;
+                break;
+            }
+        }
+
+        /* Form the full path using the current directory and the provided file name */
+        if (uShellCmdFs.path [strlen(uShellCmdFs.path) - 1] == '/')
+            snprintf(fullPath, sizeof(fullPath), "%s%s", uShellCmdFs.path, fileName);
+        else
+            snprintf(fullPath, sizeof(fullPath), "%s/%s", uShellCmdFs.path, fileName);
+
+        /* Open the script and register it in the running scripts */
+        statusFs = -1;
+        if (isNested == false)
+        {
+            statusFs = lfs_file_open(uShellCmdFs.lfs,
+                                     &file,
+                                     fullPath,
+                                     LFS_O_RDONLY);
+        }
+        if (statusFs >= 0)
+        {
+            run.cancel = cancel;
+            run.next = uShellCmdFs.cmdSource.run;
+            uShellCmdFs.cmdSource.run = &run;
+        }
+
+        uShellCmdFsUnlock();
+
+        if (isNested == true)
+        {
+            socketStatus = UShellSocketPrint(writeSocket,
+                                             "source: nested scripts are not supported\n");
+            USHELL_CMD_FS_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);    // Check if the socket status is OK
+            break;
+        }
+
+        if (statusFs < 0)
+        {
+            socketStatus = UShellSocketPrint(writeSocket,
+                                             "source: cannot open file %s\n",
+                                             fullPath);
+            USHELL_CMD_FS_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);    // Check if the socket status is OK
+            break;
+        }
+
+        UShellOsalTimeMsGet(uShellCmdFs.osal, &startMs);
+
+        /* Read the script by blocks */
+        while (isEof == false)
+        {
+            uShellCmdFsLock();
+            bytesRead = lfs_file_read(uShellCmdFs.lfs, &file, block, sizeof(block));
+            uShellCmdFsUnlock();
+            if (bytesRead < 0)
+            {
+                socketStatus = UShellSocketPrint(writeSocket,
+                                                 "source: error reading file %s\n",
+                                                 fullPath);
+                USHELL_CMD_FS_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);    // Check if the socket status is OK
+                break;
+            }
+
+            /* The end of the file closes the last line (it may have no line feed) */
+            if (bytesRead == 0)
+            {
+                block [0] = '\n';
+                bytesRead = 1;
+                isEof = true;
+            }
+
+            for (int ind = 0; ind < bytesRead; ind++)
+            {
+                /* Collect the line */
+                if (block [ind] == '\r')
+                {
+                    continue;
+                }
+
+                if (block [ind] != '\n')
+                {
+                    if (lineLen < (sizeof(line) - 1U))
+                    {
+                        line [lineLen++] = block [ind];
+                    }
+                    else
+                    {
+                        lineIsTooLong = true;
+                    }
+                    continue;
+                }
+
+                /* Execute the line (skip the empty lines and the comments) */
+                line [lineLen] = '\0';
+                if ((lineLen > 0U) &&
+                    (line [0] != '#'))
+                {
+                    lineNum++;
+                    lineStatus = (lineIsTooLong == true)
+                                     ? USHELL_CMD_EXECUTE_NUMB_ARGS_ERR
+                                     : uShellCmdFsSourceLineExec((UShellCmd_s*) cmd, line, readSocket, writeSocket, cancel);
+                    if (lineStatus != USHELL_CMD_NO_ERR)
+                    {
+                        lineFailed++;
+                    }
+
+                    socketStatus = UShellSocketPrint(writeSocket,
+                                                     "source: %u: %s (%d)\n",
+                                                     lineNum,
+                                                     (lineStatus == USHELL_CMD_NO_ERR) ? "ok" : "fail",
+                                                     (int) lineStatus);
+                    USHELL_CMD_FS_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);    // Check if the socket status is OK
+                }
+
+                /* Start the next line */
+                lineLen = 0U;
+                lineIsTooLong = false;
+
+                /* Stop on Ctrl-C */
+                if (UShellCmdIsCanceled(cancel) == true)
+                {
+                    status = USHELL_CMD_CANCELED_ERR;
+                    isEof = true;
+                    break;
+                }
+            }
+        }
+
+        /* Print the summary */
+        UShellOsalTimeMsGet(uShellCmdFs.osal, &stopMs);
+        socketStatus = UShellSocketPrint(writeSocket,
+                                         "source: %u lines, %u failed, %u ms\n",
+                                         lineNum,
+                                         lineFailed,
+                                         (unsigned int) (stopMs - startMs));
+        USHELL_CMD_FS_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);    // Check if the socket status is OK
+
+        /* Close the script and remove it from the running scripts */
+        uShellCmdFsLock();
+        lfs_file_close(uShellCmdFs.lfs, &file);
+        for (runNode = &uShellCmdFs.cmdSource.run; *runNode != NULL; runNode = &(*runNode)->next)
+        {
+            if (*runNode == &run)
+            {
+                *runNode = run.next;
+                break;
+            }
+        }
+        uShellCmdFsUnlock();
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Execute one line of the script (source command).
+ * \note The command is found the way the shell finds it (the attached and the defined commands),
+ *       so it is executed and accounted as typed in the console.
+ * \param[in] cmd - source command (attached to the shell)
+ * \param[in] line - the line (terminated string, it is split in place)
+ * \param[in] readSocket - socket to read from
+ * \param[in] writeSocket - socket to write to
+ * \param[in] cancel - cancellation token
+ * \return UShellCmdErr_e - status of the line. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdFsSourceLineExec(UShellCmd_s* const cmd,
+                                                char* const line,
+                                                UShellSocket_s* const readSocket,
+                                                UShellSocket_s* const writeSocket,
+                                                const UShellCmdCancel_s* const cancel)
+{
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+    UShellCmd_s* lineCmd = NULL;
+    UShellCmd_s lineProxy = {0};    // The defined command is executed through it
+    char* lineArgv [USHELL_CMD_MAX_ARGV + 1] = {NULL};
+    int lineArgc = 0;
+
+    do
+    {
+        /* Split the line into arguments (argv [0] is the command name) */
+        status = UShellCmdArgsParse(line,
+                                    lineArgv,
+                                    USHELL_CMD_MAX_ARGV + 1,
+                                    &lineArgc);
+        if ((status != USHELL_CMD_NO_ERR) ||
+            (lineArgc == 0))
+        {
+            break;
+        }
+
+        /* Find the command through the shell index (the list without the shell) */
+        status = UShellCmdFind(cmd,
+                               lineArgv [0],
+                               &lineProxy,
+                               &lineCmd);
+        if (status == USHELL_CMD_NOT_INIT_ERR)
+        {
+            status = UShellCmdListFind(uShellCmdFs.rootCmd,
+                                       lineArgv [0],
+                                       &lineCmd);
+        }
+        if ((status != USHELL_CMD_NO_ERR) ||
+            (lineCmd == NULL))
+        {
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Execute the command (skip the command name) */
+        status = UShellCmdExec(lineCmd,
+                               readSocket,
+                               writeSocket,
+                               lineArgc - 1,
+                               &lineArgv [1],
+                               cancel);
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Open the file of the redirection (cmd > file, cmd >> file).
+ * \param parent - UShellCmdFs object
+ * \param path - path of the file (relative to the current directory)
+ * \param isAppend - true to append to the file, false to truncate it
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdFsSinkOpen(void* const parent,
+                                          const char* const path,
+                                          const bool isAppend)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+    UShellCmdFs_s* fs = (UShellCmdFs_s*) parent;
+    char fullPath [USHELL_CMD_FS_MAX_PATH] = {0};    // Buffer for the full path
+    int flags = LFS_O_WRONLY | LFS_O_CREAT;
+    int lfsStatus = 0;
+
+    /* Guard the shared state */
+    uShellCmdFsLock();
+
+    do
+    {
+        /* Check input parameter */
+        if ((fs == NULL) ||
+            (fs->lfs == NULL) ||
+            (path == NULL))
+        {
+            USHELL_CMD_FS_ASSERT(0);    // Set status to error if fs or path is NULL
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* One redirection at a time */
+        if (fs->sinkIsOpen == true)
+        {
+            status = USHELL_CMD_PORT_ERR;
+            break;
+        }
+
+        /* Add the directory path to the full path */
+        if (fs->path [strlen(fs->path) - 1] == '/')
+        {
+            snprintf(fullPath, sizeof(fullPath), "%s%s", fs->path, path);
+        }
+        else
+        {
+            snprintf(fullPath, sizeof(fullPath), "%s/%s", fs->path, path);
+        }
+
+        /* Open the file */
+        flags |= (isAppend == true)
+                     ? LFS_O_APPEND
+                     : LFS_O_TRUNC;
+        lfsStatus = lfs_file_open(fs->lfs, &fs->sinkFile, fullPath, flags);
+        if (lfsStatus < 0)
+        {
+            status = USHELL_CMD_PORT_ERR;
+            break;
+        }
+
+        fs->sinkIsOpen = true;
+
+    } while (0);
+
+    uShellCmdFsUnlock();
+
+    return status;
+}
+
+/**
+ * \brief Write a block of the redirected output to the file.
+ * \param parent - UShellCmdFs object
+ * \param data - data to write
+ * \param size - size of the data
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdFsSinkWrite(void* const parent,
+                                           const char* const data,
+                                           const size_t size)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+    UShellCmdFs_s* fs = (UShellCmdFs_s*) parent;
+    lfs_ssize_t written = 0;
+
+    /* Guard the shared state */
+    uShellCmdFsLock();
+
+    do
+    {
+        /* Check input parameter */
+        if ((fs == NULL) ||
+            (data == NULL) ||
+            (fs->sinkIsOpen == false))
+        {
+            USHELL_CMD_FS_ASSERT(0);    // Set status to error if the file is not open
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Write the block (the shell gives whole blocks, so the file is not synced here) */
+        written = lfs_file_write(fs->lfs, &fs->sinkFile, data, size);
+        if ((written < 0) ||
+            ((size_t) written != size))
+        {
+            status = USHELL_CMD_PORT_ERR;
+            break;
+        }
+
+    } while (0);
+
+    uShellCmdFsUnlock();
+
+    return status;
+}
+
+/**
+ * \brief Close the file of the redirection.
+ * \param parent - UShellCmdFs object
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdFsSinkClose(void* const parent)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+    UShellCmdFs_s* fs = (UShellCmdFs_s*) parent;
+    int lfsStatus = 0;
+
+    /* Guard the shared state */
+    uShellCmdFsLock();
+
+    do
+    {
+        /* Check input parameter */
+        if ((fs == NULL) ||
+            (fs->sinkIsOpen == false))
+        {
+            USHELL_CMD_FS_ASSERT(0);    // Set status to error if the file is not open
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Close the file (it is synced by the close) */
+        lfsStatus = lfs_file_close(fs->lfs, &fs->sinkFile);
+        fs->sinkIsOpen = false;
+        if (lfsStatus < 0)
+        {
+            status = USHELL_CMD_PORT_ERR;
+            break;
+        }
+
+    } while (0);
+
+    uShellCmdFsUnlock();
 
     return status;
 }
@@ -1195,6 +1877,13 @@ static XModemServerErr_e uShellCmdFsXModemServerReceive(void* server, uint8_t* d
             break;                                      // Exit the loop
         }
 
+        /* Abort the transfer on Ctrl-C */
+        if (UShellCmdIsCanceled(uShellCmdFsCancel) == true)
+        {
+            status = XMODEM_SERVER_PORT_ERR;    // Set status to error
+            break;                              // Exit the loop
+        }
+
         /* Send byte */
         socketStatus = UShellSocketRead(socket,
                                         data,
@@ -1357,6 +2046,13 @@ static XModemClientErr_e uShellCmdFsXModemClientReceive(void* client, uint8_t* c
             break;                                      // Exit the loop
         }
 
+        /* Abort the transfer on Ctrl-C */
+        if (UShellCmdIsCanceled(uShellCmdFsCancel) == true)
+        {
+            status = XMODEM_SERVER_PORT_ERR;    // Set status to error
+            break;                              // Exit the loop
+        }
+
         /* Send byte */
         socketStatus = UShellSocketRead(socket,
                                         data,
@@ -1419,3 +2115,39 @@ static XModemClientErr_e uShellCmdFsXModemClientTransmit(void* client, uint8_t*
 
     return status;
 }
+
+/**
+ * \brief Lock the state of the fs cmds.
+ * \return none
+ */
+static void uShellCmdFsLock(void)
+{
+    /* Local variable */
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+
+    /* Lock (no lock before the init) */
+    if (uShellCmdFs.lock != NULL)
+    {
+        osalStatus = UShellOsalLock(uShellCmdFs.osal, uShellCmdFs.lock);
+        USHELL_CMD_FS_ASSERT(osalStatus == USHELL_OSAL_NO_ERR);
+        (void) osalStatus;
+    }
+}
+
+/**
+ * \brief Unlock the state of the fs cmds.
+ * \return none
+ */
+static void uShellCmdFsUnlock(void)
+{
+    /* Local variable */
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+
+    /* Unlock */
+    if (uShellCmdFs.lock != NULL)
+    {
+        osalStatus = UShellOsalUnlock(uShellCmdFs.osal, uShellCmdFs.lock);
+        USHELL_CMD_FS_ASSERT(osalStatus == USHELL_OSAL_NO_ERR);
+        (void) osalStatus;
+    }
+}
\ No newline at end of file
@@ -15,9 +15,11 @@ extern "C" {
 #include <stdio.h>
 
 #include "FreeRTOS.h"
+#include "task.h"
 #include "lfs.h"
 #include "ushell_cfg.h"
 #include "ushell_cmd.h"
+#include "ushell_osal.h"
 #include "xmodem_server.h"
 #include "xmodem_client.h"
 
@@ -126,6 +128,34 @@ extern "C" {
     #define USHELL_CMD_FS_READ_HELP "read a file using XModem transfer (usage: read <name>)"
 #endif
 
+/**
+ * \brief UShell command name for source
+ */
+#ifndef USHELL_CMD_FS_SOURCE_NAME
+    #define USHELL_CMD_FS_SOURCE_NAME "source"    ///< UShell command name for source
+#endif
+
+/**
+ * \brief UShell command help for source
+ */
+#ifndef USHELL_CMD_FS_SOURCE_HELP
+    #define USHELL_CMD_FS_SOURCE_HELP "run the commands of a script file (usage: source <file>)"
+#endif
+
+/**
+ * \brief UShell maximum length of a script line (source command)
+ */
+#ifndef USHELL_CMD_FS_SOURCE_LINE_SIZE
+    #define USHELL_CMD_FS_SOURCE_LINE_SIZE 128    ///< Maximum length of a script line
+#endif
+
+/**
+ * \brief UShell timeout of one chunk of the file written by the cat command
+ */
+#ifndef USHELL_CMD_FS_CAT_WRITE_TIMEOUT_MS
+    #define USHELL_CMD_FS_CAT_WRITE_TIMEOUT_MS 1000U    ///< Timeout of the chunk write (ms)
+#endif
+
 /*========================================================[DATA TYPES DEFINITIONS]==========================================*/
 
 /**
@@ -187,6 +217,26 @@ typedef struct
 
 } UShellCmdFsRead_s;
 
+/**
+ * \brief Describe a running script of the source command (it lives on the stack of the source command).
+ */
+typedef struct UShellCmdFsSourceRun_s
+{
+    const UShellCmdCancel_s* cancel;        ///< Cancellation token of the session running the script
+    struct UShellCmdFsSourceRun_s* next;    ///< Next running script
+
+} UShellCmdFsSourceRun_s;
+
+/**
+ * \brief Describe UShellCmdFsSource.
+ */
+typedef struct
+{
+    UShellCmd_s cmd;                ///< UShellCmd object (base object)
+    UShellCmdFsSourceRun_s* run;    ///< Scripts running in the sessions (a nested script of the same session is refused)
+
+} UShellCmdFsSource_s;
+
 /**
  * \brief UShellCmdFs object (base object)
  */
@@ -195,6 +245,8 @@ typedef struct
     /* Dependent objects */
     lfs_t* lfs;    ///< LittleFS object
     lfs_file_t* currentFile;
+    UShellCmd_s* rootCmd;    ///< Root command (the source command runs the commands of the list)
+    UShellOsal_s* osal;      ///< OSAL object (the lock of the fs state)
 
     /* Internal use  */
     XModemServer_s xModemServer;           ///< UShellCmd object (base object)
@@ -207,6 +259,10 @@ typedef struct
     UShellCmdFsCat_s cmdCat;               ///< UShellCmd object (base object)
     UShellCmdFsWrite_s cmdWrite;           ///< UShellCmd object (base object)
     UShellCmdFsRead_s cmdRead;             ///< UShellCmd object (base object)
+    UShellCmdFsSource_s cmdSource;         ///< UShellCmd object (base object)
+    lfs_file_t sinkFile;                   ///< File of the redirection (cmd > file)
+    bool sinkIsOpen;                       ///< Flag to indicate the file of the redirection is open
+    UShellOsalLockObjHandle_t lock;        ///< Lock of the fs state (the cmds run from several sessions)
 
 } UShellCmdFs_s;
 
@@ -217,16 +273,19 @@ typedef struct
  */
 extern UShellCmdFs_s uShellCmdFs;    ///< UShellCmd object (base object)
 
+extern const UShellCmdSink_s uShellCmdFsSink;    ///< Sink for the redirection of the shell (attach by UShellRedirectSinkAttach)
+
 /**
  * \brief Initialize the commands for file system operations.
  * \param [in] rootCmd - pointer to the root command
  * \param [in] lfs - pointer to the lfs object
- * \param [in] vcp - pointer to the UShellVcp object
+ * \param [in] osal - pointer to the OSAL object (the lock of the fs state is created on it)
  * \param [out] none
  * \return UShellOsalErr_e - error code
  */
 int UShellCmdFsInit(UShellCmd_s* const rootCmd,
-                    lfs_t* const lfs);
+                    lfs_t* const lfs,
+                    UShellOsal_s* const osal);
 
 /**
  * \brief Deinitialize the UShell cmd
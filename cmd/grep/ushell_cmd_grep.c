@@ -0,0 +1,279 @@
+/**
+ * \file         ushell_cmd_grep.c
+ * \brief        The file contains the implementation of the UShell command grep module.
+ * \authors      Vladislav Kosten (vladkosten@gmail.com)
+ * \copyright    MIT License (c) 2025
+ * \warning      A warning may be placed here...
+ * \bug          Bug report may be placed here...
+ */
+//===============================================================================[ INCLUDE ]========================================================================================
+
+#include "ushell_cmd_grep.h"
+//=====================================================================[ INTERNAL MACRO DEFINITIONS ]===============================================================================
+/**
+ * \brief Assert macro for the grep module.
+ */
+#ifndef USHELL_CMD_GREP_ASSERT
+    #ifdef USHELL_ASSERT
+        #define USHELL_CMD_GREP_ASSERT(cond) USHELL_ASSERT(cond)
+    #else
+        #define USHELL_CMD_GREP_ASSERT(cond)
+    #endif
+#endif
+
+//====================================================================[ INTERNAL DATA TYPES DEFINITIONS ]===========================================================================
+
+//===============================================================[ INTERNAL FUNCTIONS AND OBJECTS DECLARATION ]=====================================================================
+
+/**
+ * \brief UShellCmdGrep object (base object)
+ */
+UShellCmdGrep_s uShellCmdGrep = {0};    ///< UShellCmdGrep object (base object)
+
+/**
+ * \brief Execute the grep command.
+ * \note The command reads the input (the output of the left command of the pipe) up to its end:
+ *       the read socket fails with USHELL_SOCKET_EMPTY_ERR when the left command is done and the pipe is drained.
+ * \param cmd - UShellCmd object
+ * \param readSocket - UShell socket object for reading
+ * \param writeSocket - UShell socket object for writing
+ * \param argc - number of arguments
+ * \param argv - array of arguments
+ * \param cancel - cancellation token
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdGrepExec(void* const cmd,
+                                        UShellSocket_s* const readSocket,
+                                        UShellSocket_s* const writeSocket,
+                                        const int argc,
+                                        char* const argv [],
+                                        const UShellCmdCancel_s* const cancel);
+
+/**
+ * \brief Print the line if it contains the pattern.
+ * \param writeSocket - UShell socket object for writing
+ * \param line - terminated line
+ * \param pattern - pattern to be found
+ * \return none
+ */
+static void uShellCmdGrepLineProc(UShellSocket_s* const writeSocket,
+                                  const char* const line,
+                                  const char* const pattern);
+
+//=======================================================================[ PUBLIC INTERFACE FUNCTIONS ]=============================================================================
+
+/**
+ * \brief Initialize the UShell cmd grep module.
+ * \param [in] rootCmd - The first cmd in the list of commands to be initialized
+ * \param [out] none
+ * \return int - error code
+ */
+int UShellCmdGrepInit(UShellCmd_s* rootCmd)
+{
+    /* Local variable */
+    int status = 0;                                  // Variable to store the status of the operation
+    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;    // Variable to store command status
+
+    do
+    {
+        /* Check input */
+        if (rootCmd == NULL)
+        {
+            USHELL_CMD_GREP_ASSERT(0);    // Set status to error if root command is NULL
+            status = -1;                  // Set status to error if root command is NULL
+            break;                        // Exit the loop
+        }
+
+        /* Initialize the UShellCmdGrep object */
+        memset(&uShellCmdGrep, 0, sizeof(uShellCmdGrep));
+
+        /* Init the base class */
+        cmdStatus = UShellCmdInit(&uShellCmdGrep.cmd,
+                                  USHELL_CMD_GREP_NAME,
+                                  USHELL_CMD_GREP_HELP,
+                                  uShellCmdGrepExec);
+        if (cmdStatus != USHELL_CMD_NO_ERR)
+        {
+            USHELL_CMD_GREP_ASSERT(0);    // Set status to error if command initialization fails
+            status = -2;                  // Set status to error if command initialization fails
+            break;                        // Exit the loop
+        }
+
+        /* Add cmd to root */
+        cmdStatus = UShellCmdListAdd(rootCmd, &uShellCmdGrep.cmd);
+        if (cmdStatus != USHELL_CMD_NO_ERR)
+        {
+            USHELL_CMD_GREP_ASSERT(0);    // Set status to error if command attachment fails
+            status = -3;                  // Set status to error if command attachment fails
+            break;                        // Exit the loop
+        }
+
+    } while (0);
+
+    return status;    // Return success code
+}
+
+/**
+ * \brief Deinitialize the UShell cmd grep module.
+ * \param [in] none
+ * \param [out] none
+ * \return int - error code
+ */
+int UShellCmdGrepDeinit()
+{
+    /* Local variable */
+    int status = 0;                                  // Variable to store the status of the operation
+    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;    // Variable to store command status
+
+    do
+    {
+        /* Deinit the UShellCmdGrep object */
+        cmdStatus = UShellCmdDeinit(&uShellCmdGrep.cmd);
+        if (cmdStatus != USHELL_CMD_NO_ERR)
+        {
+            USHELL_CMD_GREP_ASSERT(0);    // Set status to error if command deinitialization fails
+            status = -1;                  // Set status to error if command deinitialization fails
+            break;                        // Exit the loop
+        }
+
+        /* Clear the UShellCmdGrep object */
+        memset(&uShellCmdGrep, 0, sizeof(uShellCmdGrep));
+
+    } while (0);
+
+    return status;    // Return success code
+}
+
+//============================================================================ [PRIVATE FUNCTIONS ]=================================================================================
+
+/**
+ * \brief Execute the grep command.
+ * \note The command reads the input (the output of the left command of the pipe) up to its end:
+ *       the read socket fails with USHELL_SOCKET_EMPTY_ERR when the left command is done and the pipe is drained.
+ * \param cmd - UShellCmd object
+ * \param readSocket - UShell socket object for reading
+ * \param writeSocket - UShell socket object for writing
+ * \param argc - number of arguments
+ * \param argv - array of arguments
+ * \param cancel - cancellation token
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdGrepExec(void* const cmd,
+                                        UShellSocket_s* const readSocket,
+                                        UShellSocket_s* const writeSocket,
+                                        const int argc,
+                                        char* const argv [],
+                                        const UShellCmdCancel_s* const cancel)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;                // Variable to store command status
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Variable to store socket status
+    UShellSocketItem_t chunk [32] = {0};                      // Items taken by one read
+    size_t chunkLen = 0U;                                     // Number of the items taken by one read
+    char line [USHELL_CMD_GREP_LINE_SIZE] = {0};              // Current input line
+    size_t lineLen = 0U;                                      // Length of the current input line
+
+    do
+    {
+        /* Check input parameter */
+        if ((cmd == NULL) ||
+            (cmd != &uShellCmdGrep.cmd) ||
+            (readSocket == NULL) ||
+            (writeSocket == NULL))
+        {
+            status = USHELL_CMD_INVALID_ARGS_ERR;    // Set status to error if command is NULL
+            break;                                   // Exit the loop
+        }
+
+        /* We need the pattern only */
+        if (argc != 1)
+        {
+            socketStatus = UShellSocketPrint(writeSocket,
+                                             "grep : Invalid arguments (grep <pattern>)\n");    // Print error message for invalid arguments
+            USHELL_CMD_GREP_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);                      // Set status to error if socket write fails
+            status = USHELL_CMD_INVALID_ARGS_ERR;                                              // Set status to error
+            break;                                                                             // Exit the loop
+        }
+
+        /* Read the input up to its end, the timeout lets the cancellation in */
+        while (1)
+        {
+            if (UShellCmdIsCanceled(cancel) == true)
+            {
+                status = USHELL_CMD_CANCELED_ERR;
+                break;
+            }
+
+            socketStatus = UShellSocketReadChunk(readSocket,
+                                                 chunk,
+                                                 sizeof(chunk),
+                                                 USHELL_CMD_GREP_READ_TIMEOUT_MS,
+                                                 &chunkLen);
+            if (socketStatus == USHELL_SOCKET_TIMEOUT_ERR)
+            {
+                continue;    // The left command is still running
+            }
+            if (socketStatus != USHELL_SOCKET_NO_ERR)
+            {
+                break;    // The end of the input
+            }
+
+            /* Split the input into the lines */
+            for (size_t ind = 0U; ind < chunkLen; ind++)
+            {
+                if (chunk [ind] == '\r')
+                {
+                    continue;    // The line ends at '\n'
+                }
+
+                if (chunk [ind] == '\n')
+                {
+                    line [lineLen] = '\0';
+                    uShellCmdGrepLineProc(writeSocket, line, argv [0]);
+                    lineLen = 0U;
+                    continue;
+                }
+
+                /* The longer line is taken by its beginning */
+                if (lineLen < (sizeof(line) - 1U))
+                {
+                    line [lineLen++] = chunk [ind];
+                }
+            }
+        }
+
+        /* The last line has no '\n' */
+        if ((status == USHELL_CMD_NO_ERR) &&
+            (lineLen > 0U))
+        {
+            line [lineLen] = '\0';
+            uShellCmdGrepLineProc(writeSocket, line, argv [0]);
+        }
+
+    } while (0);
+
+    return status;    // Return success code
+}
+
+/**
+ * \brief Print the line if it contains the pattern.
+ * \param writeSocket - UShell socket object for writing
+ * \param line - terminated line
+ * \param pattern - pattern to be found
+ * \return none
+ */
+static void uShellCmdGrepLineProc(UShellSocket_s* const writeSocket,
+                                  const char* const line,
+                                  const char* const pattern)
+{
+    /* Local variable */
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Variable to store socket status
+
+    /* Print the matched line */
+    if (strstr(line, pattern) != NULL)
+    {
+        socketStatus = UShellSocketPrint(writeSocket, "%s\n", line);
+        USHELL_CMD_GREP_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);    // Set status to error if socket write fails
+        (void) socketStatus;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef USHELL_CMD_GREP_H_
+#define USHELL_CMD_GREP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*================================================================[INCLUDE]================================================*/
+
+/* Standard includes */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "ushell_cmd.h"
+#include "ushell_cfg.h"
+
+/*===========================================================[MACRO DEFINITIONS]============================================*/
+
+#ifndef USHELL_CMD_GREP_NAME
+    #define USHELL_CMD_GREP_NAME "grep"    ///< UShell command grep name
+#endif
+
+#ifndef USHELL_CMD_GREP_HELP
+    #define USHELL_CMD_GREP_HELP "Print the input lines which contain the pattern (cmd | grep <pattern>)"    ///< UShell command grep description
+#endif
+
+#ifndef USHELL_CMD_GREP_LINE_SIZE
+    #define USHELL_CMD_GREP_LINE_SIZE 128U    ///< Size of the input line (the longer line is matched and printed by its beginning)
+#endif
+
+#ifndef USHELL_CMD_GREP_READ_TIMEOUT_MS
+    #define USHELL_CMD_GREP_READ_TIMEOUT_MS 50U    ///< Time to wait for the input per read (the cancellation is checked between the reads)
+#endif
+
+/*========================================================[DATA TYPES DEFINITIONS]==========================================*/
+
+/**
+ * \brief Describe UShellCmdGrep.
+ */
+typedef struct
+{
+    UShellCmd_s cmd;    ///< UShellCmdGrep object (base object)
+
+} UShellCmdGrep_s;
+
+/*===========================================================[PUBLIC INTERFACE]=============================================*/
+
+/**
+ * \brief UShellCmdGrep object (base object)
+ */
+extern UShellCmdGrep_s uShellCmdGrep;
+
+/**
+ * \brief Initialize the UShell cmd grep module.
+ * \param [in] rootCmd - The first cmd in the list of commands to be initialized
+ * \param [out] none
+ * \return int - error code
+ */
+int UShellCmdGrepInit(UShellCmd_s* rootCmd);
+
+/**
+ * \brief Deinitialize the UShell cmd grep module.
+ * \param [in] none
+ * \param [out] none
+ * \return int - error code
+ */
+int UShellCmdGrepDeinit();
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* USHELL_CMD_GREP_H_ */
\ No newline at end of file
@@ -37,13 +37,15 @@ UShellCmdHelp_s uShellCmdHelp = {0};    ///< UShellCmdHelp object (base object)
  * \param writeSocket - UShell socket object for writing
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdHelpExec(void* const cmd,
                                         UShellSocket_s* const readSocket,
                                         UShellSocket_s* const writeSocket,
                                         const int argc,
-                                        char* const argv []);
+                                        char* const argv [],
+                                        const UShellCmdCancel_s* const cancel);
 
 //=======================================================================[ PUBLIC INTERFACE FUNCTIONS ]=============================================================================
 
@@ -133,18 +135,21 @@ int UShellCmdHelpDeinit()
  * \param writeSocket - UShell socket object for writing
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdHelpExec(void* const cmd,
                                         UShellSocket_s* const readSocket,
                                         UShellSocket_s* const writeSocket,
                                         const int argc,
-                                        char* const argv [])
+                                        char* const argv [],
+                                        const UShellCmdCancel_s* const cancel)
 {
     /* Local variable */
     UShellCmdErr_e status = USHELL_CMD_NO_ERR;                // Variable to store command status
     UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Variable to store socket status
     (void) socketStatus;                                      // Suppress unused variable warning
+    (void) cancel;                                            // Suppress unused variable warning
 
     do
     {
@@ -188,6 +193,20 @@ static UShellCmdErr_e uShellCmdHelpExec(void* const cmd,
             currCmd = currCmd->next;    // Set current command to next command
         }
 
+        /* Go to all commands defined at build time */
+        const UShellCmdDesc_s* descTable = NULL;    // Table of the defined commands
+        size_t descQty = 0U;                        // Number of the defined commands
+        UShellCmdDescTableGet(&descTable, &descQty);
+        for (size_t ind = 0U; ind < descQty; ind++)
+        {
+            /* Print command name and help */
+            socketStatus = UShellSocketPrint(writeSocket,
+                                             "    %s: %s\n",
+                                             descTable [ind].name,
+                                             descTable [ind].help);          // Print command name and help message
+            USHELL_CMD_HELP_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);    // Assert if socket status is not OK
+        }
+
     } while (0);
 
     return status;    // Return success code
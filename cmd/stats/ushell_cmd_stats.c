@@ -0,0 +1,269 @@
+/**
+ * \file         ushell_cmd_stats.c
+ * \brief        The file contains the implementation of the UShell command stats module.
+ * \authors      Vladislav Kosten (vladkosten@gmail.com)
+ * \copyright    MIT License (c) 2025
+ * \warning      A warning may be placed here...
+ * \bug          Bug report may be placed here...
+ */
+//===============================================================================[ INCLUDE ]========================================================================================
+
+#include "ushell_cmd_stats.h"
+//=====================================================================[ INTERNAL MACRO DEFINITIONS ]===============================================================================
+/**
+ * \brief Assert macro for the UShellCmdStats module.
+ */
+#ifndef USHELL_CMD_STATS_ASSERT
+    #ifdef USHELL_ASSERT
+        #define USHELL_CMD_STATS_ASSERT(cond) USHELL_ASSERT(cond)
+    #else
+        #define USHELL_CMD_STATS_ASSERT(cond)
+    #endif
+#endif
+
+/**
+ * \brief The percentile shown by the command.
+ */
+#define USHELL_CMD_STATS_PERCENTILE 99U
+
+//====================================================================[ INTERNAL DATA TYPES DEFINITIONS ]===========================================================================
+
+//===============================================================[ INTERNAL FUNCTIONS AND OBJECTS DECLARATION ]=====================================================================
+
+/**
+ * \brief UShellCmdStats object (base object)
+ */
+UShellCmdStats_s uShellCmdStats = {0};    ///< UShellCmdStats object (base object)
+
+/**
+ * \brief Execute the stats command.
+ * \param cmd - UShellCmd object
+ * \param readSocket - UShell socket object for reading
+ * \param writeSocket - UShell socket object for writing
+ * \param argc - number of arguments
+ * \param argv - array of arguments
+ * \param cancel - cancellation token
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdStatsExec(void* const cmd,
+                                         UShellSocket_s* const readSocket,
+                                         UShellSocket_s* const writeSocket,
+                                         const int argc,
+                                         char* const argv [],
+                                         const UShellCmdCancel_s* const cancel);
+
+/**
+ * \brief Print the record of the command.
+ * \param writeSocket - UShell socket object for writing
+ * \param currCmd - the command (the attached one or the proxy of the defined one)
+ * \return none
+ */
+static void uShellCmdStatsRowPrint(UShellSocket_s* const writeSocket,
+                                   UShellCmd_s* const currCmd);
+
+//=======================================================================[ PUBLIC INTERFACE FUNCTIONS ]=============================================================================
+
+/**
+ * \brief Initialize the UShell cmd stats module.
+ * \param [in] rootCmd - The first cmd in the list of commands to be shown
+ * \param [out] none
+ * \return int - error code
+ */
+int UShellCmdStatsInit(UShellCmd_s* rootCmd)
+{
+    /* Local variable */
+    int status = 0;                                  // Variable to store the status of the operation
+    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;    // Variable to store command status
+
+    do
+    {
+        /* Check input parameter */
+        if (rootCmd == NULL)
+        {
+            USHELL_CMD_STATS_ASSERT(0);    // Set status to error if rootCmd is NULL
+            status = -1;                   // Set status to error if rootCmd is NULL
+            break;                         // Exit the loop
+        }
+
+        /* Initialize the UShellCmdStats object */
+        memset(&uShellCmdStats, 0, sizeof(uShellCmdStats));
+
+        /* Init the base class */
+        cmdStatus = UShellCmdInit(&uShellCmdStats.cmd,
+                                  USHELL_CMD_STATS_NAME,
+                                  USHELL_CMD_STATS_HELP,
+                                  uShellCmdStatsExec);
+        if (cmdStatus != USHELL_CMD_NO_ERR)
+        {
+            USHELL_CMD_STATS_ASSERT(0);    // Set status to error if command initialization fails
+            status = -2;                   // Set status to error if command initialization fails
+            break;                         // Exit the loop
+        }
+
+        /* Set the attributes */
+        uShellCmdStats.rootCmd = rootCmd;    // Set the root command
+
+    } while (0);
+
+    return status;    // Return success code
+}
+
+/**
+ * \brief Deinitialize the UShell cmd stats module.
+ * \param [out] none
+ * \return int - error code
+ */
+int UShellCmdStatsDeinit()
+{
+    /* Local variable */
+    int status = 0;                                  // Variable to store the status of the operation
+    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;    // Variable to store command status
+
+    do
+    {
+        /* Deinit the UShellCmdStats object */
+        cmdStatus = UShellCmdDeinit(&uShellCmdStats.cmd);
+        if (cmdStatus != USHELL_CMD_NO_ERR)
+        {
+            USHELL_CMD_STATS_ASSERT(0);
+            status = -1;    // Set status to error if command deinitialization fails
+            break;          // Exit the loop
+        }
+
+        /* Clear the UShellCmdStats object */
+        memset(&uShellCmdStats, 0, sizeof(uShellCmdStats));
+
+    } while (0);
+
+    return status;    // Return success code
+}
+
+//============================================================================ [PRIVATE FUNCTIONS ]=================================================================================
+
+/**
+ * \brief Execute the stats command.
+ * \note The commands run in parallel, every record is copied under the cmd lock before it is shown.
+ * \param cmd - UShellCmd object
+ * \param readSocket - UShell socket object for reading
+ * \param writeSocket - UShell socket object for writing
+ * \param argc - number of arguments
+ * \param argv - array of arguments
+ * \param cancel - cancellation token
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellCmdErr_e uShellCmdStatsExec(void* const cmd,
+                                         UShellSocket_s* const readSocket,
+                                         UShellSocket_s* const writeSocket,
+                                         const int argc,
+                                         char* const argv [],
+                                         const UShellCmdCancel_s* const cancel)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;                // Variable to store command status
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Variable to store socket status
+    UShellCmd_s* currCmd = NULL;                              // Current command of the list
+    UShellCmd_s proxy = {0};                                  // Object of the defined command
+    const UShellCmdDesc_s* descTable = NULL;                  // Table of the defined commands
+    size_t descQty = 0U;                                      // Number of the defined commands
+    (void) socketStatus;                                      // Suppress unused variable warning
+    (void) readSocket;                                        // Suppress unused variable warning
+    (void) cancel;                                            // Suppress unused variable warning
+
+    do
+    {
+        /* Check input parameter */
+        if ((cmd == NULL) ||
+            (cmd != &uShellCmdStats.cmd))
+        {
+            USHELL_CMD_STATS_ASSERT(0);              // Set status to error if command is NULL
+            status = USHELL_CMD_INVALID_ARGS_ERR;    // Set status to error if command is NULL
+            break;                                   // Exit the loop
+        }
+
+        /* Only the reset option is known */
+        if ((argc > 1) ||
+            ((argc == 1) && (strcmp(argv [0], "reset") != 0)))
+        {
+            socketStatus = UShellSocketPrint(writeSocket,
+                                             "stats: Invalid arguments\n");    // Print error message to socket
+            USHELL_CMD_STATS_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);     // Assert if socket status is not OK
+            break;                                                             // Exit the loop
+        }
+
+        /* The defined commands are reached through the shell (their records are kept by it) */
+        UShellCmdDescTableGet(&descTable, &descQty);
+
+        /* Reset the records of all commands */
+        if (argc == 1)
+        {
+            for (currCmd = uShellCmdStats.rootCmd; currCmd != NULL; currCmd = currCmd->next)
+            {
+                UShellCmdExecStatsReset(currCmd);
+            }
+            for (size_t ind = 0U; ind < descQty; ind++)
+            {
+                if ((UShellCmdFind(cmd, descTable [ind].name, &proxy, &currCmd) == USHELL_CMD_NO_ERR) &&
+                    (currCmd == &proxy))
+                {
+                    UShellCmdExecStatsReset(currCmd);
+                }
+            }
+            break;    // Exit the loop
+        }
+
+        /* Print the header */
+        socketStatus = UShellSocketPrint(writeSocket,
+                                         "%-12s %8s %8s %8s %8s %8s %10s\n",
+                                         "cmd", "count", "min,ms", "avg,ms", "max,ms", "p99,ms", "bytes");
+        USHELL_CMD_STATS_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);    // Assert if socket status is not OK
+
+        /* Print the record of every command */
+        for (currCmd = uShellCmdStats.rootCmd; currCmd != NULL; currCmd = currCmd->next)
+        {
+            uShellCmdStatsRowPrint(writeSocket, currCmd);
+        }
+
+        /* Print the record of every defined command (the one hidden by the attached command is skipped) */
+        for (size_t ind = 0U; ind < descQty; ind++)
+        {
+            if ((UShellCmdFind(cmd, descTable [ind].name, &proxy, &currCmd) == USHELL_CMD_NO_ERR) &&
+                (currCmd == &proxy))
+            {
+                uShellCmdStatsRowPrint(writeSocket, currCmd);
+            }
+        }
+
+    } while (0);
+
+    return status;    // Return success code
+}
+
+/**
+ * \brief Print the record of the command.
+ * \param writeSocket - UShell socket object for writing
+ * \param currCmd - the command (the attached one or the proxy of the defined one)
+ * \return none
+ */
+static void uShellCmdStatsRowPrint(UShellSocket_s* const writeSocket,
+                                   UShellCmd_s* const currCmd)
+{
+    /* Local variable */
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Variable to store socket status
+    UShellCmdExecStats_s stats = {0};                         // Copy of the record of the command
+    uint32_t p99 = 0U;                                        // Percentile of the duration
+    (void) socketStatus;                                      // Suppress unused variable warning
+
+    UShellCmdExecStatsGet(currCmd, &stats);
+    UShellCmdExecStatsPercentileGet(currCmd, USHELL_CMD_STATS_PERCENTILE, &p99);
+
+    socketStatus = UShellSocketPrint(writeSocket,
+                                     "%-12s %8lu %8lu %8lu %8lu %8lu %10lu\n",
+                                     currCmd->name,
+                                     (unsigned long) stats.count,
+                                     (unsigned long) stats.timeMin,
+                                     (unsigned long) ((stats.count > 0U) ? (stats.timeSum / stats.count) : 0U),
+                                     (unsigned long) stats.timeMax,
+                                     (unsigned long) p99,
+                                     (unsigned long) stats.writeSum);
+    USHELL_CMD_STATS_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);    // Assert if socket status is not OK
+}
\ No newline at end of file
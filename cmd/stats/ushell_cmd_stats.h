@@ -0,0 +1,68 @@
+#ifndef USHELL_CMD_STATS_H_
+#define USHELL_CMD_STATS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*================================================================[INCLUDE]================================================*/
+
+/* Standard includes */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "ushell_cmd.h"
+#include "ushell_cfg.h"
+
+/*===========================================================[MACRO DEFINITIONS]============================================*/
+
+#ifndef USHELL_CMD_STATS_NAME
+    #define USHELL_CMD_STATS_NAME "stats"    ///< UShell command stats name
+#endif
+
+#ifndef USHELL_CMD_STATS_HELP
+    #define USHELL_CMD_STATS_HELP "Show the execution statistics of the commands (stats reset - clear them)"    ///< UShell command stats description
+#endif
+
+/*========================================================[DATA TYPES DEFINITIONS]==========================================*/
+
+/**
+ * \brief Describe UShellCmdStats.
+ */
+typedef struct
+{
+    UShellCmd_s cmd;         ///< UShellCmd object (base object)
+    UShellCmd_s* rootCmd;    ///< Pointer to the root command (head of the list)
+
+} UShellCmdStats_s;
+
+/*===========================================================[PUBLIC INTERFACE]=============================================*/
+
+/**
+ * \brief UShellCmdStats object (base object)
+ */
+extern UShellCmdStats_s uShellCmdStats;
+
+/**
+ * \brief Initialize the UShell cmd stats module.
+ * \param [in] rootCmd - The first cmd in the list of commands to be shown
+ * \param [out] none
+ * \return int - error code
+ */
+int UShellCmdStatsInit(UShellCmd_s* rootCmd);
+
+/**
+ * \brief Deinitialize the UShell cmd stats module.
+ * \param [out] none
+ * \return int - error code
+ */
+int UShellCmdStatsDeinit();
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* USHELL_CMD_STATS_H_ */
\ No newline at end of file
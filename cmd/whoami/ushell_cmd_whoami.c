@@ -37,13 +37,15 @@ UShellCmdWhoAmI_s uShellCmdWhoAmI = {0};    ///< UShellCmdWhoAmI object (base ob
  * \param writeSocket - UShell socket object for writing
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdWhoAmIExec(void* const cmd,
                                           UShellSocket_s* const readSocket,
                                           UShellSocket_s* const writeSocket,
                                           const int argc,
-                                          char* const argv []);
+                                          char* const argv [],
+                                          const UShellCmdCancel_s* const cancel);
 
 //=======================================================================[ PUBLIC INTERFACE FUNCTIONS ]=============================================================================
 
@@ -136,18 +138,21 @@ int UShellCmdWhoAmIDeinit()
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellCmdWhoAmIExec(void* const cmd,
                                           UShellSocket_s* const readSocket,
                                           UShellSocket_s* const writeSocket,
                                           const int argc,
-                                          char* const argv [])
+                                          char* const argv [],
+                                          const UShellCmdCancel_s* const cancel)
 {
     /* Local variable */
     UShellCmdErr_e status = USHELL_CMD_NO_ERR;                // Variable to store command status
     UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Variable to store socket status
     (void) socketStatus;                                      // Unused variable
+    (void) cancel;                                            // Unused variable
 
     do
     {
@@ -46,9 +46,22 @@ typedef enum
     USHELL_ASCII_CHAR_TAB = 0x09,      ///< Tab
     USHELL_ASCII_CHAR_ENTER = 0x0D,    ///< Enter
     USHELL_ASCII_CHAR_ESC = 0x1B,      ///< Escape
+    USHELL_ASCII_CHAR_ETX = 0x03,      ///< End of text (Ctrl-C)
 
 } UShellAsciiChar_e;
 
+/**
+ * \brief Enumeration of the events of the session (the session thread sleeps on them)
+ */
+typedef enum
+{
+    USHELL_SESSION_EVENT_INPUT = USHELL_OSAL_EVENT_GROUP_BIT_0,       ///< The input has arrived to the read socket
+    USHELL_SESSION_EVENT_JOB_DONE = USHELL_OSAL_EVENT_GROUP_BIT_1,    ///< The command job is done
+    USHELL_SESSION_EVENT_PIPE_RUN = USHELL_OSAL_EVENT_GROUP_BIT_2,    ///< The pipe thread runs the right command of the pipe
+    USHELL_SESSION_EVENT_PIPE_DONE = USHELL_OSAL_EVENT_GROUP_BIT_3,   ///< The right command of the pipe is done and the pipe is drained
+
+} UShellSessionEvent_e;
+
 /**
  * \brief ANSI escape codes for terminal control.
  *
@@ -59,6 +72,15 @@ typedef enum
 #define USHELL_CLEAR_LINE   "\033[2K\r"           ///< Clear line command with carriage return
 #define USHELL_DEL_CHAR     "\b \b"               ///< Delete character command
 #define USHELL_NEW_LINE     "\n"                  ///< New line command
+#define USHELL_ERASE_TAIL   "\033[K"              ///< Erase from the cursor to the end of the line
+#define USHELL_CURSOR_BACK  "\b"                  ///< Move the cursor one position back
+#define USHELL_CURSOR_LEFT  "\033[%uD"            ///< Move the cursor left by N positions (format)
+#define USHELL_CURSOR_RIGHT "\033[%uC"            ///< Move the cursor right by N positions (format)
+
+/**
+ * \brief The maximum number of cursor steps sent as plain backspaces instead of an escape sequence.
+ */
+#define USHELL_CURSOR_BACK_MAX 3U
 
 //====================================================================[ INTERNAL DATA TYPES DEFINITIONS ]===========================================================================
 
@@ -77,13 +99,48 @@ typedef enum
 
 /**
  * \brief UShell thread worker
- * \param[in] uShell - uShell object
+ * \param[in] session - the uShell session
  * \param[out] none
  * \return none
- * \note This function is the main loop of the UShell module.
+ * \note This function is the main loop of the UShell session.
  *       It is responsible for the processing of the commands and the interaction with the user.
  */
-static void uShellWorker(void* const uShell);
+static void uShellWorker(void* const session);
+
+/**
+ * \brief UShell command worker (one thread of the pool)
+ * \param[in] uShell - uShell object
+ * \param[out] none
+ * \return none
+ * \note The worker takes the sessions with a queued job and executes their commands.
+ */
+static void uShellCmdWorker(void* const uShell);
+
+/**
+ * \brief UShell pipe thread (one per session)
+ * \param[in] session - the uShell session
+ * \param[out] none
+ * \return none
+ * \note The thread runs the right command of the pipe while the worker runs the left one,
+ *       then it drains the pipe until the left command is done.
+ */
+static void uShellPipeWorker(void* const session);
+
+/**
+ * \brief Render the current state of the uShell finite state machine
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellFsmRender(UShellSession_s* const session);
+
+/**
+ * \brief Process one input symbol by the uShell finite state machine
+ * \param[in] session - the uShell session
+ * \param[in] item - input symbol
+ * \return none
+ */
+static void uShellFsmProc(UShellSession_s* const session,
+                          const UShellItem_t item);
 
 /**
  * \brief Initialize the runtime environment
@@ -125,20 +182,94 @@ static UShellErr_e uShellRtEnvOsalInit(UShell_s* const uShell,
 static UShellErr_e uShellRtEnvOsalDeInit(UShell_s* const uShell);
 
 /**
- * \brief Initialize the runtime environment HAL
+ * \brief Initialize the runtime environment of a new session
  * \param uShell - uShell object
+ * \param cfg - configuration object
+ * \param vcp - vcp object
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvSessionInit(UShell_s* const uShell,
+                                          UShellCfg_s* const cfg,
+                                          UShellVcp_s* const vcp);
+
+/**
+ * \brief Deinitialize the runtime environment of the session
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvSessionDeInit(UShellSession_s* const session);
+
+/**
+ * \brief Initialize the runtime environment HAL
+ * \param session - the uShell session
  * \param hal - hal object
  * \return USHELL_NO_ERR if success, otherwise error code
  */
-static UShellErr_e uShellRtEnvVcpInit(UShell_s* const uShell,
+static UShellErr_e uShellRtEnvVcpInit(UShellSession_s* const session,
                                       UShellVcp_s* const vcp);
 
 /**
  * \brief Deinitialize the runtime environment HAL
- * \param uShell - uShell object
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvVcpDeInit(UShellSession_s* const session);
+
+/**
+ * \brief Initialize the runtime environment pipe
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvPipeInit(UShellSession_s* const session);
+
+/**
+ * \brief Deinitialize the runtime environment pipe
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvPipeDeInit(UShellSession_s* const session);
+
+/**
+ * \brief Initialize the runtime environment input of the command job
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvInpInit(UShellSession_s* const session);
+
+/**
+ * \brief Deinitialize the runtime environment input of the command job
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvInpDeInit(UShellSession_s* const session);
+
+/**
+ * \brief Initialize the runtime environment redirection
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvRedirectInit(UShellSession_s* const session);
+
+/**
+ * \brief Deinitialize the runtime environment redirection
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvRedirectDeInit(UShellSession_s* const session);
+
+/**
+ * \brief Initialize the runtime environment machine mode
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvMachineInit(UShellSession_s* const session);
+
+/**
+ * \brief Deinitialize the runtime environment machine mode
+ * \param session - the uShell session
  * \return USHELL_NO_ERR if success, otherwise error code
  */
-static UShellErr_e uShellRtEnvVcpDeInit(UShell_s* const uShell);
+static UShellErr_e uShellRtEnvMachineDeInit(UShellSession_s* const session);
 
 /**
  * \brief Initialize the runtime environment command
@@ -158,24 +289,77 @@ static UShellErr_e uShellRtEnvCmdRootDeInit(UShell_s* const uShell);
 
 /**
  * \brief Initialize the runtime environment history
- * \param uShell - uShell object
+ * \param session - the uShell session
  * \return USHELL_NO_ERR if success, otherwise error code
  */
-static UShellErr_e uShellRtEnvFuncHistoryInit(UShell_s* const uShell);
+static UShellErr_e uShellRtEnvFuncHistoryInit(UShellSession_s* const session);
 
 /**
  * \brief Deinitialize the runtime environment history
- * \param uShell - uShell object
+ * \param session - the uShell session
  * \return USHELL_NO_ERR if success, otherwise error code
  */
-static UShellErr_e uShellRtEnvFuncHistoryDeInit(UShell_s* const uShell);
+static UShellErr_e uShellRtEnvFuncHistoryDeInit(UShellSession_s* const session);
 
 /**
  * \brief Find cmd by name
- * \param[in] uShell - uShell object
+ * \param[in] session - the uShell session
  * \return UShellCmd_s* - error code. non-zero = an error has occurred;
  */
-static UShellCmd_s* uShellCmdFind(UShell_s* const uShell);
+static UShellCmd_s* uShellCmdFind(UShellSession_s* const session);
+
+/**
+ * \brief Build the command index (commands sorted by name) from the command list and the defined commands
+ * \param[in] uShell - uShell object
+ * \return UShellErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellErr_e uShellCmdIndexBuild(UShell_s* const uShell);
+
+/**
+ * \brief Insert the command into its sorted place of the index
+ * \param[in] index - the command index
+ * \param[in] name - name of the command
+ * \param[in] cmd - attached command (NULL for the defined one)
+ * \param[in] desc - defined command (NULL for the attached one)
+ * \return UShellErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellErr_e uShellCmdIndexInsert(UShellCmdIndex_s* const index,
+                                        const char* const name,
+                                        UShellCmd_s* const cmd,
+                                        const UShellCmdDesc_s* const desc);
+
+/**
+ * \brief Find cmd in the command index (binary search)
+ * \param[in] uShell - uShell object
+ * \param[in] name - name of the command (not necessarily terminated)
+ * \param[in] nameLen - length of the name
+ * \return const UShellCmdIndexItem_s* - found item, NULL if the command is not in the index
+ */
+static const UShellCmdIndexItem_s* uShellCmdIndexFind(UShell_s* const uShell,
+                                                      const char* const name,
+                                                      const size_t nameLen);
+
+/**
+ * \brief Take the command of the index item (the defined command is executed through the proxy object)
+ * \param[in] uShell - uShell object
+ * \param[in] item - item of the index
+ * \param[in] proxy - object to be filled for the defined command
+ * \return UShellCmd_s* - command to be executed, NULL if the item is NULL
+ */
+static UShellCmd_s* uShellCmdIndexTake(UShell_s* const uShell,
+                                       const UShellCmdIndexItem_s* const item,
+                                       UShellCmd_s* const proxy);
+
+/**
+ * \brief Compare the name with the name of the command
+ * \param[in] name - name (not necessarily terminated)
+ * \param[in] nameLen - length of the name
+ * \param[in] cmdName - name of the command
+ * \return int - less than, equal to, or greater than zero like strcmp()
+ */
+static int uShellCmdNameCmp(const char* const name,
+                            const size_t nameLen,
+                            const char* const cmdName);
 
 /**
  * \brief Lock the uShell monitor
@@ -205,56 +389,279 @@ static void uShellCmdLock(void* const cmd);
  */
 static void uShellCmdUnlock(void* const cmd);
 
+/**
+ * \brief Get the time for the cmd statistics
+ * \param cmd - the cmd to be measured
+ * \return uint32_t - time in milliseconds
+ */
+static uint32_t uShellCmdTimeGet(void* const cmd);
+
+/**
+ * \brief Find the cmd by name in the command index (lookup hook of the cmd)
+ * \param cmd - the cmd which looks for
+ * \param name - name of the cmd to be found
+ * \param proxy - object to be filled for the defined cmd
+ * \return UShellCmd_s* - found cmd, NULL if there is no such cmd
+ */
+static UShellCmd_s* uShellCmdLookup(void* const cmd,
+                                    const char* const name,
+                                    UShellCmd_s* const proxy);
+
+/**
+ * \brief Rebuild the command index after the command list is changed (list hook of the cmd)
+ * \note The commands added to the list by UShellCmdListAdd are indexed here, so the lookup needs no list walk.
+ * \param cmd - the cmd of the changed list
+ * \return none
+ */
+static void uShellCmdListUpd(void* const cmd);
+
 /**
  * \brief Io flush function
- * \param[in] uShell - uShell object
+ * \param[in] session - the uShell session
  * \return none
  */
-static void uShellIoFlush(UShell_s* const uShell);
+static void uShellIoFlush(UShellSession_s* const session);
 
 /**
- * \brief Execute the command
- * \param[in] uShell - the uShell object
+ * \brief Execute the command (queue it to the command worker pool)
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellCmdCurExec(UShellSession_s* const session);
+
+/**
+ * \brief Execute the command job of the session (called by the command worker)
+ * \param session - the uShell session
+ * \return none
+ */
+static void uShellCmdJobExec(UShellSession_s* const session);
+
+/**
+ * \brief Prepare the command job: copy the line, cut the redirection and the pipe, parse the arguments
+ * \note The errors are reported to the write socket of the job.
+ * \param[in] session - the uShell session
+ * \param[in] line - command line
+ * \return UShellCmdErr_e - error code. non-zero = the job can not be executed;
+ */
+static UShellCmdErr_e uShellCmdJobPrepare(UShellSession_s* const session,
+                                          const char* const line);
+
+/**
+ * \brief Run the prepared command job (with the redirection and the pipe)
+ * \param[in] session - the uShell session
+ * \return UShellCmdErr_e - error code of the command
+ */
+static UShellCmdErr_e uShellCmdJobRun(UShellSession_s* const session);
+
+/**
+ * \brief Execute the command job with the pipe (the left command here and the right one on the pipe thread at once)
+ * \param[in] session - the uShell session
+ * \param[in] writeSocket - socket for the output of the right command
+ * \return UShellCmdErr_e - error code of the right command (USHELL_CMD_CANCELED_ERR if the pipe is canceled)
+ */
+static UShellCmdErr_e uShellCmdPipeExec(UShellSession_s* const session,
+                                        UShellSocket_s* const writeSocket);
+
+/**
+ * \brief Callback of the pipe sockets (the pipe has no one to notify)
+ * \param[in] socket - socket object
+ * \param[in] type - type of the callback
+ * \param[in] parent - the uShell session
+ * \return none
+ */
+static void uShellPipeSocketCb(void* socket,
+                               UShellSocketCbType_e type,
+                               void* parent);
+
+/**
+ * \brief Callback of the redirection socket (moves the written items to the block of the sink)
+ * \param[in] socket - socket object
+ * \param[in] type - type of the callback
+ * \param[in] parent - the uShell session
+ * \return none
+ */
+static void uShellRedirectSocketCb(void* socket,
+                                   UShellSocketCbType_e type,
+                                   void* parent);
+
+/**
+ * \brief Move the items of the redirection stream to the block, write every full block to the sink
+ * \param[in] session - the uShell session
+ * \param[in] isLast - true to write the rest of the block too (the command is finished)
+ * \return none
+ */
+static void uShellRedirectFlush(UShellSession_s* const session,
+                                const bool isLast);
+
+/**
+ * \brief Take one item of the machine mode input (collect the frame, queue the request on the delimiter)
+ * \param[in] session - the uShell session
+ * \param[in] item - input item
+ * \return none
+ */
+static void uShellMachineRx(UShellSession_s* const session,
+                            const UShellItem_t item);
+
+/**
+ * \brief Queue the machine mode request (or leave machine mode by the empty one)
+ * \param[in] session - the uShell session
+ * \param[in] frame - decoded request frame
+ * \param[in] frameLen - size of the frame
+ * \return none
+ */
+static void uShellMachineReqPut(UShellSession_s* const session,
+                                const uint8_t* const frame,
+                                const size_t frameLen);
+
+/**
+ * \brief Execute the queued machine mode requests of the session (called by the command worker)
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellMachineExec(UShellSession_s* const session);
+
+/**
+ * \brief Move the output of the request to the response, send every full response frame
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellMachineFlush(UShellSession_s* const session);
+
+/**
+ * \brief Encode and send the response frame
+ * \param[in] session - the uShell session
+ * \param[in] seq - sequence id of the request
+ * \param[in] flags - flags of the frame (USHELL_MACHINE_FLAG_...)
+ * \param[in] status - status of the request (UShellCmdErr_e or USHELL_MACHINE_STATUS_...)
+ * \param[in] data - output of the command
+ * \param[in] len - size of the output
+ * \return none
+ */
+static void uShellMachineSend(UShellSession_s* const session,
+                              const uint16_t seq,
+                              const uint8_t flags,
+                              const uint8_t status,
+                              const uint8_t* const data,
+                              const size_t len);
+
+/**
+ * \brief Callback of the machine mode output socket (moves the written items to the response)
+ * \param[in] socket - socket object
+ * \param[in] type - type of the callback
+ * \param[in] parent - the uShell session
  * \return none
  */
-static void uShellCmdCurExec(UShell_s* const uShell);
+static void uShellMachineSocketCb(void* socket,
+                                  UShellSocketCbType_e type,
+                                  void* parent);
 
 /**
  * \brief Auto complete the command
- * \param uShell - the uShell object
+ * \param session - the uShell session
  * \return none
  */
-static void uShellCmdAutoComplete(UShell_s* const uShell);
+static void uShellCmdAutoComplete(UShellSession_s* const session);
 
 /**
- * \brief Print the string
+ * \brief Find the first indexed command which name is not less than the prefix
  * \param[in] uShell - the uShell object
+ * \param[in] prefix - prefix (not necessarily terminated)
+ * \param[in] prefixLen - length of the prefix
+ * \return size_t - position in the index (qty if there is no such command)
+ */
+static size_t uShellCmdIndexLowerBound(UShell_s* const uShell,
+                                       const char* const prefix,
+                                       const size_t prefixLen);
+
+/**
+ * \brief Print the names of the indexed commands in columns
+ * \note The listing is collected in a local buffer and written at once (flushed earlier only if the buffer is full)
+ * \param[in] session - the uShell session
+ * \param[in] first - first command in the index
+ * \param[in] last - position after the last command in the index
+ * \return none
+ */
+static void uShellCmdCandidatesPrint(UShellSession_s* const session,
+                                     const size_t first,
+                                     const size_t last);
+
+/**
+ * \brief Print the string
+ * \param[in] session - the uShell session
  * \param[in] str - string to be printed
  * \return none
  */
-static void uShellPrintStr(UShell_s* const uShell,
+static void uShellPrintStr(UShellSession_s* const session,
                            const char* const str);
 
+/**
+ * \brief Print the buffer
+ * \param[in] session - the uShell session
+ * \param[in] buf - buffer to be printed
+ * \param[in] len - number of items to be printed
+ * \return none
+ */
+static void uShellPrintBuf(UShellSession_s* const session,
+                           const char* const buf,
+                           const size_t len);
+
+/**
+ * \brief Print the string to the output of the command job
+ * \param[in] session - the uShell session
+ * \param[in] str - string to be printed
+ * \return none
+ */
+static void uShellJobPrintStr(UShellSession_s* const session,
+                              const char* const str);
+
+/**
+ * \brief Render the input line on the terminal
+ * \note Only the delta between the terminal and the io buffer is sent
+ * \param[in] session - the uShell session
+ * \param[in] prompt - prompt to be printed if the line is not shown yet
+ * \return none
+ */
+static void uShellTermRender(UShellSession_s* const session,
+                             const char* const prompt);
+
+/**
+ * \brief Invalidate the terminal line (the next render prints the prompt and the whole line)
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellTermReset(UShellSession_s* const session);
+
+/**
+ * \brief Move the terminal cursor
+ * \param[in] session - the uShell session
+ * \param[in] from - current cursor position
+ * \param[in] to - new cursor position
+ * \return none
+ */
+static void uShellTermCursorMove(UShellSession_s* const session,
+                                 const size_t from,
+                                 const size_t to);
+
 /**
  * \brief Add cmd to history
- * \param[in] uShell - the uShell object
+ * \param[in] session - the uShell session
  * \return none
  */
-static void uShellHistoryCmdAdd(UShell_s* const uShell);
+static void uShellHistoryCmdAdd(UShellSession_s* const session);
 
 /**
  * \brief Get previous cmd from history
- * \param[in] uShell - the uShell object
+ * \param[in] session - the uShell session
  * \return none
  */
-static void uShellHistoryPrevCmdGet(UShell_s* const uShell);
+static void uShellHistoryPrevCmdGet(UShellSession_s* const session);
 
 /**
  * \brief Get next cmd from history
- * \param[in] uShell - the uShell object
+ * \param[in] session - the uShell session
  * \return none
  */
-static void uShellHistoryNextCmdGet(UShell_s* const uShell);
+static void uShellHistoryNextCmdGet(UShellSession_s* const session);
 
 /**
  * \brief Delay in milliseconds
@@ -264,29 +671,136 @@ static void uShellHistoryNextCmdGet(UShell_s* const uShell);
 static inline void uShellDelayMs(const UShell_s* const uShell,
                                  const uint32_t delayMs);
 
+/**
+ * \brief Forward the input to the running command (up to Ctrl-C, which is left to the session)
+ * \note The raw input (USHELL_CMD_INP_RAW) goes to the command as a whole, Ctrl-C included.
+ *       The input of the command which does not read the console is typed ahead for the shell.
+ * \param[in] session - the uShell session
+ * \param[in] item - input items
+ * \param[in] qty - number of the input items
+ * \return size_t - number of the forwarded items (0 - the session takes the first item)
+ */
+static size_t uShellInpForward(UShellSession_s* const session,
+                               const UShellItem_t* const item,
+                               const size_t qty);
+
+/**
+ * \brief Replay the input typed ahead to the shell (after the command which does not read the console)
+ * \note The replay stops at the next command which does not read the console, the rest waits for it.
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellInpTypeAheadProc(UShellSession_s* const session);
+
+/**
+ * \brief Get the number of the input items the session can take now
+ * \param[in] session - the uShell session
+ * \return size_t - number of the items (0 - the input waits until the command is done)
+ */
+static size_t uShellInpRoomGet(const UShellSession_s* const session);
+
+/**
+ * \brief Callback of the read session of the vcp (the input has arrived)
+ * \param[in] owner - the uShell session
+ * \return none
+ */
+static void uShellInpCb(void* const owner);
+
+/**
+ * \brief Set the event of the session (wake the session thread up)
+ * \param[in] session - the uShell session
+ * \param[in] event - event to be set
+ * \return none
+ */
+static void uShellSessionEventSet(UShellSession_s* const session,
+                                  const UShellSessionEvent_e event);
+
+/**
+ * \brief Check the command job of the session is queued or running
+ * \param[in] session - the uShell session
+ * \return bool - true if the job is busy
+ */
+static bool uShellJobIsBusy(UShellSession_s* const session);
+
+/**
+ * \brief Report the console input lost since the previous report (the overrun counter of the read session)
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellInpOverrunReport(UShellSession_s* const session);
+
+/**
+ * \brief Wait for the input and take all available symbols
+ * \note In the event-driven mode the caller sleeps on the read socket until the input arrives,
+ *       otherwise the function returns immediately if the read socket is empty.
+ *       With no room (size 0) the input is left in the read socket and only the job done is waited for.
+ * \param[in] session - the uShell session
+ * \param[out] chunk - buffer for the received symbols
+ * \param[in] size - size of the buffer
+ * \param[out] chunkLen - number of the received symbols
+ * \return UShellSocketErr_e - error code. non-zero = no symbol was received;
+ */
+static UShellSocketErr_e uShellInpWait(UShellSession_s* const session,
+                                       UShellItem_t* const chunk,
+                                       const size_t size,
+                                       size_t* const chunkLen);
+
 /**
  * \brief Add char to the uShell
- * \param[in] uShell - the uShell object
+ * \param[in] session - the uShell session
  * \param[in] ch - char to be added
  * \return none
  */
-static void uShellIoAddChar(UShell_s* const uShell,
+static void uShellIoAddChar(UShellSession_s* const session,
                             const char ch);
 
 /**
  * \brief Delete char from the uShell
- * \param[in] uShell - the uShell object
+ * \param[in] session - the uShell session
  * \param[in] ch - char to be deleted
  * \return none
  */
-static void uShellIoDelChar(UShell_s* const uShell);
+static void uShellIoDelChar(UShellSession_s* const session);
+
+/**
+ * \brief Move the io cursor
+ * \param[in] session - the uShell session
+ * \param[in] toRight - true to move the cursor right, false to move it left
+ * \return none
+ */
+static void uShellIoCursorMove(UShellSession_s* const session,
+                               const bool toRight);
 
 /**
  * \brief Hook table for the cmd
  */
 static UShellCmdHookTable_s ushellCmdHookTable = {
     .lock = uShellCmdLock,
-    .unlock = uShellCmdUnlock};
+    .unlock = uShellCmdUnlock,
+    .timeGet = uShellCmdTimeGet,
+    .find = uShellCmdLookup,
+    .listChanged = uShellCmdListUpd};
+
+/**
+ * \brief Callback table for the pipe sockets
+ */
+static const UShellSocketCbTable_s ushellPipeSocketCbTable = {
+    .readCb = uShellPipeSocketCb,
+    .writeCb = uShellPipeSocketCb};
+
+/**
+ * \brief Callback table for the redirection socket
+ */
+static const UShellSocketCbTable_s ushellRedirectSocketCbTable = {
+    .readCb = uShellRedirectSocketCb,
+    .writeCb = uShellRedirectSocketCb};
+
+/**
+ * \brief Callback table for the machine mode output socket
+ */
+static const UShellSocketCbTable_s ushellMachineSocketCbTable = {
+    .readCb = uShellMachineSocketCb,
+    .writeCb = uShellMachineSocketCb};
 
 //=======================================================================[ PUBLIC INTERFACE FUNCTIONS ]=============================================================================
 
@@ -348,9 +862,6 @@ UShellErr_e UShellInit(UShell_s* const uShell,
             break;
         }
 
-        /* Set init state */
-        uShell->fsmState = USHELL_STATE_INIT;
-
     } while (0);
 
     /* Return status */
@@ -402,41 +913,42 @@ UShellErr_e UShellRun(UShell_s* const uShell)
 {
     /* Local variable */
     UShellErr_e status = USHELL_NO_ERR;
-    UShellOsalThreadHandle_t thread = NULL;
     UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
-    UShellOsal_s* osal = (UShellOsal_s*) uShell->osal;
+    UShellOsal_s* osal = NULL;
+    UShellSession_s* session = NULL;
+
     /* Check input parameter */
     do
     {
         /* Check input parameter */
         if ((uShell == NULL) ||
-            (osal == NULL))
+            (uShell->osal == NULL))
         {
             /* Invalid arguments */
             USHELL_ASSERT(0);
             status = USHELL_INVALID_ARGS_ERR;
             break;
         }
+        osal = (UShellOsal_s*) uShell->osal;
 
-        /* Find the thread handle */
-        osalStatus = UShellOsalThreadHandleGet(osal, 0U, &thread);
-        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
-            (thread == NULL))
+        /* Start the thread of every session */
+        for (size_t ind = 0U; ind < USHELL_SESSION_MAX; ind++)
         {
-            /* Thread not found */
-            USHELL_ASSERT(0);
-            status = USHELL_PORT_ERR;
-            break;
-        }
+            session = &uShell->session [ind];
+            if ((session->used == false) ||
+                (session->thread == NULL))
+            {
+                continue;
+            }
 
-        /* Start the thread */
-        osalStatus = UShellOsalThreadResume(osal, thread);
-        if (osalStatus != USHELL_OSAL_NO_ERR)
-        {
-            /* Thread not started */
-            USHELL_ASSERT(0);
-            status = USHELL_PORT_ERR;
-            break;
+            osalStatus = UShellOsalThreadResume(osal, session->thread);
+            if (osalStatus != USHELL_OSAL_NO_ERR)
+            {
+                /* Thread not started */
+                USHELL_ASSERT(0);
+                status = USHELL_PORT_ERR;
+                break;
+            }
         }
 
     } while (0);
@@ -454,44 +966,88 @@ UShellErr_e UShellStop(UShell_s* const uShell)
 {
     /* Local variable */
     UShellErr_e status = USHELL_NO_ERR;
-    UShellOsalThreadHandle_t thread = NULL;
     UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
-    UShellOsal_s* osal = (UShellOsal_s*) uShell->osal;
+    UShellOsal_s* osal = NULL;
+    UShellSession_s* session = NULL;
 
     /* Check input parameter */
     do
     {
         /* Check input parameter */
         if ((uShell == NULL) ||
-            (osal == NULL))
+            (uShell->osal == NULL))
         {
             /* Invalid arguments */
             USHELL_ASSERT(0);
             status = USHELL_INVALID_ARGS_ERR;
             break;
         }
+        osal = (UShellOsal_s*) uShell->osal;
 
-        /* Find the thread handle */
-        osalStatus = UShellOsalThreadHandleGet(osal, 0U, &thread);
-        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
-            (thread == NULL))
+        /* Stop the thread of every session */
+        for (size_t ind = 0U; ind < USHELL_SESSION_MAX; ind++)
         {
-            /* Thread not found */
-            USHELL_ASSERT(0);
-            status = USHELL_PORT_ERR;
-            break;
+            session = &uShell->session [ind];
+            if ((session->used == false) ||
+                (session->thread == NULL))
+            {
+                continue;
+            }
+
+            osalStatus = UShellOsalThreadSuspend(osal, session->thread);
+            if (osalStatus != USHELL_OSAL_NO_ERR)
+            {
+                /* Thread not stopped */
+                USHELL_ASSERT(0);
+                status = USHELL_PORT_ERR;
+                break;
+            }
         }
 
-        /* Start the thread */
-        osalStatus = UShellOsalThreadResume(osal, thread);
-        if (osalStatus != USHELL_OSAL_NO_ERR)
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Add a session (one more console) to the uShell object
+ * \param[in] uShell - uShell object
+ * \param[in] vcp - vcp object of the console
+ * \param[in] cfg - configuration of the session
+ * \param[out] none
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+UShellErr_e UShellSessionAdd(UShell_s* const uShell,
+                             const UShellVcp_s* const vcp,
+                             const UShellCfg_s* const cfg)
+{
+    /* Local variable */
+    UShellErr_e status = USHELL_NO_ERR;
+
+    do
+    {
+        /* Check input parameters */
+        if ((uShell == NULL) ||
+            (vcp == NULL) ||
+            (cfg == NULL))
         {
-            /* Thread not started */
+            /* Invalid arguments */
             USHELL_ASSERT(0);
-            status = USHELL_PORT_ERR;
+            status = USHELL_INVALID_ARGS_ERR;
             break;
         }
 
+        /* Lock */
+        uShellLock(uShell);
+
+        /* Initialize the session */
+        status = uShellRtEnvSessionInit(uShell,
+                                        (UShellCfg_s*) cfg,
+                                        (UShellVcp_s*) vcp);
+
+        /* Unlock */
+        uShellUnlock(uShell);
+
     } while (0);
 
     return status;
@@ -529,6 +1085,12 @@ UShellErr_e UShellCmdAttach(UShell_s* const uShell,
 
         cmdStatus = UShellCmdListAdd(rootCmd, (UShellCmd_s*) cmd);
 
+        /* Rebuild the index */
+        if (cmdStatus == USHELL_CMD_NO_ERR)
+        {
+            status = uShellCmdIndexBuild(uShell);
+        }
+
         /* Unlock */
         uShellUnlock(uShell);
 
@@ -557,7 +1119,6 @@ UShellErr_e UShellCmdDetach(UShell_s* const uShell, const UShellCmd_s* const cmd
     /* Local variable */
     UShellErr_e status = USHELL_NO_ERR;
     UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;
-    UShellCmd_s* rootCmd = uShell->cmdRoot;
 
     do
     {
@@ -574,8 +1135,14 @@ UShellErr_e UShellCmdDetach(UShell_s* const uShell, const UShellCmd_s* const cmd
         /* LOCK */
         uShellLock(uShell);
 
-        /* Detach the command */
-        cmdStatus = UShellCmdListRemove(&rootCmd, (UShellCmd_s*) cmd);
+        /* Detach the command (the root is updated if the head is removed) */
+        cmdStatus = UShellCmdListRemove(&uShell->cmdRoot, (UShellCmd_s*) cmd);
+
+        /* Rebuild the index */
+        if (cmdStatus == USHELL_CMD_NO_ERR)
+        {
+            status = uShellCmdIndexBuild(uShell);
+        }
 
         /* UNLOCK */
         uShellUnlock(uShell);
@@ -594,300 +1161,537 @@ UShellErr_e UShellCmdDetach(UShell_s* const uShell, const UShellCmd_s* const cmd
     return status;    ///< Exit: Command not found
 }
 
+/**
+ * \brief Attach the sink of the redirection (cmd > file, cmd >> file) to uShell object
+ * \param[in] uShell - uShell object
+ * \param[in] sink - sink to be attached (NULL to detach)
+ * \param[out] none
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+UShellErr_e UShellRedirectSinkAttach(UShell_s* const uShell,
+                                     const UShellCmdSink_s* const sink)
+{
+    /* Local variable */
+    UShellErr_e status = USHELL_NO_ERR;
+
+    do
+    {
+        /* Check input parameters */
+        if ((uShell == NULL) ||
+            ((sink != NULL) &&
+             ((sink->open == NULL) ||
+              (sink->write == NULL) ||
+              (sink->close == NULL))))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            status = USHELL_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Lock */
+        uShellLock(uShell);
+
+        uShell->sink = sink;
+
+        /* Unlock */
+        uShellUnlock(uShell);
+
+    } while (0);
+
+    return status;
+}
+
 //============================================================================ [PRIVATE FUNCTIONS ]=================================================================================
 
 /**
  * \brief UShell thread worker
- * \param[in] uShell - uShell object
+ * \param[in] session - the uShell session
  * \param[out] none
  * \return none
- * \note This function is the main loop of the UShell module. It is responsible for the processing of the commands and the interaction with the user.
+ * \note This function is the main loop of the UShell session. It is responsible for the processing of the commands and the interaction with the user.
  */
-static void uShellWorker(void* const uShell)
+static void uShellWorker(void* const session)
 {
     /* Check input parameters */
-    USHELL_ASSERT(uShell != NULL);
+    USHELL_ASSERT(session != NULL);
 
     /* Local variables */
-    UShell_s* ushell = (UShell_s*) uShell;
+    UShellSession_s* sess = (UShellSession_s*) session;
+#if (USHELL_WORKER_EVENT_DRIVEN != TRUE)
+    UShell_s* ushell = (UShell_s*) sess->shell;
+#endif
     UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
-    UShellSocket_s* readSocket = ushell->vcpSessionCfg.readSocket;
-    UShellItem_t item = 0;
+    UShellVcpErr_e vcpStatus = USHELL_VCP_NO_ERR;
+    UShellItem_t chunk [USHELL_INP_CHUNK_SIZE] = {0};
+    size_t chunkLen = 0U;
+    size_t ind = 0U;
+    size_t fwdLen = 0U;
 
-    /* Delay to start the thread */
-    uShellDelayMs(ushell, USHELL_OSAL_START_DELAY_MS);
+    /* Start as soon as the vcp serves the sessions */
+    vcpStatus = UShellVcpReadyWait((UShellVcp_s*) sess->vcp);
+    USHELL_ASSERT(vcpStatus == USHELL_VCP_NO_ERR);
+    (void) vcpStatus;
 
     /* Main loop */
     while (1)
     {
+#if (USHELL_WORKER_EVENT_DRIVEN != TRUE)
         /* Little delay */
         uShellDelayMs(ushell, USHELL_UPD_TIME_MS);
+#endif
 
-        /* Check the state */
-        switch (ushell->fsmState)
+        /* Show the current state (once per chunk) */
+        uShellFsmRender(sess);
+
+        /* Replay the input typed ahead of the command which is done */
+        uShellInpTypeAheadProc(sess);
+
+        /* Take the available input symbols (the session waits for the command, if it keeps no more) */
+        socketStatus = uShellInpWait(sess, chunk, uShellInpRoomGet(sess), &chunkLen);
+        if (socketStatus != USHELL_SOCKET_NO_ERR)
         {
-            /* Initial state */
-            case USHELL_STATE_INIT :
+            continue;
+        }
+
+        /* Process the chunk (the input of the running command goes to it as a whole run) */
+        for (ind = 0U; ind < chunkLen; ind++)
+        {
+            fwdLen = uShellInpForward(sess, &chunk [ind], chunkLen - ind);
+            if (fwdLen > 0U)
             {
-                do
-                {
-                    /* Clear line */
-                    uShellPrintStr(ushell, USHELL_CLEAR_LINE);
+                ind += fwdLen - 1U;
+                continue;
+            }
 
-                    /* Print header */
-                    uShellPrintStr(ushell, USHELL_HELLO_MSG);
+            uShellFsmProc(sess, chunk [ind]);
+        }
+    }
+}
 
-                    /* Check we have any input symbol */
-                    socketStatus = UShellSocketRead(readSocket, &item, 1U, 0U);
-                    if (socketStatus != USHELL_SOCKET_NO_ERR)
-                    {
-                        break;
-                    }
+/**
+ * \brief UShell command worker (one thread of the pool)
+ * \param[in] uShell - uShell object
+ * \param[out] none
+ * \return none
+ * \note The worker takes the sessions with a queued job and executes their commands.
+ */
+static void uShellCmdWorker(void* const uShell)
+{
+    /* Check input parameters */
+    USHELL_ASSERT(uShell != NULL);
 
-                    /* Check the input, if it is not CR or LF */
-                    if (!(item == USHELL_ASCII_CHAR_CR) &&
-                        !(item == USHELL_ASCII_CHAR_LF))
-                    {
-                        break;
-                    }
+    /* Local variables */
+    UShell_s* ushell = (UShell_s*) uShell;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellSession_s* session = NULL;
+
+    /* Main loop */
+    while (1)
+    {
+        /* Sleep until a session queues a job */
+        osalStatus = UShellOsalQueueItemWait((UShellOsal_s*) ushell->osal,
+                                             ushell->cmdQueue,
+                                             &session);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (session == NULL))
+        {
+            continue;
+        }
+
+        /* Execute the command (or the machine mode requests) */
+        if (session->job.isMachine == true)
+        {
+            uShellMachineExec(session);
+        }
+        else
+        {
+            uShellCmdJobExec(session);
+        }
+    }
+}
+
+/**
+ * \brief UShell pipe thread (one per session)
+ * \param[in] session - the uShell session
+ * \param[out] none
+ * \return none
+ * \note The thread runs the right command of the pipe while the worker runs the left one,
+ *       then it drains the pipe until the left command is done.
+ */
+static void uShellPipeWorker(void* const session)
+{
+    /* Check input parameters */
+    USHELL_ASSERT(session != NULL);
+
+    /* Local variables */
+    UShellSession_s* sess = (UShellSession_s*) session;
+    UShellOsal_s* osal = (UShellOsal_s*) ((UShell_s*) sess->shell)->osal;
+    UShellCmdJob_s* job = &sess->job;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellOsalEventGroupBits_e bits = USHELL_OSAL_EVENT_GROUP_BIT_NONE;
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
+    UShellItem_t drain [USHELL_INP_CHUNK_SIZE] = {0};
+    size_t drainLen = 0U;
+
+    /* Main loop */
+    while (1)
+    {
+        /* Sleep until the worker starts the pipe */
+        osalStatus = UShellEventGroupBitsWait(osal,
+                                              sess->event,
+                                              (UShellOsalEventGroupBits_e) USHELL_SESSION_EVENT_PIPE_RUN,
+                                              &bits,
+                                              true,
+                                              false);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            continue;
+        }
 
-                    /* Flush the io */
-                    uShellIoFlush(ushell);
+        /* The right command reads the pipe (skip the command name, it is already in job->pipeCmd) */
+        job->pipeStatus = UShellCmdExec(job->pipeCmd,
+                                        &sess->pipe.readSocket,
+                                        job->pipeWriteSocket,
+                                        job->pipeArgc - 1,
+                                        &job->pipeArgv [1],
+                                        &job->cancel);
 
-                    /* Change the state */
-                    ushell->fsmState = (ushell->cfg.authIsEn == true)
-                                           ? USHELL_STATE_AUTH
-                                           : USHELL_STATE_PROC_INP;
+        /* Take the rest of the output, the left command may wait for the room (the read end fails when it is done) */
+        do
+        {
+            socketStatus = UShellSocketReadChunk(&sess->pipe.readSocket,
+                                                 drain,
+                                                 sizeof(drain),
+                                                 USHELL_PIPE_DRAIN_TIMEOUT_MS,
+                                                 &drainLen);
+        } while ((socketStatus == USHELL_SOCKET_NO_ERR) ||
+                 (socketStatus == USHELL_SOCKET_TIMEOUT_ERR));
+
+        /* Wake the worker up */
+        uShellSessionEventSet(sess, USHELL_SESSION_EVENT_PIPE_DONE);
+    }
+}
 
-                } while (1);
+/**
+ * \brief Render the current state of the uShell finite state machine
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellFsmRender(UShellSession_s* const session)
+{
+    do
+    {
+        /* Check input parameters */
+        if (session == NULL)
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            break;
+        }
 
+        /* Check the state */
+        switch (session->fsmState)
+        {
+            /* Initial state */
+            case USHELL_STATE_INIT :
+            {
+                /* Print header */
+                uShellTermRender(session, USHELL_HELLO_MSG);
                 break;
             }
 
             /* Authentication state */
             case USHELL_STATE_AUTH :
             {
-                do
-                {
-                    /* Clear line */
-                    uShellPrintStr(ushell, USHELL_CLEAR_LINE);
-
-                    /* Print the password prompt */
-                    uShellPrintStr(ushell, USHELL_AUTH_PROMPT);
-
-                    /* Print the IO */
-                    uShellPrintStr(ushell, ushell->io.buffer);
+                /* Render the password line */
+                uShellTermRender(session, USHELL_AUTH_PROMPT);
+                break;
+            }
 
-                    /* Check we have any input symbol */
-                    socketStatus = UShellSocketRead(readSocket, &item, 1U, 0U);
-                    if (socketStatus != USHELL_SOCKET_NO_ERR)
-                    {
-                        break;
-                    }
+            /* Processing input state */
+            case USHELL_STATE_PROC_INP :
+            {
+                /* Render the input line */
+                uShellTermRender(session, USHELL_USER_PROMPT);
+                break;
+            }
 
-                    /* Check the input */
-                    switch (item)
-                    {
-                        /* Carriage return (\r) */
-                        case USHELL_ASCII_CHAR_CR :
-                        case USHELL_ASCII_CHAR_LF :
-                        {
-                            /* Check password */
-                            int cmpRes = strcmp(ushell->io.buffer, USHELL_AUTH_PASSWORD);
-                            if (cmpRes == 0)
-                            {
-                                /* New line */
-                                uShellPrintStr(ushell, USHELL_NEW_LINE);
-
-                                /* Print succ msg */
-                                uShellPrintStr(ushell, USHELL_AUTH_OK_MSG);
-
-                                /* Clear io */
-                                uShellIoFlush(ushell);
-
-                                /* Change the state */
-                                ushell->fsmState = USHELL_STATE_PROC_INP;
-                            }
-                            else
-                            {
-                                /* New line */
-                                uShellPrintStr(ushell, USHELL_NEW_LINE);
-
-                                /* Print fail msg */
-                                uShellPrintStr(ushell, USHELL_AUTH_FAIL_MSG);
-                            }
+            /* Processing command state */
+            case USHELL_STATE_PROC_CMD :
+            {
+                /* Wait for the worker to finish the command */
+                if (uShellJobIsBusy(session) == true)
+                {
+                    break;
+                }
 
-                            break;
-                        }
+                /* Report the input lost meanwhile */
+                uShellInpOverrunReport(session);
 
-                        /* Backspace  */
-                        case USHELL_ASCII_CHAR_BS :
-                        case USHELL_ASCII_CHAR_DEL :
-                        {
-                            /* Process the command */
-                            uShellPrintStr(ushell, USHELL_DEL_CHAR);
+                /* Start a new line */
+                uShellTermReset(session);
 
-                            /* Remove the last char */
-                            if (ushell->io.ind > 0)
-                            {
-                                ushell->io.buffer [--ushell->io.ind] = 0;
-                            }
+                /* Change state to input */
+                session->fsmState = USHELL_STATE_PROC_INP;
 
-                            break;
-                        }
+                /* Render the prompt */
+                uShellTermRender(session, USHELL_USER_PROMPT);
+                break;
+            }
 
-                        /* Acknowledge */
-                        default :
-                        {
-                            /* Store the data */
-                            uShellIoAddChar(ushell, item);
+            /* Error state */
+            case USHELL_STATE_ERROR :
+            {
+                /* Clear screen */
+                uShellPrintStr(session, USHELL_CLEAR_SCREEN);
 
-                            break;
-                        }
-                    }
+                /* Flush the io */
+                uShellIoFlush(session);
 
-                    /* Check current state */
-                    if (ushell->fsmState != USHELL_STATE_AUTH)
-                    {
-                        break;
-                    }
+                /* Start a new line */
+                uShellTermReset(session);
 
-                } while (1);
+                /* Change state to init */
+                session->fsmState = USHELL_STATE_INIT;
 
+                /* Print header */
+                uShellTermRender(session, USHELL_HELLO_MSG);
                 break;
             }
 
-            /* Processing input state */
-            case USHELL_STATE_PROC_INP :
+            /* Nothing to show */
+            default :
             {
+                break;
+            }
+        }
+
+    } while (0);
+}
+
+/**
+ * \brief Process one input symbol by the uShell finite state machine
+ * \param[in] session - the uShell session
+ * \param[in] item - input symbol
+ * \return none
+ */
+static void uShellFsmProc(UShellSession_s* const session,
+                          const UShellItem_t item)
+{
+    do
+    {
+        /* Check input parameters */
+        if (session == NULL)
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            break;
+        }
 
-                do
+        /* Check the state */
+        switch (session->fsmState)
+        {
+            /* Initial state */
+            case USHELL_STATE_INIT :
+            {
+                /* Check the input, if it is not CR or LF */
+                if (!(item == USHELL_ASCII_CHAR_CR) &&
+                    !(item == USHELL_ASCII_CHAR_LF))
                 {
-                    /* Clear line */
-                    uShellPrintStr(ushell, USHELL_CLEAR_LINE);
+                    break;
+                }
 
-                    /* Print the prompt */
-                    uShellPrintStr(ushell, USHELL_USER_PROMPT);
+                /* Flush the io */
+                uShellIoFlush(session);
 
-                    /* Print IO */
-                    uShellPrintStr(ushell, ushell->io.buffer);
+                /* Start a new line */
+                uShellTermReset(session);
 
-                    /* Check we have any input symbol */
-                    socketStatus = UShellSocketRead(readSocket, &item, 1U, 0U);
-                    if (socketStatus != USHELL_SOCKET_NO_ERR)
-                    {
-                        break;
-                    }
+                /* Change the state */
+                session->fsmState = (session->cfg.authIsEn == true)
+                                       ? USHELL_STATE_AUTH
+                                       : USHELL_STATE_PROC_INP;
+                break;
+            }
 
-                    /* Process the data */
-                    switch (item)
+            /* Authentication state */
+            case USHELL_STATE_AUTH :
+            {
+                /* Check the input */
+                switch (item)
+                {
+                    /* Carriage return (\r) */
+                    case USHELL_ASCII_CHAR_CR :
+                    case USHELL_ASCII_CHAR_LF :
                     {
-                        /* Carriage return (\r) */
-                        case USHELL_ASCII_CHAR_CR :
-                        case USHELL_ASCII_CHAR_LF :
+                        /* Show the typed line */
+                        uShellTermRender(session, USHELL_AUTH_PROMPT);
+
+                        /* Check password */
+                        int cmpRes = strcmp(session->io.buffer, USHELL_AUTH_PASSWORD);
+                        if (cmpRes == 0)
                         {
+                            /* New line */
+                            uShellPrintStr(session, USHELL_NEW_LINE);
 
-                            /* Add to history */
-                            uShellHistoryCmdAdd(ushell);
+                            /* Print succ msg */
+                            uShellPrintStr(session, USHELL_AUTH_OK_MSG);
 
-                            /* Find cmd */
-                            ushell->currCmd = uShellCmdFind(ushell);
+                            /* Clear io */
+                            uShellIoFlush(session);
 
-                            /* Check we find cmd */
-                            if (ushell->currCmd == NULL)
-                            {
-                                /* Flush the io */
-                                uShellIoFlush(ushell);
+                            /* Change the state */
+                            session->fsmState = USHELL_STATE_PROC_INP;
+                        }
+                        else
+                        {
+                            /* New line */
+                            uShellPrintStr(session, USHELL_NEW_LINE);
 
-                                /* New line */
-                                uShellPrintStr(ushell, USHELL_NEW_LINE);
+                            /* Print fail msg */
+                            uShellPrintStr(session, USHELL_AUTH_FAIL_MSG);
+                        }
 
-                                /* Print error msg */
-                                uShellPrintStr(ushell, USHELL_CMD_NOT_FOUND_MSG);
-                                break;
-                            }
+                        /* Start a new line */
+                        uShellTermReset(session);
 
-                            /* Print new line */
-                            uShellPrintStr(ushell, USHELL_NEW_LINE);
+                        break;
+                    }
 
-                            /* Change state to proc cmd */
-                            ushell->fsmState = USHELL_STATE_PROC_CMD;
+                    /* Backspace  */
+                    case USHELL_ASCII_CHAR_BS :
+                    case USHELL_ASCII_CHAR_DEL :
+                    {
+                        /* Remove the char before the cursor */
+                        uShellIoDelChar(session);
 
-                            break;
-                        }
+                        break;
+                    }
+
+                    /* Acknowledge */
+                    default :
+                    {
+                        /* Store the data */
+                        uShellIoAddChar(session, item);
+
+                        break;
+                    }
+                }
+
+                break;
+            }
+
+            /* Processing input state */
+            case USHELL_STATE_PROC_INP :
+            {
+                /* Process the data */
+                switch (item)
+                {
+                    /* Carriage return (\r) */
+                    case USHELL_ASCII_CHAR_CR :
+                    case USHELL_ASCII_CHAR_LF :
+                    {
+                        /* Move the cursor to the end of the line */
+                        session->io.cursor = session->io.ind;
+                        uShellTermRender(session, USHELL_USER_PROMPT);
+
+                        /* Print new line */
+                        uShellPrintStr(session, USHELL_NEW_LINE);
 
-                        /* Escape sequence */
-                        case USHELL_ASCII_CHAR_ESC :
+                        /* Start a new line */
+                        uShellTermReset(session);
+
+                        /* Skip the empty line (e.g. LF of CRLF) */
+                        if (session->io.ind == 0U)
                         {
-                            /* Change state to proc esc */
-                            ushell->fsmState = USHELL_STATE_PROC_ESC_SEQ;
                             break;
                         }
 
-                        /* Backspace  */
-                        case USHELL_ASCII_CHAR_BS :
-                        case USHELL_ASCII_CHAR_DEL :
-                        {
-                            /* Delete the last char */
-                            uShellIoDelChar(ushell);
+                        /* Add to history */
+                        uShellHistoryCmdAdd(session);
 
-                            /* Process the command */
-                            uShellPrintStr(ushell, USHELL_DEL_CHAR);
+                        /* Find cmd */
+                        session->currCmd = uShellCmdFind(session);
+
+                        /* Check we find cmd */
+                        if (session->currCmd == NULL)
+                        {
+                            /* Flush the io */
+                            uShellIoFlush(session);
 
+                            /* Print error msg */
+                            uShellPrintStr(session, USHELL_CMD_NOT_FOUND_MSG);
                             break;
                         }
 
-                        /* Horizontal tab */
-                        case USHELL_ASCII_CHAR_TAB :
-                        {
-                            /* Check autocomplete is enable */
-                            if (ushell->cfg.promptIsEn == false)
-                            {
-                                break;
-                            }
+                        /* Change state to proc cmd */
+                        session->fsmState = USHELL_STATE_PROC_CMD;
 
-                            /* Autocomplete */
-                            uShellCmdAutoComplete(ushell);
+                        break;
+                    }
 
+                    /* Frame delimiter at the empty line switches to machine mode */
+                    case USHELL_COBS_DELIMITER :
+                    {
+                        if (session->io.ind > 0U)
+                        {
                             break;
                         }
 
-                        /* Acknowledge */
-                        default :
-                        {
-                            /* Check if we have space in the buffer */
-                            uShellIoAddChar(ushell, item);
+                        /* Let the host sync to the frames */
+                        const char delimiter = (char) USHELL_COBS_DELIMITER;
+                        uShellPrintBuf(session, &delimiter, 1U);
 
-                            break;
-                        }
+                        /* Change state to machine */
+                        session->machine.rxInd = 0U;
+                        session->machine.rxIsDropped = false;
+                        session->fsmState = USHELL_STATE_MACHINE;
+                        break;
                     }
 
-                    /* Check current state */
-                    if (ushell->fsmState != USHELL_STATE_PROC_INP)
+                    /* Escape sequence */
+                    case USHELL_ASCII_CHAR_ESC :
                     {
+                        /* Change state to proc esc */
+                        session->fsmState = USHELL_STATE_PROC_ESC_SEQ;
                         break;
                     }
 
-                } while (1);
+                    /* Backspace  */
+                    case USHELL_ASCII_CHAR_BS :
+                    case USHELL_ASCII_CHAR_DEL :
+                    {
+                        /* Delete the char before the cursor */
+                        uShellIoDelChar(session);
 
-                break;
-            }
+                        break;
+                    }
 
-            /* Processing command state */
-            case USHELL_STATE_PROC_CMD :
-            {
+                    /* Horizontal tab */
+                    case USHELL_ASCII_CHAR_TAB :
+                    {
+                        /* Check autocomplete is enable */
+                        if (session->cfg.promptIsEn == false)
+                        {
+                            break;
+                        }
 
-                /* Exec curr cmd */
-                uShellCmdCurExec(ushell);
+                        /* Autocomplete */
+                        uShellCmdAutoComplete(session);
 
-                /* flush curr cmd */
-                ushell->currCmd = NULL;
+                        break;
+                    }
 
-                /* Flush the io */
-                uShellIoFlush(ushell);
+                    /* Acknowledge */
+                    default :
+                    {
+                        /* Check if we have space in the buffer */
+                        uShellIoAddChar(session, item);
 
-                /* Change state to input */
-                ushell->fsmState = USHELL_STATE_PROC_INP;
+                        break;
+                    }
+                }
 
                 break;
             }
@@ -895,97 +1699,126 @@ static void uShellWorker(void* const uShell)
             /* Processing escape state */
             case USHELL_STATE_PROC_ESC_SEQ :
             {
-
-                do
+                /* Process the data */
+                switch (item)
                 {
-                    /* Check we have any input symbol */
-                    socketStatus = UShellSocketRead(readSocket, &item, 1U, 0U);
-                    if (socketStatus != USHELL_SOCKET_NO_ERR)
+                    case '[' :
                     {
+                        /* All ok go next*/
                         break;
                     }
 
-                    /* Process the data */
-                    switch (item)
+                    /* Arrow up */
+                    case 'A' :
                     {
-                        case '[' :
-                        {
-                            /* All ok go next*/
-                            break;
-                        }
-
-                        /* Arrow down */
-                        case 'A' :
-                        {
-                            /* Get prev cmd */
-                            uShellHistoryPrevCmdGet(ushell);
+                        /* Get prev cmd */
+                        uShellHistoryPrevCmdGet(session);
 
-                            /* Change state to proc input */
-                            ushell->fsmState = USHELL_STATE_PROC_INP;
-                            break;
-                        }
-
-                        case 'B' :
-                        {
-                            /* Get next cmd */
-                            uShellHistoryNextCmdGet(ushell);
+                        /* Change state to proc input */
+                        session->fsmState = USHELL_STATE_PROC_INP;
+                        break;
+                    }
 
-                            /* Change state to proc input */
-                            ushell->fsmState = USHELL_STATE_PROC_INP;
+                    /* Arrow down */
+                    case 'B' :
+                    {
+                        /* Get next cmd */
+                        uShellHistoryNextCmdGet(session);
 
-                            break;
-                        }
+                        /* Change state to proc input */
+                        session->fsmState = USHELL_STATE_PROC_INP;
 
-                        case 'C' :
-                        case 'D' :
-                        {
-                            /*  Change state to proc input */
-                            ushell->fsmState = USHELL_STATE_PROC_INP;
-                            break;
-                        }
+                        break;
+                    }
 
-                        default :
-                        {
-                            /* Flush the io */
-                            uShellIoFlush(ushell);
+                    /* Arrow right */
+                    case 'C' :
+                    {
+                        /* Move the cursor right */
+                        uShellIoCursorMove(session, true);
 
-                            /* Clear screen */
-                            uShellPrintStr(ushell, USHELL_CLEAR_SCREEN);
+                        /*  Change state to proc input */
+                        session->fsmState = USHELL_STATE_PROC_INP;
+                        break;
+                    }
 
-                            /* Change state to init */
-                            ushell->fsmState = USHELL_STATE_INIT;
+                    /* Arrow left */
+                    case 'D' :
+                    {
+                        /* Move the cursor left */
+                        uShellIoCursorMove(session, false);
 
-                            break;
-                        }
+                        /*  Change state to proc input */
+                        session->fsmState = USHELL_STATE_PROC_INP;
+                        break;
                     }
 
-                    /* Check if we are in the escape state */
-                    if (ushell->fsmState != USHELL_STATE_PROC_ESC_SEQ)
+                    default :
                     {
+                        /* Flush the io */
+                        uShellIoFlush(session);
+
+                        /* Clear screen */
+                        uShellPrintStr(session, USHELL_CLEAR_SCREEN);
+                        uShellTermReset(session);
+
+                        /* Change state to init */
+                        session->fsmState = USHELL_STATE_INIT;
+
                         break;
                     }
-
-                } while (1);
+                }
 
                 break;
             }
 
-            /* Error state */
-            case USHELL_STATE_ERROR :
+            /* Processing command state (the command takes its input from its own socket) */
+            case USHELL_STATE_PROC_CMD :
             {
-                /* Clear screen */
-                uShellPrintStr(ushell, USHELL_CLEAR_SCREEN);
+                /* Ctrl-C interrupts the command (the job prints the message when it stops,
+                   the console has one writer while the job runs), the raw input is data */
+                if ((item == USHELL_ASCII_CHAR_ETX) &&
+                    (session->job.inp != USHELL_CMD_INP_RAW) &&
+                    (uShellJobIsBusy(session) == true))
+                {
+                    session->job.cancel.isCanceled = true;
 
-                /* Flush the io */
-                uShellIoFlush(ushell);
+                    /* The input typed ahead of the canceled command is dropped too */
+                    session->typeAheadLen = 0U;
+                }
 
-                /* Change state to init */
-                ushell->fsmState = USHELL_STATE_INIT;
+                break;
+            }
+
+            /* Machine mode (the frames are taken without echo) */
+            case USHELL_STATE_MACHINE :
+            {
+                uShellMachineRx(session, item);
+                break;
+            }
 
+            /* Other states do not take the input */
+            default :
+            {
                 break;
             }
         }
-    }
+
+        /* Hand the command over to the worker pool right away, the shell keeps taking the input */
+        if ((session->fsmState == USHELL_STATE_PROC_CMD) &&
+            (session->currCmd != NULL))
+        {
+            /* Exec curr cmd */
+            uShellCmdCurExec(session);
+
+            /* flush curr cmd */
+            session->currCmd = NULL;
+
+            /* Flush the io */
+            uShellIoFlush(session);
+        }
+
+    } while (0);
 }
 
 /**
@@ -1019,30 +1852,6 @@ static UShellErr_e uShellRtEnvInit(UShell_s* const uShell,
             break;
         }
 
-        /* Attach the configuration object */
-        memcpy(&uShell->cfg, cfg, sizeof(UShellCfg_s));
-
-        /* Initialize the runtime environment history */
-        if (uShell->cfg.historyIsEn == true)
-        {
-            status = uShellRtEnvFuncHistoryInit(uShell);
-            if (status != USHELL_NO_ERR)
-            {
-                /* History init error */
-                USHELL_ASSERT(0);
-                break;
-            }
-        }
-
-        /* Initialize the runtime environment vcp */
-        status = uShellRtEnvVcpInit(uShell, vcp);
-        if (status != USHELL_NO_ERR)
-        {
-            /* VCP init error */
-            USHELL_ASSERT(0);
-            break;
-        }
-
         /* Initialize the cmdRoot */
         status = uShellRtEnvCmdRootInit(uShell, cmdRoot);
         if (status != USHELL_NO_ERR)
@@ -1061,6 +1870,15 @@ static UShellErr_e uShellRtEnvInit(UShell_s* const uShell,
             break;
         }
 
+        /* Initialize the first session */
+        status = uShellRtEnvSessionInit(uShell, cfg, vcp);
+        if (status != USHELL_NO_ERR)
+        {
+            /* Session init error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
     } while (0);
 
     /* Check status */
@@ -1094,18 +1912,18 @@ static UShellErr_e uShellRtEnvDeInit(UShell_s* const uShell)
             break;
         }
 
+        /* Deinitialize the sessions */
+        for (size_t ind = 0U; ind < USHELL_SESSION_MAX; ind++)
+        {
+            uShellRtEnvSessionDeInit(&uShell->session [ind]);
+        }
+
         /* Deinitialize the runtime environment OSAL */
         uShellRtEnvOsalDeInit(uShell);
 
-        /* Deinitialize the runtime environment authentication */
-        uShellRtEnvFuncHistoryDeInit(uShell);
-
         /* Deinitialize the runtime environment cmd */
         uShellRtEnvCmdRootDeInit(uShell);
 
-        /* Deinitialize the runtime environment vcp */
-        uShellRtEnvVcpDeInit(uShell);
-
     } while (0);
 
     return status;
@@ -1175,25 +1993,41 @@ static UShellErr_e uShellRtEnvOsalInit(UShell_s* const uShell,
             break;
         }
 
-        /* Create task */
-        UShellOsalThreadHandle_t thread = NULL;
-        UShellOsalThreadCfg_s threadCfg =
-            {
-                .name = USHELL_THREAD_NAME,
-                .stackSize = USHELL_THREAD_STACK_SIZE_BYTE,
-                .threadParam = uShell,
-                .threadPriority = USHELL_THREAD_PRIORITY,
-                .threadWorker = uShellWorker};
-        osalStatus = UShellOsalThreadCreate(thisOsal, &thread, threadCfg);
+        /* Create the queue of the command jobs (one job per session at most) */
+        osalStatus = UShellOsalQueueCreate(thisOsal,
+                                           sizeof(UShellSession_s*),
+                                           USHELL_SESSION_MAX,
+                                           &uShell->cmdQueue);
         if ((osalStatus != USHELL_OSAL_NO_ERR) ||
-            (thread == NULL))
+            (uShell->cmdQueue == NULL))
         {
-            /* Create task error */
+            /* Create queue error */
             USHELL_ASSERT(0);
             status = USHELL_PORT_ERR;
             break;
         }
 
+        /* Create the command worker pool */
+        UShellOsalThreadCfg_s workerCfg =
+            {
+                .name = USHELL_CMD_WORKER_THREAD_NAME,
+                .stackSize = USHELL_CMD_WORKER_THREAD_STACK_SIZE_BYTE,
+                .threadParam = uShell,
+                .threadPriority = USHELL_CMD_WORKER_THREAD_PRIORITY,
+                .threadWorker = uShellCmdWorker};
+        for (size_t ind = 0U; ind < USHELL_CMD_WORKER_NUM; ind++)
+        {
+            osalStatus = UShellOsalThreadCreate(thisOsal, &uShell->cmdWorker [ind], workerCfg);
+            if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+                (uShell->cmdWorker [ind] == NULL))
+            {
+                /* Create task error */
+                USHELL_ASSERT(0);
+                status = USHELL_PORT_ERR;
+                break;
+            }
+        }
+
     } while (0);
 
     /* Check status */
@@ -1218,24 +2052,27 @@ static UShellErr_e uShellRtEnvOsalDeInit(UShell_s* const uShell)
     UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
     UShellOsal_s* thisOsal = (UShellOsal_s*) uShell->osal;
 
-    /* Destroy osal objects */
-    /* : Delete the thread */
-    do
+    /* Destroy osal objects (the session threads are owned by the sessions) */
+    /* : Delete the command worker pool */
+    for (size_t ind = 0U; ind < USHELL_CMD_WORKER_NUM; ind++)
     {
-        /* : : Find the thread handle */
-        UShellOsalThreadHandle_t thread = NULL;
-        osalStatus = UShellOsalThreadHandleGet(thisOsal, 0U, &thread);
-        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
-            (thread == NULL))
+        if (uShell->cmdWorker [ind] == NULL)
         {
-            break;
+            continue;
         }
 
-        /* : : Delete the thread */
-        osalStatus = UShellOsalThreadDelete(thisOsal, thread);
+        osalStatus = UShellOsalThreadDelete(thisOsal, uShell->cmdWorker [ind]);
         USHELL_ASSERT(osalStatus == USHELL_OSAL_NO_ERR);
+        uShell->cmdWorker [ind] = NULL;
+    }
 
-    } while (0);
+    /* : Delete the queue of the command jobs */
+    if (uShell->cmdQueue != NULL)
+    {
+        osalStatus = UShellOsalQueueDelete(thisOsal, uShell->cmdQueue);
+        USHELL_ASSERT(osalStatus == USHELL_OSAL_NO_ERR);
+        uShell->cmdQueue = NULL;
+    }
 
     /* : Delete the lockObj */
     do
@@ -1285,26 +2122,29 @@ static UShellErr_e uShellRtEnvOsalDeInit(UShell_s* const uShell)
 }
 
 /**
- * \brief Initialize the runtime environment HAL
+ * \brief Initialize the runtime environment of a new session
  * \param uShell - uShell object
- * \param hal - hal object
+ * \param cfg - configuration object
+ * \param vcp - vcp object
  * \return USHELL_NO_ERR if success, otherwise error code
  */
-static UShellErr_e uShellRtEnvVcpInit(UShell_s* const uShell,
-                                      UShellVcp_s* const vcp)
+static UShellErr_e uShellRtEnvSessionInit(UShell_s* const uShell,
+                                          UShellCfg_s* const cfg,
+                                          UShellVcp_s* const vcp)
 {
     /* Local variables */
     UShellErr_e status = USHELL_NO_ERR;
-    UShellVcpErr_e vcpStatus = USHELL_VCP_NO_ERR;
-    UShellSocket_s* readSocket = NULL;
-    UShellSocket_s* writeSocket = NULL;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellSession_s* session = NULL;
+    size_t ind = 0U;
 
-    /* Initialize the runtime environment vcp */
     do
     {
         /* Check input parameters */
-        if (((uShell == NULL) ||
-             (vcp == NULL)))
+        if ((uShell == NULL) ||
+            (uShell->osal == NULL) ||
+            (cfg == NULL) ||
+            (vcp == NULL))
         {
             /* Invalid arguments */
             USHELL_ASSERT(0);
@@ -1312,85 +2152,351 @@ static UShellErr_e uShellRtEnvVcpInit(UShell_s* const uShell,
             break;
         }
 
-        /* Attach the vcp object */
-        uShell->vcp = vcp;
+        /* Find a free session slot */
+        for (ind = 0U; ind < USHELL_SESSION_MAX; ind++)
+        {
+            if (uShell->session [ind].used == false)
+            {
+                session = &uShell->session [ind];
+                break;
+            }
+        }
 
-        /* Init config for read */
-        uShell->vcpSessionCfg.readParam.owner = uShell;
-        uShell->vcpSessionCfg.readParam.type = USHELL_VCP_DIR_READ;
+        if (session == NULL)
+        {
+            /* No free session */
+            status = USHELL_SESSION_ERR;
+            break;
+        }
 
-        /* Init config for write */
-        uShell->vcpSessionCfg.writeParam.owner = uShell;
-        uShell->vcpSessionCfg.writeParam.type = USHELL_VCP_DIR_WRITE;
+        /* Take the slot */
+        memset(session, 0, sizeof(UShellSession_s));
+        session->shell = uShell;
+        session->ind = ind;
+        session->used = true;
 
-        /* Open session for read */
-        vcpStatus = UShellVcpSessionOpen(vcp,
-                                         uShell->vcpSessionCfg.readParam,
-                                         &readSocket);
-        if (vcpStatus != USHELL_VCP_NO_ERR)
+        /* Attach the configuration object */
+        memcpy(&session->cfg, cfg, sizeof(UShellCfg_s));
+
+        /* The host link has no authentication, so machine mode can not skip it */
+        session->fsmState = ((session->cfg.machineIsEn == true) &&
+                             (session->cfg.authIsEn == false))
+                                ? USHELL_STATE_MACHINE
+                                : USHELL_STATE_INIT;
+
+        /* Initialize the runtime environment history */
+        if (session->cfg.historyIsEn == true)
         {
-            /* Open session error */
+            status = uShellRtEnvFuncHistoryInit(session);
+            if (status != USHELL_NO_ERR)
+            {
+                /* History init error */
+                USHELL_ASSERT(0);
+                break;
+            }
+        }
+
+        /* Create the event group of the session (before the vcp calls back) */
+        osalStatus = UShellEventGroupCreate((UShellOsal_s*) uShell->osal, &session->event);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (session->event == NULL))
+        {
+            /* Create event group error */
             USHELL_ASSERT(0);
             status = USHELL_PORT_ERR;
             break;
         }
 
-        /* Save the read socket */
-        uShell->vcpSessionCfg.readSocket = readSocket;
-
-        /* Open session for write */
-        vcpStatus = UShellVcpSessionOpen(vcp,
-                                         uShell->vcpSessionCfg.writeParam,
-                                         &writeSocket);
-        if (vcpStatus != USHELL_VCP_NO_ERR)
+        /* Create the lock of the response frames */
+        osalStatus = UShellOsalLockObjCreate((UShellOsal_s*) uShell->osal, &session->txLock);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (session->txLock == NULL))
         {
-            /* Open session error */
+            /* Create mutex error */
             USHELL_ASSERT(0);
             status = USHELL_PORT_ERR;
             break;
         }
 
-        /* Save the write socket */
-        uShell->vcpSessionCfg.writeSocket = writeSocket;
-
-    } while (0);
-
-    return status;
-}
-
-/**
- * \brief Deinitialize the runtime environment HAL
- * \param uShell - uShell object
- * \return USHELL_NO_ERR if success, otherwise error code
- */
-static UShellErr_e uShellRtEnvVcpDeInit(UShell_s* const uShell)
-{
-    /* Local variables */
-    UShellErr_e status = USHELL_NO_ERR;
-    UShellVcpErr_e vcpStatus = USHELL_VCP_NO_ERR;
-
-    /* Deinitialize the runtime environment vcp */
-    do
-    {
-        /* Check input parameter */
-        if ((uShell == NULL) ||
-            (uShell->vcp == NULL))
+        /* Initialize the runtime environment vcp */
+        status = uShellRtEnvVcpInit(session, vcp);
+        if (status != USHELL_NO_ERR)
         {
+            /* VCP init error */
+            USHELL_ASSERT(0);
             break;
         }
 
-        /* Close read session */
-        do
+        /* Initialize the runtime environment pipe */
+        status = uShellRtEnvPipeInit(session);
+        if (status != USHELL_NO_ERR)
         {
-            /* Check input parameters */
-            if (uShell->vcpSessionCfg.readSocket == NULL)
-            {
-                break;
+            /* Pipe init error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Initialize the runtime environment input of the command */
+        status = uShellRtEnvInpInit(session);
+        if (status != USHELL_NO_ERR)
+        {
+            /* Input init error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Initialize the runtime environment redirection */
+        status = uShellRtEnvRedirectInit(session);
+        if (status != USHELL_NO_ERR)
+        {
+            /* Redirection init error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Initialize the runtime environment machine mode */
+        status = uShellRtEnvMachineInit(session);
+        if (status != USHELL_NO_ERR)
+        {
+            /* Machine mode init error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Create task (it is started by UShellRun) */
+        UShellOsalThreadCfg_s threadCfg =
+            {
+                .name = USHELL_THREAD_NAME,
+                .stackSize = USHELL_THREAD_STACK_SIZE_BYTE,
+                .threadParam = session,
+                .threadPriority = USHELL_THREAD_PRIORITY,
+                .threadWorker = uShellWorker};
+        osalStatus = UShellOsalThreadCreate((UShellOsal_s*) uShell->osal,
+                                            &session->thread,
+                                            threadCfg);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (session->thread == NULL))
+        {
+            /* Create task error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+    } while (0);
+
+    /* Release the slot on error */
+    if ((status != USHELL_NO_ERR) &&
+        (session != NULL))
+    {
+        uShellRtEnvSessionDeInit(session);
+    }
+
+    return status;
+}
+
+/**
+ * \brief Deinitialize the runtime environment of the session
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvSessionDeInit(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShell_s* uShell = NULL;
+
+    do
+    {
+        /* Check input parameter */
+        if ((session == NULL) ||
+            (session->used == false))
+        {
+            break;
+        }
+        uShell = (UShell_s*) session->shell;
+
+        /* Ask the running command to stop */
+        session->job.cancel.isCanceled = true;
+
+        /* Delete the thread */
+        if ((session->thread != NULL) &&
+            (uShell->osal != NULL))
+        {
+            osalStatus = UShellOsalThreadDelete((UShellOsal_s*) uShell->osal, session->thread);
+            if (osalStatus != USHELL_OSAL_NO_ERR)
+            {
+                /* Delete thread error (the rest is released anyway) */
+                USHELL_ASSERT(0);
+                status = USHELL_PORT_ERR;
+            }
+        }
+
+        /* Deinitialize the runtime environment history */
+        uShellRtEnvFuncHistoryDeInit(session);
+
+        /* Deinitialize the runtime environment vcp */
+        uShellRtEnvVcpDeInit(session);
+
+        /* Deinitialize the runtime environment pipe */
+        uShellRtEnvPipeDeInit(session);
+
+        /* Deinitialize the runtime environment input of the command */
+        uShellRtEnvInpDeInit(session);
+
+        /* Deinitialize the runtime environment redirection */
+        uShellRtEnvRedirectDeInit(session);
+
+        /* Deinitialize the runtime environment machine mode */
+        uShellRtEnvMachineDeInit(session);
+
+        /* Delete the event group */
+        if ((session->event != NULL) &&
+            (uShell->osal != NULL))
+        {
+            osalStatus = UShellEventGroupDelete((UShellOsal_s*) uShell->osal, session->event);
+            if (osalStatus != USHELL_OSAL_NO_ERR)
+            {
+                /* Delete event group error (the rest is released anyway) */
+                USHELL_ASSERT(0);
+                status = USHELL_PORT_ERR;
+            }
+        }
+
+        /* Delete the lock of the response frames */
+        if ((session->txLock != NULL) &&
+            (uShell->osal != NULL))
+        {
+            osalStatus = UShellOsalLockObjDelete((UShellOsal_s*) uShell->osal, session->txLock);
+            if (osalStatus != USHELL_OSAL_NO_ERR)
+            {
+                /* Delete mutex error (the rest is released anyway) */
+                USHELL_ASSERT(0);
+                status = USHELL_PORT_ERR;
+            }
+        }
+
+        /* Release the slot */
+        memset(session, 0, sizeof(UShellSession_s));
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Initialize the runtime environment HAL
+ * \param session - the uShell session
+ * \param hal - hal object
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvVcpInit(UShellSession_s* const session,
+                                      UShellVcp_s* const vcp)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellVcpErr_e vcpStatus = USHELL_VCP_NO_ERR;
+    UShellSocket_s* readSocket = NULL;
+    UShellSocket_s* writeSocket = NULL;
+
+    /* Initialize the runtime environment vcp */
+    do
+    {
+        /* Check input parameters */
+        if (((session == NULL) ||
+             (vcp == NULL)))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            status = USHELL_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Attach the vcp object */
+        session->vcp = vcp;
+
+        /* Init config for read */
+        session->vcpSessionCfg.readParam.owner = session;
+        session->vcpSessionCfg.readParam.type = USHELL_VCP_DIR_READ;
+        session->vcpSessionCfg.readParam.port = session->cfg.vcpPort;
+        session->vcpSessionCfg.readParam.rxCb = uShellInpCb;
+
+        /* Init config for write */
+        session->vcpSessionCfg.writeParam.owner = session;
+        session->vcpSessionCfg.writeParam.type = USHELL_VCP_DIR_WRITE;
+        session->vcpSessionCfg.writeParam.port = session->cfg.vcpPort;
+        session->vcpSessionCfg.writeParam.priority = USHELL_VCP_WRITE_PRIORITY;
+        session->vcpSessionCfg.writeParam.weight = USHELL_VCP_WRITE_WEIGHT;
+
+        /* Open session for read */
+        vcpStatus = UShellVcpSessionOpen(vcp,
+                                         session->vcpSessionCfg.readParam,
+                                         &readSocket);
+        if (vcpStatus != USHELL_VCP_NO_ERR)
+        {
+            /* Open session error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+        /* Save the read socket */
+        session->vcpSessionCfg.readSocket = readSocket;
+
+        /* Open session for write */
+        vcpStatus = UShellVcpSessionOpen(vcp,
+                                         session->vcpSessionCfg.writeParam,
+                                         &writeSocket);
+        if (vcpStatus != USHELL_VCP_NO_ERR)
+        {
+            /* Open session error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+        /* Save the write socket */
+        session->vcpSessionCfg.writeSocket = writeSocket;
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Deinitialize the runtime environment HAL
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvVcpDeInit(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellVcpErr_e vcpStatus = USHELL_VCP_NO_ERR;
+
+    /* Deinitialize the runtime environment vcp */
+    do
+    {
+        /* Check input parameter */
+        if ((session == NULL) ||
+            (session->vcp == NULL))
+        {
+            break;
+        }
+
+        /* Close read session */
+        do
+        {
+            /* Check input parameters */
+            if (session->vcpSessionCfg.readSocket == NULL)
+            {
+                break;
             }
 
             /* Close session for read */
-            vcpStatus = UShellVcpSessionClose((UShellVcp_s*) uShell->vcp,
-                                              uShell->vcpSessionCfg.readParam);
+            vcpStatus = UShellVcpSessionClose((UShellVcp_s*) session->vcp,
+                                              session->vcpSessionCfg.readParam);
             if (vcpStatus != USHELL_VCP_NO_ERR)
             {
                 /* Close session error */
@@ -1405,14 +2511,14 @@ static UShellErr_e uShellRtEnvVcpDeInit(UShell_s* const uShell)
         do
         {
             /* Check input parameters */
-            if (uShell->vcpSessionCfg.writeSocket == NULL)
+            if (session->vcpSessionCfg.writeSocket == NULL)
             {
                 break;
             }
 
             /* Close session for write */
-            vcpStatus = UShellVcpSessionClose((UShellVcp_s*) uShell->vcp,
-                                              uShell->vcpSessionCfg.writeParam);
+            vcpStatus = UShellVcpSessionClose((UShellVcp_s*) session->vcp,
+                                              session->vcpSessionCfg.writeParam);
             if (vcpStatus != USHELL_VCP_NO_ERR)
             {
                 /* Close session error */
@@ -1425,491 +2531,2585 @@ static UShellErr_e uShellRtEnvVcpDeInit(UShell_s* const uShell)
 
     } while (0);
 
-    return status;
+    return status;
+}
+
+/**
+ * \brief Initialize the runtime environment pipe
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvPipeInit(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
+    UShellOsal_s* osal = NULL;
+    UShellPipe_s* pipe = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->shell == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            status = USHELL_INVALID_ARGS_ERR;
+            break;
+        }
+        osal = (UShellOsal_s*) ((UShell_s*) session->shell)->osal;
+        pipe = &session->pipe;
+
+        /* Create the pipe buffer */
+        osalStatus = UShellOsalStreamBuffCreate(osal,
+                                                USHELL_PIPE_BUFFER_SIZE,
+                                                1U,
+                                                &pipe->stream);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (pipe->stream == NULL))
+        {
+            /* Stream buffer creation failed */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+        /* The commands of the pipe run at once, so both ends wait (the read end stops waiting when the left command is done) */
+        UShellSocketCfg_s socketCfg =
+            {
+                .type = USHELL_SOCKET_TYPE_WRITE,
+                .size = USHELL_PIPE_BUFFER_SIZE,
+                .noWait = false};
+
+        /* Init the write end */
+        socketStatus = UShellSocketInit(&pipe->writeSocket,
+                                        osal,
+                                        pipe->stream,
+                                        socketCfg,
+                                        &ushellPipeSocketCbTable,
+                                        session,
+                                        NULL);
+        if (socketStatus != USHELL_SOCKET_NO_ERR)
+        {
+            /* Socket init error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+        /* Init the read end */
+        socketCfg.type = USHELL_SOCKET_TYPE_READ;
+        socketStatus = UShellSocketInit(&pipe->readSocket,
+                                        osal,
+                                        pipe->stream,
+                                        socketCfg,
+                                        &ushellPipeSocketCbTable,
+                                        session,
+                                        NULL);
+        if (socketStatus != USHELL_SOCKET_NO_ERR)
+        {
+            /* Socket init error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+        /* Create the pipe thread (it sleeps until the worker starts the pipe) */
+        UShellOsalThreadCfg_s threadCfg =
+            {
+                .name = USHELL_PIPE_THREAD_NAME,
+                .stackSize = USHELL_PIPE_THREAD_STACK_SIZE_BYTE,
+                .threadParam = session,
+                .threadPriority = USHELL_PIPE_THREAD_PRIORITY,
+                .threadWorker = uShellPipeWorker};
+        osalStatus = UShellOsalThreadCreate(osal,
+                                            &session->pipeThread,
+                                            threadCfg);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (session->pipeThread == NULL))
+        {
+            /* Create task error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Deinitialize the runtime environment pipe
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvPipeDeInit(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellOsal_s* osal = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->shell == NULL) ||
+            (session->pipe.stream == NULL))
+        {
+            break;
+        }
+        osal = (UShellOsal_s*) ((UShell_s*) session->shell)->osal;
+
+        /* Delete the pipe thread */
+        if (session->pipeThread != NULL)
+        {
+            osalStatus = UShellOsalThreadDelete(osal, session->pipeThread);
+            if (osalStatus != USHELL_OSAL_NO_ERR)
+            {
+                /* Delete thread error (the rest is released anyway) */
+                USHELL_ASSERT(0);
+                status = USHELL_PORT_ERR;
+            }
+            session->pipeThread = NULL;
+        }
+
+        /* Deinit the ends */
+        UShellSocketDeInit(&session->pipe.writeSocket);
+        UShellSocketDeInit(&session->pipe.readSocket);
+
+        /* Delete the pipe buffer */
+        osalStatus = UShellOsalStreamBuffDelete(osal, session->pipe.stream);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* Stream buffer delete error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+        }
+        session->pipe.stream = NULL;
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Initialize the runtime environment input of the command job
+ * \note The session is the only reader of the console, it writes the input of the running command to this stream.
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvInpInit(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
+    UShellOsal_s* osal = NULL;
+    UShellPipe_s* input = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->shell == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            status = USHELL_INVALID_ARGS_ERR;
+            break;
+        }
+        osal = (UShellOsal_s*) ((UShell_s*) session->shell)->osal;
+        input = &session->input;
+
+        /* Create the input buffer */
+        osalStatus = UShellOsalStreamBuffCreate(osal,
+                                                USHELL_CMD_INP_BUFFER_SIZE,
+                                                1U,
+                                                &input->stream);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (input->stream == NULL))
+        {
+            /* Stream buffer creation failed */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+        /* The session never waits for the command (the input which does not fit is dropped) */
+        UShellSocketCfg_s socketCfg =
+            {
+                .type = USHELL_SOCKET_TYPE_WRITE,
+                .size = USHELL_CMD_INP_BUFFER_SIZE,
+                .noWait = true};
+
+        /* Init the write end */
+        socketStatus = UShellSocketInit(&input->writeSocket,
+                                        osal,
+                                        input->stream,
+                                        socketCfg,
+                                        &ushellPipeSocketCbTable,
+                                        session,
+                                        NULL);
+        if (socketStatus != USHELL_SOCKET_NO_ERR)
+        {
+            /* Socket init error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+        /* Init the read end (the command waits for its input) */
+        socketCfg.type = USHELL_SOCKET_TYPE_READ;
+        socketCfg.noWait = false;
+        socketStatus = UShellSocketInit(&input->readSocket,
+                                        osal,
+                                        input->stream,
+                                        socketCfg,
+                                        &ushellPipeSocketCbTable,
+                                        session,
+                                        NULL);
+        if (socketStatus != USHELL_SOCKET_NO_ERR)
+        {
+            /* Socket init error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Deinitialize the runtime environment input of the command job
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvInpDeInit(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellOsal_s* osal = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->shell == NULL) ||
+            (session->input.stream == NULL))
+        {
+            break;
+        }
+        osal = (UShellOsal_s*) ((UShell_s*) session->shell)->osal;
+
+        /* Deinit the ends */
+        UShellSocketDeInit(&session->input.writeSocket);
+        UShellSocketDeInit(&session->input.readSocket);
+
+        /* Delete the input buffer */
+        osalStatus = UShellOsalStreamBuffDelete(osal, session->input.stream);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* Stream buffer delete error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+        }
+        session->input.stream = NULL;
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Initialize the runtime environment redirection
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvRedirectInit(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
+    UShellOsal_s* osal = NULL;
+    UShellRedirect_s* redirect = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->shell == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            status = USHELL_INVALID_ARGS_ERR;
+            break;
+        }
+        osal = (UShellOsal_s*) ((UShell_s*) session->shell)->osal;
+        redirect = &session->redirect;
+
+        /* Create the stream (one chunk, the write callback empties it after every chunk) */
+        osalStatus = UShellOsalStreamBuffCreate(osal,
+                                                USHELL_REDIRECT_BLOCK_SIZE,
+                                                1U,
+                                                &redirect->stream);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (redirect->stream == NULL))
+        {
+            /* Stream buffer creation failed */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+        /* Init the socket */
+        UShellSocketCfg_s socketCfg =
+            {
+                .type = USHELL_SOCKET_TYPE_WRITE,
+                .size = USHELL_REDIRECT_BLOCK_SIZE};
+        socketStatus = UShellSocketInit(&redirect->socket,
+                                        osal,
+                                        redirect->stream,
+                                        socketCfg,
+                                        &ushellRedirectSocketCbTable,
+                                        session,
+                                        NULL);
+        if (socketStatus != USHELL_SOCKET_NO_ERR)
+        {
+            /* Socket init error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Deinitialize the runtime environment redirection
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvRedirectDeInit(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellOsal_s* osal = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->shell == NULL) ||
+            (session->redirect.stream == NULL))
+        {
+            break;
+        }
+        osal = (UShellOsal_s*) ((UShell_s*) session->shell)->osal;
+
+        /* Deinit the socket */
+        UShellSocketDeInit(&session->redirect.socket);
+
+        /* Delete the stream */
+        osalStatus = UShellOsalStreamBuffDelete(osal, session->redirect.stream);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* Stream buffer delete error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+        }
+        session->redirect.stream = NULL;
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Initialize the runtime environment machine mode
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvMachineInit(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
+    UShellOsal_s* osal = NULL;
+    UShellMachine_s* machine = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->shell == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            status = USHELL_INVALID_ARGS_ERR;
+            break;
+        }
+        osal = (UShellOsal_s*) ((UShell_s*) session->shell)->osal;
+        machine = &session->machine;
+
+        /* Create the input stream (the request carries only the line, nobody writes it) */
+        osalStatus = UShellOsalStreamBuffCreate(osal,
+                                                1U,
+                                                1U,
+                                                &machine->inpStream);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (machine->inpStream == NULL))
+        {
+            /* Stream buffer creation failed */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+        /* Create the output stream (one frame, the write callback empties it after every chunk) */
+        osalStatus = UShellOsalStreamBuffCreate(osal,
+                                                sizeof(machine->tx),
+                                                1U,
+                                                &machine->stream);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (machine->stream == NULL))
+        {
+            /* Stream buffer creation failed */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+        /* Init the input socket (the read of the empty stream does not wait) */
+        UShellSocketCfg_s socketCfg =
+            {
+                .type = USHELL_SOCKET_TYPE_READ,
+                .size = 1U,
+                .noWait = true};
+        socketStatus = UShellSocketInit(&machine->inpSocket,
+                                        osal,
+                                        machine->inpStream,
+                                        socketCfg,
+                                        &ushellPipeSocketCbTable,
+                                        session,
+                                        NULL);
+        if (socketStatus != USHELL_SOCKET_NO_ERR)
+        {
+            /* Socket init error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+        /* Init the output socket */
+        socketCfg.type = USHELL_SOCKET_TYPE_WRITE;
+        socketCfg.size = sizeof(machine->tx);
+        socketCfg.noWait = false;
+        socketStatus = UShellSocketInit(&machine->socket,
+                                        osal,
+                                        machine->stream,
+                                        socketCfg,
+                                        &ushellMachineSocketCbTable,
+                                        session,
+                                        NULL);
+        if (socketStatus != USHELL_SOCKET_NO_ERR)
+        {
+            /* Socket init error */
+            USHELL_ASSERT(0);
+            status = USHELL_PORT_ERR;
+            break;
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Deinitialize the runtime environment machine mode
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvMachineDeInit(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellOsal_s* osal = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->shell == NULL))
+        {
+            break;
+        }
+        osal = (UShellOsal_s*) ((UShell_s*) session->shell)->osal;
+
+        /* Deinit the sockets */
+        UShellSocketDeInit(&session->machine.inpSocket);
+        UShellSocketDeInit(&session->machine.socket);
+
+        /* Delete the streams */
+        if (session->machine.inpStream != NULL)
+        {
+            osalStatus = UShellOsalStreamBuffDelete(osal, session->machine.inpStream);
+            if (osalStatus != USHELL_OSAL_NO_ERR)
+            {
+                /* Stream buffer delete error */
+                USHELL_ASSERT(0);
+                status = USHELL_PORT_ERR;
+            }
+            session->machine.inpStream = NULL;
+        }
+
+        if (session->machine.stream != NULL)
+        {
+            osalStatus = UShellOsalStreamBuffDelete(osal, session->machine.stream);
+            if (osalStatus != USHELL_OSAL_NO_ERR)
+            {
+                /* Stream buffer delete error */
+                USHELL_ASSERT(0);
+                status = USHELL_PORT_ERR;
+            }
+            session->machine.stream = NULL;
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Initialize the runtime environment command
+ * \param uShell - uShell object
+ * \param cmdRoot - root command
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvCmdRootInit(UShell_s* const uShell,
+                                          UShellCmd_s* const cmdRoot)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;
+    UShellCmd_s* currCmd = cmdRoot;
+
+    /* Initialize the command list */
+    do
+    {
+        /* Check input parameters */
+        if ((uShell == NULL) ||
+            (cmdRoot == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            status = USHELL_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Attach the command root */
+        uShell->cmdRoot = cmdRoot;
+
+        /* Initialize the command list */
+        while (currCmd != NULL)
+        {
+
+            /* Set the parent */
+            cmdStatus = UShellCmdParentSet(currCmd, uShell);
+            if (cmdStatus != USHELL_CMD_NO_ERR)
+            {
+                /* Set parent error */
+                USHELL_ASSERT(0);
+                status = USHELL_CMD_ERR;
+                break;
+            }
+
+            /* Set hooks table */
+            cmdStatus = UShellCmdHookTableSet(currCmd, &ushellCmdHookTable);
+            if (cmdStatus != USHELL_CMD_NO_ERR)
+            {
+                /* Set hooks table error */
+                USHELL_ASSERT(0);
+                status = USHELL_CMD_ERR;
+                break;
+            }
+
+            /* Set the parent */
+            currCmd->parent = uShell;
+
+            /* Move to the next command */
+            cmdStatus = UShellCmdListNextGet(currCmd, &currCmd);
+            if (cmdStatus != USHELL_CMD_NO_ERR)
+            {
+                /* Move to the next command error */
+                USHELL_ASSERT(0);
+                status = USHELL_CMD_ERR;
+                break;
+            }
+        }
+
+        /* Check the command list is initialized */
+        if (status != USHELL_NO_ERR)
+        {
+            break;
+        }
+
+        /* Build the command index */
+        status = uShellCmdIndexBuild(uShell);
+
+    } while (0);
+
+    /* Check status */
+    if (status != USHELL_NO_ERR)
+    {
+        /* Deinitialize the runtime environment */
+        uShellRtEnvCmdRootDeInit(uShell);
+    }
+
+    /* Return status */
+    return status;
+}
+
+/**
+ * \brief Deinitialize the runtime environment command
+ * \param[in] uShell - uShell object
+ * \return UShellErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellErr_e uShellRtEnvCmdRootDeInit(UShell_s* const uShell)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;
+    UShellCmd_s* currCmd = uShell->cmdRoot;
+
+    do
+    {
+        /* Check input parameters */
+        if (uShell == NULL)
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            status = USHELL_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Deinitialize the command list */
+        while (currCmd != NULL)
+        {
+            /* Set the parent */
+            cmdStatus = UShellCmdParentSet(currCmd, NULL);
+            if (cmdStatus != USHELL_CMD_NO_ERR)
+            {
+                /* Set parent error */
+                USHELL_ASSERT(0);
+                status = USHELL_CMD_ERR;
+                break;
+            }
+
+            /* Set hooks table */
+            cmdStatus = UShellCmdHookTableSet(currCmd, NULL);
+            if (cmdStatus != USHELL_CMD_NO_ERR)
+            {
+                /* Set hooks table error */
+                USHELL_ASSERT(0);
+                status = USHELL_CMD_ERR;
+                break;
+            }
+
+            /* Move to the next command */
+            cmdStatus = UShellCmdListNextGet(currCmd, &currCmd);
+            if (cmdStatus != USHELL_CMD_NO_ERR)
+            {
+                /* Move to the next command error */
+                USHELL_ASSERT(0);
+                status = USHELL_CMD_ERR;
+                break;
+            }
+        }
+
+        /* Delete the command root */
+        uShell->cmdRoot = NULL;
+
+    } while (0);
+
+    /* Return status */
+    return status;
+}
+
+/**
+ * \brief Initialize the runtime environment history
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvFuncHistoryInit(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+
+    do
+    {
+        /* Check input parameters */
+        if (session == NULL)
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            status = USHELL_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Initialize the history */
+        status = UShellHistoryInit(&session->history,
+                                   session);
+        if (status != USHELL_NO_ERR)
+        {
+            /* History init error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Deinitialize the runtime environment history
+ * \param session - the uShell session
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+static UShellErr_e uShellRtEnvFuncHistoryDeInit(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+
+    do
+    {
+        /* Check input parameters */
+        if (session == NULL)
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            status = USHELL_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Deinitialize the history */
+        status = UShellHistoryDeInit(&session->history);
+        if (status != USHELL_NO_ERR)
+        {
+            /* History deinit error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Find cmd by name
+ * \param[in] session - the uShell session
+ * \return UShellCmd_s* - error code. non-zero = an error has occurred;
+ */
+static UShellCmd_s* uShellCmdFind(UShellSession_s* const session)
+{
+    /* Shared uShell object */
+    UShell_s* const uShell = (UShell_s*) session->shell;
+
+    /* Local variables */
+    UShellCmd_s* cmd = NULL;
+    size_t cmdNameLen = 0;
+
+    /* Find cmd */
+    do
+    {
+        /* Check inp  */
+        if ((session == NULL) ||
+            (uShell->cmdRoot == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            cmd = NULL;
+            break;
+        }
+
+        /* Find the length of the command name in the input */
+        cmdNameLen = strcspn(session->io.buffer, " ");
+
+        /* Look up the index (every command of the list is indexed when it is added) */
+        uShellLock(uShell);
+        cmd = uShellCmdIndexTake(uShell,
+                                 uShellCmdIndexFind(uShell, session->io.buffer, cmdNameLen),
+                                 &session->job.cmdProxy);
+        uShellUnlock(uShell);
+
+    } while (0);
+
+    /* Check status */
+    return cmd;
+}
+
+/**
+ * \brief Build the command index (commands sorted by name) from the command list
+ * \param[in] uShell - uShell object
+ * \return UShellErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellErr_e uShellCmdIndexBuild(UShell_s* const uShell)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    UShellCmdIndex_s* index = NULL;
+    UShellCmd_s* currCmd = NULL;
+    const UShellCmdDesc_s* descTable = NULL;
+    size_t descQty = 0U;
+    size_t ind = 0U;
+
+    do
+    {
+        /* Check input parameters */
+        if (uShell == NULL)
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            status = USHELL_INVALID_ARGS_ERR;
+            break;
+        }
+
+        index = &uShell->cmdIndex;
+        index->qty = 0U;
+
+        /* Insert every command of the list into its sorted place */
+        for (currCmd = uShell->cmdRoot; currCmd != NULL; currCmd = currCmd->next)
+        {
+            /* Check the command has a name */
+            if (currCmd->name == NULL)
+            {
+                USHELL_ASSERT(0);
+                continue;
+            }
+
+            /* The command added to the list directly belongs to the shell from now on */
+            currCmd->parent = uShell;
+            currCmd->hook = &ushellCmdHookTable;
+
+            status = uShellCmdIndexInsert(index, currCmd->name, currCmd, NULL);
+            if (status != USHELL_NO_ERR)
+            {
+                break;
+            }
+        }
+
+        if (status != USHELL_NO_ERR)
+        {
+            break;
+        }
+
+        /* Insert the defined commands (the section is not sorted by the linker) */
+        UShellCmdDescTableGet(&descTable, &descQty);
+        for (ind = 0U; ind < descQty; ind++)
+        {
+            /* Check the command has a name */
+            if ((descTable [ind].name == NULL) ||
+                (descTable [ind].execFunc == NULL))
+            {
+                USHELL_ASSERT(0);
+                continue;
+            }
+
+            status = uShellCmdIndexInsert(index, descTable [ind].name, NULL, &descTable [ind]);
+            if (status != USHELL_NO_ERR)
+            {
+                break;
+            }
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Insert the command into its sorted place of the index
+ * \param[in] index - the command index
+ * \param[in] name - name of the command
+ * \param[in] cmd - attached command (NULL for the defined one)
+ * \param[in] desc - defined command (NULL for the attached one)
+ * \return UShellErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellErr_e uShellCmdIndexInsert(UShellCmdIndex_s* const index,
+                                        const char* const name,
+                                        UShellCmd_s* const cmd,
+                                        const UShellCmdDesc_s* const desc)
+{
+    /* Local variables */
+    UShellErr_e status = USHELL_NO_ERR;
+    size_t ind = 0U;
+
+    do
+    {
+        /* Check we have space in the index */
+        if (index->qty >= USHELL_MAX_CMD)
+        {
+            /* Increase USHELL_MAX_CMD */
+            USHELL_ASSERT(0);
+            status = USHELL_CMD_ERR;
+            break;
+        }
+
+        /* Shift the bigger names to the right */
+        ind = index->qty;
+        while ((ind > 0U) &&
+               (strcmp(index->item [ind - 1U].name, name) > 0))
+        {
+            index->item [ind] = index->item [ind - 1U];
+            ind--;
+        }
+
+        index->item [ind].name = name;
+        index->item [ind].cmd = cmd;
+        index->item [ind].desc = desc;
+        index->qty++;
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Find cmd in the command index (binary search)
+ * \param[in] uShell - uShell object
+ * \param[in] name - name of the command (not necessarily terminated)
+ * \param[in] nameLen - length of the name
+ * \return const UShellCmdIndexItem_s* - found item, NULL if the command is not in the index
+ */
+static const UShellCmdIndexItem_s* uShellCmdIndexFind(UShell_s* const uShell,
+                                                      const char* const name,
+                                                      const size_t nameLen)
+{
+    /* Local variables */
+    const UShellCmdIndexItem_s* item = NULL;
+    size_t low = 0U;
+    size_t high = 0U;
+    size_t mid = 0U;
+    int cmpRes = 0;
+
+    do
+    {
+        /* Check input parameters */
+        if ((uShell == NULL) ||
+            (name == NULL) ||
+            (nameLen == 0U))
+        {
+            break;
+        }
+
+        /* Binary search over [low, high) */
+        high = uShell->cmdIndex.qty;
+        while (low < high)
+        {
+            mid = low + ((high - low) / 2U);
+            cmpRes = uShellCmdNameCmp(name, nameLen, uShell->cmdIndex.item [mid].name);
+            if (cmpRes == 0)
+            {
+                item = &uShell->cmdIndex.item [mid];
+                break;
+            }
+
+            if (cmpRes < 0)
+            {
+                high = mid;
+            }
+            else
+            {
+                low = mid + 1U;
+            }
+        }
+
+    } while (0);
+
+    return item;
+}
+
+/**
+ * \brief Take the command of the index item (the defined command is executed through the proxy object)
+ * \param[in] uShell - uShell object
+ * \param[in] item - item of the index
+ * \param[in] proxy - object to be filled for the defined command
+ * \return UShellCmd_s* - command to be executed, NULL if the item is NULL
+ */
+static UShellCmd_s* uShellCmdIndexTake(UShell_s* const uShell,
+                                       const UShellCmdIndexItem_s* const item,
+                                       UShellCmd_s* const proxy)
+{
+    /* Local variables */
+    UShellCmd_s* cmd = NULL;
+    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;
+    const UShellCmdDesc_s* descTable = NULL;
+    size_t descQty = 0U;
+
+    do
+    {
+        /* Check input parameters */
+        if ((uShell == NULL) ||
+            (item == NULL) ||
+            (proxy == NULL))
+        {
+            break;
+        }
+
+        /* The attached command is executed as is */
+        if (item->cmd != NULL)
+        {
+            cmd = item->cmd;
+            break;
+        }
+
+        /* Make the object of the defined command */
+        cmdStatus = UShellCmdInit(proxy,
+                                  (UShellCmdName_t) item->desc->name,
+                                  (UShellCmdHelp_t) item->desc->help,
+                                  item->desc->execFunc);
+        if (cmdStatus != USHELL_CMD_NO_ERR)
+        {
+            /* Init error */
+            USHELL_ASSERT(0);
+            break;
+        }
+        UShellCmdParentSet(proxy, uShell);
+        UShellCmdHookTableSet(proxy, &ushellCmdHookTable);
+
+        /* The statistics of the defined command outlive the proxy */
+        UShellCmdDescTableGet(&descTable, &descQty);
+        if ((descTable != NULL) &&
+            (item->desc >= descTable) &&
+            ((size_t) (item->desc - descTable) < USHELL_MAX_CMD))
+        {
+            UShellCmdExecStatsRecordSet(proxy, &uShell->cmdDescStats [item->desc - descTable]);
+        }
+        cmd = proxy;
+
+    } while (0);
+
+    return cmd;
+}
+
+/**
+ * \brief Compare the name with the name of the command
+ * \param[in] name - name (not necessarily terminated)
+ * \param[in] nameLen - length of the name
+ * \param[in] cmdName - name of the command
+ * \return int - less than, equal to, or greater than zero like strcmp()
+ */
+static int uShellCmdNameCmp(const char* const name,
+                            const size_t nameLen,
+                            const char* const cmdName)
+{
+    /* Local variables */
+    int cmpRes = strncmp(name, cmdName, nameLen);
+
+    /* The name is a prefix of the command name, so it is less */
+    if ((cmpRes == 0) &&
+        (cmdName [nameLen] != '\0'))
+    {
+        cmpRes = -1;
+    }
+
+    return cmpRes;
+}
+
+/**
+ * \brief Lock the uShell monitor
+ * \param[in] uShell - pointer to a UShell_s instance;
+ * \return no;
+ */
+static void uShellLock(const UShell_s* const uShell)
+{
+    /* Local variables */
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellOsalLockObjHandle_t lockObj = NULL;
+    UShellOsal_s* osal = (UShellOsal_s*) uShell->osal;
+
+    /* Lock */
+    do
+    {
+        /* Check input parameters */
+        if ((uShell == NULL) ||
+            (osal == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Get the lock object */
+        osalStatus = UShellOsalLockObjHandleGet(osal,
+                                                0U,
+                                                &lockObj);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (lockObj == NULL))
+        {
+            /* Get lock object error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Lock */
+        osalStatus = UShellOsalLock(osal, lockObj);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* Lock error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+    } while (0);
+}
+
+/**
+ * \brief Unlock the uShell monitor
+ * \param[in] uShell - pointer to a UShell_s instance;
+ * \return no;
+ */
+static void uShellUnlock(const UShell_s* const uShell)
+{
+    /* Local variables */
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellOsalLockObjHandle_t lockObj = NULL;
+    UShellOsal_s* osal = (UShellOsal_s*) uShell->osal;
+
+    /* Unlock */
+    do
+    {
+        /* Check input parameters */
+        if ((uShell == NULL) ||
+            (osal == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Get the lock object */
+        osalStatus = UShellOsalLockObjHandleGet(osal,
+                                                0U,
+                                                &lockObj);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (lockObj == NULL))
+        {
+            /* Get lock object error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Unlock */
+        osalStatus = UShellOsalUnlock(osal, lockObj);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* Lock error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+    } while (0);
+}
+
+/**
+ * \brief Lock the cmd
+ * \param cmd - the cmd to be locked
+ * \return none
+ */
+static void uShellCmdLock(void* const cmd)
+{
+    /* Local variables */
+    USHELL_ASSERT(cmd != NULL);
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellCmd_s* uShellCmd = (UShellCmd_s*) cmd;
+    UShell_s* uShell = (UShell_s*) uShellCmd->parent;
+    UShellOsal_s* osal = (UShellOsal_s*) uShell->osal;
+    UShellOsalLockObjHandle_t lockObj = NULL;
+
+    /* Lock */
+    do
+    {
+        /* Check input parameters */
+        if ((uShellCmd == NULL) ||
+            (uShell == NULL) ||
+            (osal == NULL))
+        {
+            break;
+        }
+
+        /* Get the lock object */
+        osalStatus = UShellOsalLockObjHandleGet(osal,
+                                                1U,
+                                                &lockObj);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (lockObj == NULL))
+        {
+            /* Get lock object error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Unlock */
+        osalStatus = UShellOsalLock(osal, lockObj);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* Lock error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+    } while (0);
+}
+
+/**
+ * \brief Unlock the cmd
+ * \param cmd - the cmd to be unlocked
+ * \return none
+ */
+static void uShellCmdUnlock(void* const cmd)
+{
+    /* Local variables */
+    USHELL_ASSERT(cmd != NULL);
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellCmd_s* uShellCmd = (UShellCmd_s*) cmd;
+    UShell_s* uShell = (UShell_s*) uShellCmd->parent;
+    UShellOsal_s* osal = (UShellOsal_s*) uShell->osal;
+    UShellOsalLockObjHandle_t lockObj = NULL;
+
+    /* Unlock */
+    do
+    {
+        /* Check input parameters */
+        if ((uShellCmd == NULL) ||
+            (uShell == NULL) ||
+            (osal == NULL))
+        {
+            /* Invalid arguments */
+            break;
+        }
+
+        /* Get the lock object */
+        osalStatus = UShellOsalLockObjHandleGet(osal,
+                                                1U,
+                                                &lockObj);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (lockObj == NULL))
+        {
+            /* Get lock object error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Unlock */
+        osalStatus = UShellOsalUnlock(osal, lockObj);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* Lock error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+    } while (0);
+}
+
+/**
+ * \brief Get the time for the cmd statistics
+ * \param cmd - the cmd to be measured
+ * \return uint32_t - time in milliseconds
+ */
+static uint32_t uShellCmdTimeGet(void* const cmd)
+{
+    /* Local variables */
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellCmd_s* uShellCmd = (UShellCmd_s*) cmd;
+    UShellOsalTimeMs_t timeMs = 0U;
+
+    do
+    {
+        /* Check input parameters */
+        if ((uShellCmd == NULL) ||
+            (uShellCmd->parent == NULL) ||
+            (((UShell_s*) uShellCmd->parent)->osal == NULL))
+        {
+            break;
+        }
+
+        /* Get the time */
+        osalStatus = UShellOsalTimeMsGet((UShellOsal_s*) ((UShell_s*) uShellCmd->parent)->osal, &timeMs);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* The statistics go without the time */
+            timeMs = 0U;
+        }
+
+    } while (0);
+
+    return (uint32_t) timeMs;
+}
+
+/**
+ * \brief Find the cmd by name in the command index (lookup hook of the cmd)
+ * \param cmd - the cmd which looks for
+ * \param name - name of the cmd to be found
+ * \param proxy - object to be filled for the defined cmd
+ * \return UShellCmd_s* - found cmd, NULL if there is no such cmd
+ */
+static UShellCmd_s* uShellCmdLookup(void* const cmd,
+                                    const char* const name,
+                                    UShellCmd_s* const proxy)
+{
+    /* Local variables */
+    UShellCmd_s* uShellCmd = (UShellCmd_s*) cmd;
+    UShell_s* uShell = NULL;
+    UShellCmd_s* found = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((uShellCmd == NULL) ||
+            (uShellCmd->parent == NULL) ||
+            (name == NULL) ||
+            (proxy == NULL))
+        {
+            break;
+        }
+        uShell = (UShell_s*) uShellCmd->parent;
+
+        /* The index is shared by the sessions */
+        uShellLock(uShell);
+        found = uShellCmdIndexTake(uShell,
+                                   uShellCmdIndexFind(uShell, name, strlen(name)),
+                                   proxy);
+        uShellUnlock(uShell);
+
+    } while (0);
+
+    return found;
+}
+
+/**
+ * \brief Rebuild the command index after the command list is changed (list hook of the cmd)
+ * \note The commands added to the list by UShellCmdListAdd are indexed here, so the lookup needs no list walk.
+ * \param cmd - the cmd of the changed list
+ * \return none
+ */
+static void uShellCmdListUpd(void* const cmd)
+{
+    /* Local variables */
+    UShellCmd_s* uShellCmd = (UShellCmd_s*) cmd;
+    UShell_s* uShell = NULL;
+    UShellErr_e status = USHELL_NO_ERR;
+
+    do
+    {
+        /* Check input parameters */
+        if ((uShellCmd == NULL) ||
+            (uShellCmd->parent == NULL))
+        {
+            break;
+        }
+        uShell = (UShell_s*) uShellCmd->parent;
+
+        /* The index is shared by the sessions */
+        uShellLock(uShell);
+        status = uShellCmdIndexBuild(uShell);
+        uShellUnlock(uShell);
+        USHELL_ASSERT(status == USHELL_NO_ERR);
+        (void) status;
+
+    } while (0);
+}
+
+/**
+ * \brief Io flush function
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellIoFlush(UShellSession_s* const session)
+{
+
+    do
+    {
+        /* Check input parameters */
+        if (session == NULL)
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Clear the buffer */
+        memset(session->io.buffer, 0, USHELL_BUFFER_SIZE);
+        session->io.ind = 0;
+        session->io.cursor = 0;
+
+    } while (0);
+}
+
+/**
+ * \brief Execute the command (queue it to the command worker pool)
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellCmdCurExec(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShell_s* uShell = NULL;
+    UShellCmdJob_s* job = NULL;
+
+    do
+    {
+        /* Check if current command exists */
+        if ((session == NULL) ||
+            (session->currCmd == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            break;
+        }
+        uShell = (UShell_s*) session->shell;
+        job = &session->job;
+
+        /* The console job writes to the console and reads the input forwarded by the session */
+        job->readSocket = &session->input.readSocket;
+        job->writeSocket = session->vcpSessionCfg.writeSocket;
+        job->isMachine = false;
+        job->inp = session->currCmd->inp;
+
+        /* The line is edited while the command runs, so the job keeps its own copy */
+        cmdStatus = uShellCmdJobPrepare(session, session->io.buffer);
+        if (cmdStatus != USHELL_CMD_NO_ERR)
+        {
+            break;
+        }
+
+        /* Drop the input left by the previous command (nobody reads or writes the stream now) */
+        osalStatus = UShellOsalStreamBuffReset((UShellOsal_s*) uShell->osal, session->input.stream);
+        USHELL_ASSERT(osalStatus == USHELL_OSAL_NO_ERR);
+
+        /* Prepare the job */
+        job->cmd = session->currCmd;
+        job->cancel.isCanceled = false;
+        uShellLock(uShell);
+        job->isBusy = true;
+        uShellUnlock(uShell);
+
+        /* Queue the job (the queue has a slot per session, so it does not wait) */
+        UShellSession_s* item = session;
+        osalStatus = UShellOsalQueueItemPut((UShellOsal_s*) uShell->osal,
+                                            uShell->cmdQueue,
+                                            &item);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* No worker is available, execute the command on the session thread */
+            USHELL_ASSERT(0);
+            uShellCmdJobExec(session);
+        }
+
+    } while (0);
+}
+
+/**
+ * \brief Execute the command job of the session (called by the command worker)
+ * \param session - the uShell session
+ * \return none
+ */
+static void uShellCmdJobExec(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellCmdJob_s* job = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->job.cmd == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            break;
+        }
+        job = &session->job;
+
+        /* Execute the command */
+        uShellCmdJobRun(session);
+
+        /* Report the interruption once the command has stopped */
+        if (job->cancel.isCanceled == true)
+        {
+            uShellJobPrintStr(session, USHELL_CMD_CANCEL_MSG);
+        }
+
+    } while (0);
+
+    /* Release the session and wake it up (it shows the prompt again) */
+    if (job != NULL)
+    {
+        job->cmd = NULL;
+        job->pipeCmd = NULL;
+        uShellLock((UShell_s*) session->shell);
+        job->isBusy = false;
+        uShellUnlock((UShell_s*) session->shell);
+        uShellSessionEventSet(session, USHELL_SESSION_EVENT_JOB_DONE);
+    }
+}
+
+/**
+ * \brief Prepare the command job: copy the line, cut the redirection and the pipe, parse the arguments
+ * \note The errors are reported to the write socket of the job.
+ * \param[in] session - the uShell session
+ * \param[in] line - command line
+ * \return UShellCmdErr_e - error code. non-zero = the job can not be executed;
+ */
+static UShellCmdErr_e uShellCmdJobPrepare(UShellSession_s* const session,
+                                          const char* const line)
+{
+    /* Local variables */
+    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;
+    UShell_s* uShell = NULL;
+    UShellCmdJob_s* job = NULL;
+    char* pipeLine = NULL;
+    char* restLine = NULL;
+    char* redirectLine = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (line == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            cmdStatus = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+        uShell = (UShell_s*) session->shell;
+        job = &session->job;
+
+        /* Take the copy of the line (argv points into it) */
+        strncpy(job->line, line, sizeof(job->line) - 1U);
+        job->line [sizeof(job->line) - 1U] = '\0';
+        job->pipeCmd = NULL;
+        job->pipeArgc = 0;
+        job->redirectPath = NULL;
+        job->redirectIsAppend = false;
+
+        /* Cut the line at the redirection (cmd > file, cmd >> file) */
+        cmdStatus = UShellCmdLineSplit(job->line, '>', &redirectLine);
+        if ((cmdStatus == USHELL_CMD_NO_ERR) &&
+            (redirectLine != NULL))
+        {
+            /* Check the append mode */
+            if (*redirectLine == '>')
+            {
+                job->redirectIsAppend = true;
+                redirectLine++;
+            }
+
+            /* The rest of the line is the only path */
+            int redirectArgc = 0;
+            cmdStatus = UShellCmdArgsParse(redirectLine,
+                                           &job->redirectPath,
+                                           1U,
+                                           &redirectArgc);
+            if ((cmdStatus != USHELL_CMD_NO_ERR) ||
+                (redirectArgc != 1))
+            {
+                uShellJobPrintStr(session, USHELL_REDIRECT_SYNTAX_MSG);
+                cmdStatus = USHELL_CMD_ARGS_SYNTAX_ERR;
+                break;
+            }
+
+            /* Check someone can take the output */
+            if (uShell->sink == NULL)
+            {
+                uShellJobPrintStr(session, USHELL_REDIRECT_NO_SINK_MSG);
+                cmdStatus = USHELL_CMD_NOT_INIT_ERR;
+                break;
+            }
+        }
+
+        /* Cut the line at the pipe (cmd | pipeCmd) */
+        if (cmdStatus == USHELL_CMD_NO_ERR)
+        {
+            cmdStatus = UShellCmdLineSplit(job->line, '|', &pipeLine);
+        }
+        if ((cmdStatus == USHELL_CMD_NO_ERR) &&
+            (pipeLine != NULL))
+        {
+            /* Look for one more pipe */
+            cmdStatus = UShellCmdLineSplit(pipeLine, '|', &restLine);
+        }
+
+        if (cmdStatus != USHELL_CMD_NO_ERR)
+        {
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Split the line into arguments (argv [0] is the command name) */
+        cmdStatus = UShellCmdArgsParse(job->line,
+                                       job->argv,
+                                       USHELL_CMD_MAX_ARGV + 1U,
+                                       &job->argc);
+        if ((cmdStatus == USHELL_CMD_NO_ERR) &&
+            (pipeLine != NULL))
+        {
+            /* Split the pipe command into arguments */
+            cmdStatus = UShellCmdArgsParse(pipeLine,
+                                           job->pipeArgv,
+                                           USHELL_CMD_MAX_ARGV + 1U,
+                                           &job->pipeArgc);
+        }
+
+        if (cmdStatus != USHELL_CMD_NO_ERR)
+        {
+            /* Report instead of truncating */
+            uShellJobPrintStr(session, (cmdStatus == USHELL_CMD_EXECUTE_NUMB_ARGS_ERR)
+                                          ? USHELL_CMD_ARGS_OVERFLOW_MSG
+                                          : USHELL_CMD_ARGS_SYNTAX_MSG);
+            break;
+        }
+
+        /* Check the command name is here (the machine mode request can be blank) */
+        if (job->argc == 0)
+        {
+            uShellJobPrintStr(session, USHELL_CMD_NOT_FOUND_MSG);
+            cmdStatus = USHELL_CMD_ARGS_SYNTAX_ERR;
+            break;
+        }
+
+        /* Find the pipe command */
+        if (pipeLine != NULL)
+        {
+            /* The pipe command takes the rest of the line, one more pipe is not supported */
+            if ((job->pipeArgc == 0) ||
+                (restLine != NULL))
+            {
+                uShellJobPrintStr(session, USHELL_CMD_PIPE_SYNTAX_MSG);
+                cmdStatus = USHELL_CMD_ARGS_SYNTAX_ERR;
+                break;
+            }
+
+            uShellLock(uShell);
+            job->pipeCmd = uShellCmdIndexTake(uShell,
+                                              uShellCmdIndexFind(uShell,
+                                                                 job->pipeArgv [0],
+                                                                 strlen(job->pipeArgv [0])),
+                                              &job->pipeCmdProxy);
+            uShellUnlock(uShell);
+            if (job->pipeCmd == NULL)
+            {
+                uShellJobPrintStr(session, USHELL_CMD_NOT_FOUND_MSG);
+                cmdStatus = USHELL_CMD_INVALID_ARGS_ERR;
+                break;
+            }
+        }
+
+    } while (0);
+
+    return cmdStatus;
+}
+
+/**
+ * \brief Run the prepared command job (with the redirection and the pipe)
+ * \param[in] session - the uShell session
+ * \return UShellCmdErr_e - error code of the command
+ */
+static UShellCmdErr_e uShellCmdJobRun(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;
+    UShellCmdJob_s* job = NULL;
+    const UShellCmdSink_s* sink = NULL;
+    UShellSocket_s* writeSocket = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->job.cmd == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            cmdStatus = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+        job = &session->job;
+        writeSocket = job->writeSocket;
+
+        /* Open the sink of the redirection, the command writes to it instead of the console */
+        if (job->redirectPath != NULL)
+        {
+            sink = ((UShell_s*) session->shell)->sink;
+            if ((sink == NULL) ||
+                (sink->open(sink->parent, job->redirectPath, job->redirectIsAppend) != USHELL_CMD_NO_ERR))
+            {
+                uShellJobPrintStr(session, USHELL_REDIRECT_FAIL_MSG);
+                cmdStatus = USHELL_CMD_PORT_ERR;
+                break;
+            }
+
+            session->redirect.ind = 0U;
+            session->redirect.isFailed = false;
+            writeSocket = &session->redirect.socket;
+        }
+
+        /* Execute the command (skip the command name, it is already in job->cmd) */
+        cmdStatus = (job->pipeCmd != NULL)
+                        ? uShellCmdPipeExec(session, writeSocket)
+                        : UShellCmdExec(job->cmd,
+                                        job->readSocket,
+                                        writeSocket,
+                                        job->argc - 1,
+                                        &job->argv [1],
+                                        &job->cancel);
+
+        /* Write the rest of the output and close the sink */
+        if (sink != NULL)
+        {
+            uShellRedirectFlush(session, true);
+            if ((sink->close(sink->parent) != USHELL_CMD_NO_ERR) ||
+                (session->redirect.isFailed == true))
+            {
+                uShellJobPrintStr(session, USHELL_REDIRECT_FAIL_MSG);
+            }
+        }
+        if ((cmdStatus != USHELL_CMD_NO_ERR) &&
+            (cmdStatus != USHELL_CMD_CANCELED_ERR))
+        {
+            /* Command execution error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+    } while (0);
+
+    return cmdStatus;
 }
 
 /**
- * \brief Initialize the runtime environment command
- * \param uShell - uShell object
- * \param cmdRoot - root command
- * \return USHELL_NO_ERR if success, otherwise error code
+ * \brief Execute the command job with the pipe (the left command here and the right one on the pipe thread at once)
+ * \param[in] session - the uShell session
+ * \param[in] writeSocket - socket for the output of the right command
+ * \return UShellCmdErr_e - error code of the right command (USHELL_CMD_CANCELED_ERR if the pipe is canceled)
  */
-static UShellErr_e uShellRtEnvCmdRootInit(UShell_s* const uShell,
-                                          UShellCmd_s* const cmdRoot)
+static UShellCmdErr_e uShellCmdPipeExec(UShellSession_s* const session,
+                                        UShellSocket_s* const writeSocket)
 {
     /* Local variables */
-    UShellErr_e status = USHELL_NO_ERR;
     UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;
-    UShellCmd_s* currCmd = cmdRoot;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellOsalEventGroupBits_e bits = USHELL_OSAL_EVENT_GROUP_BIT_NONE;
+    UShellCmdJob_s* job = &session->job;
+    UShellPipe_s* pipe = &session->pipe;
+    UShellOsal_s* osal = (UShellOsal_s*) ((UShell_s*) session->shell)->osal;
 
-    /* Initialize the command list */
     do
     {
-        /* Check input parameters */
-        if ((uShell == NULL) ||
-            (cmdRoot == NULL))
+        /* Start with the empty pipe (the pipe thread sleeps, nobody uses it) */
+        osalStatus = UShellOsalStreamBuffReset(osal, pipe->stream);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
         {
-            /* Invalid arguments */
+            /* Reset error */
             USHELL_ASSERT(0);
-            status = USHELL_INVALID_ARGS_ERR;
+            cmdStatus = USHELL_CMD_PORT_ERR;
             break;
         }
-
-        /* Attach the command root */
-        uShell->cmdRoot = cmdRoot;
-
-        /* Initialize the command list */
-        while (currCmd != NULL)
+        pipe->readSocket.cfg.noWait = false;
+
+        /* Start the right command on the pipe thread */
+        job->pipeWriteSocket = writeSocket;
+        job->pipeStatus = USHELL_CMD_NO_ERR;
+        uShellSessionEventSet(session, USHELL_SESSION_EVENT_PIPE_RUN);
+
+        /* The left command writes to the pipe (it waits while the right command takes the output) */
+        cmdStatus = UShellCmdExec(job->cmd,
+                                  job->readSocket,
+                                  &pipe->writeSocket,
+                                  job->argc - 1,
+                                  &job->argv [1],
+                                  &job->cancel);
+
+        /* Close the write end: the read end gives the rest of the output and then the end of the input */
+        pipe->readSocket.cfg.noWait = true;
+
+        /* Wait for the right command (the pipe thread drains the pipe, so the left command has not waited forever) */
+        osalStatus = UShellEventGroupBitsWait(osal,
+                                              session->event,
+                                              (UShellOsalEventGroupBits_e) USHELL_SESSION_EVENT_PIPE_DONE,
+                                              &bits,
+                                              true,
+                                              false);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
         {
+            /* Wait error */
+            USHELL_ASSERT(0);
+            cmdStatus = USHELL_CMD_PORT_ERR;
+            break;
+        }
 
-            /* Set the parent */
-            cmdStatus = UShellCmdParentSet(currCmd, uShell);
-            if (cmdStatus != USHELL_CMD_NO_ERR)
-            {
-                /* Set parent error */
-                USHELL_ASSERT(0);
-                status = USHELL_CMD_ERR;
-                break;
-            }
+        /* The pipe is canceled by any of the commands, otherwise the right command tells the result */
+        cmdStatus = ((cmdStatus == USHELL_CMD_CANCELED_ERR) ||
+                     (UShellCmdIsCanceled(&job->cancel) == true))
+                        ? USHELL_CMD_CANCELED_ERR
+                        : job->pipeStatus;
 
-            /* Set hooks table */
-            cmdStatus = UShellCmdHookTableSet(currCmd, &ushellCmdHookTable);
-            if (cmdStatus != USHELL_CMD_NO_ERR)
-            {
-                /* Set hooks table error */
-                USHELL_ASSERT(0);
-                status = USHELL_CMD_ERR;
-                break;
-            }
+    } while (0);
 
-            /* Set the parent */
-            currCmd->parent = uShell;
+    return cmdStatus;
+}
 
-            /* Move to the next command */
-            cmdStatus = UShellCmdListNextGet(currCmd, &currCmd);
-            if (cmdStatus != USHELL_CMD_NO_ERR)
-            {
-                /* Move to the next command error */
-                USHELL_ASSERT(0);
-                status = USHELL_CMD_ERR;
-                break;
-            }
-        }
+/**
+ * \brief Callback of the pipe sockets (the pipe has no one to notify)
+ * \param[in] socket - socket object
+ * \param[in] type - type of the callback
+ * \param[in] parent - the uShell session
+ * \return none
+ */
+static void uShellPipeSocketCb(void* socket,
+                               UShellSocketCbType_e type,
+                               void* parent)
+{
+    (void) socket;
+    (void) type;
+    (void) parent;
+}
 
-    } while (0);
+/**
+ * \brief Callback of the redirection socket (moves the written items to the block of the sink)
+ * \param[in] socket - socket object
+ * \param[in] type - type of the callback
+ * \param[in] parent - the uShell session
+ * \return none
+ */
+static void uShellRedirectSocketCb(void* socket,
+                                   UShellSocketCbType_e type,
+                                   void* parent)
+{
+    (void) socket;
 
-    /* Check status */
-    if (status != USHELL_NO_ERR)
+    /* Every written chunk is taken at once, so the stream never blocks the command */
+    if (type == USHELL_SOCKET_CB_TYPE_WRITE)
     {
-        /* Deinitialize the runtime environment */
-        uShellRtEnvCmdRootDeInit(uShell);
+        uShellRedirectFlush((UShellSession_s*) parent, false);
     }
-
-    /* Return status */
-    return status;
 }
 
 /**
- * \brief Deinitialize the runtime environment command
- * \param[in] uShell - uShell object
- * \return UShellErr_e - error code. non-zero = an error has occurred;
+ * \brief Move the items of the redirection stream to the block, write every full block to the sink
+ * \param[in] session - the uShell session
+ * \param[in] isLast - true to write the rest of the block too (the command is finished)
+ * \return none
  */
-static UShellErr_e uShellRtEnvCmdRootDeInit(UShell_s* const uShell)
+static void uShellRedirectFlush(UShellSession_s* const session,
+                                const bool isLast)
 {
     /* Local variables */
-    UShellErr_e status = USHELL_NO_ERR;
+    UShellRedirect_s* redirect = NULL;
+    const UShellCmdSink_s* sink = NULL;
+    UShellOsal_s* osal = NULL;
     UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;
-    UShellCmd_s* currCmd = uShell->cmdRoot;
+    size_t readCount = 0U;
 
     do
     {
         /* Check input parameters */
-        if (uShell == NULL)
+        if ((session == NULL) ||
+            (session->shell == NULL))
         {
             /* Invalid arguments */
             USHELL_ASSERT(0);
-            status = USHELL_INVALID_ARGS_ERR;
             break;
         }
+        redirect = &session->redirect;
+        sink = ((UShell_s*) session->shell)->sink;
+        osal = (UShellOsal_s*) ((UShell_s*) session->shell)->osal;
 
-        /* Deinitialize the command list */
-        while (currCmd != NULL)
+        /* Fill the block from the stream */
+        do
         {
-            /* Set the parent */
-            cmdStatus = UShellCmdParentSet(currCmd, NULL);
-            if (cmdStatus != USHELL_CMD_NO_ERR)
-            {
-                /* Set parent error */
-                USHELL_ASSERT(0);
-                status = USHELL_CMD_ERR;
-                break;
-            }
-
-            /* Set hooks table */
-            cmdStatus = UShellCmdHookTableSet(currCmd, NULL);
-            if (cmdStatus != USHELL_CMD_NO_ERR)
-            {
-                /* Set hooks table error */
-                USHELL_ASSERT(0);
-                status = USHELL_CMD_ERR;
-                break;
-            }
-
-            /* Move to the next command */
-            cmdStatus = UShellCmdListNextGet(currCmd, &currCmd);
-            if (cmdStatus != USHELL_CMD_NO_ERR)
+            readCount = UShellOsalStreamBuffReceive(osal,
+                                                    redirect->stream,
+                                                    &redirect->block [redirect->ind],
+                                                    sizeof(redirect->block) - redirect->ind,
+                                                    0U);
+            redirect->ind += readCount;
+
+            /* Write the full block (or the rest of the last one) */
+            if ((redirect->ind == sizeof(redirect->block)) ||
+                ((isLast == true) &&
+                 (readCount == 0U) &&
+                 (redirect->ind > 0U)))
             {
-                /* Move to the next command error */
-                USHELL_ASSERT(0);
-                status = USHELL_CMD_ERR;
-                break;
+                if ((redirect->isFailed == false) &&
+                    (sink != NULL))
+                {
+                    cmdStatus = sink->write(sink->parent, redirect->block, redirect->ind);
+                    redirect->isFailed = (cmdStatus != USHELL_CMD_NO_ERR);
+                }
+                redirect->ind = 0U;
             }
-        }
 
-        /* Delete the command root */
-        uShell->cmdRoot = NULL;
+        } while (readCount > 0U);
 
     } while (0);
-
-    /* Return status */
-    return status;
 }
 
 /**
- * \brief Initialize the runtime environment history
- * \param uShell - uShell object
- * \return USHELL_NO_ERR if success, otherwise error code
+ * \brief Take one item of the machine mode input (collect the frame, queue the request on the delimiter)
+ * \note The broken and oversized frames are dropped, the host finds them by the timeout.
+ * \param[in] session - the uShell session
+ * \param[in] item - input item
+ * \return none
  */
-static UShellErr_e uShellRtEnvFuncHistoryInit(UShell_s* const uShell)
+static void uShellMachineRx(UShellSession_s* const session,
+                            const UShellItem_t item)
 {
     /* Local variables */
-    UShellErr_e status = USHELL_NO_ERR;
+    UShellMachine_s* machine = NULL;
+    UShellCobsErr_e cobsStatus = USHELL_COBS_NO_ERR;
+    size_t frameLen = 0U;
 
     do
     {
         /* Check input parameters */
-        if (uShell == NULL)
+        if (session == NULL)
         {
             /* Invalid arguments */
             USHELL_ASSERT(0);
-            status = USHELL_INVALID_ARGS_ERR;
             break;
         }
+        machine = &session->machine;
 
-        /* Initialize the history */
-        status = UShellHistoryInit(&uShell->history,
-                                   uShell);
-        if (status != USHELL_NO_ERR)
+        /* Collect the frame up to the delimiter */
+        if ((uint8_t) item != USHELL_COBS_DELIMITER)
         {
-            /* History init error */
-            USHELL_ASSERT(0);
+            /* The oversized frame is dropped as a whole */
+            if (machine->rxInd >= sizeof(machine->rx))
+            {
+                machine->rxIsDropped = true;
+            }
+
+            if (machine->rxIsDropped == false)
+            {
+                machine->rx [machine->rxInd++] = (uint8_t) item;
+            }
             break;
         }
 
-    } while (0);
+        /* Decode the frame in place (the empty frames only sync the host) */
+        if ((machine->rxIsDropped == false) &&
+            (machine->rxInd > 0U))
+        {
+            cobsStatus = UShellCobsDecode(machine->rx,
+                                          machine->rxInd,
+                                          machine->rx,
+                                          USHELL_MACHINE_FRAME_SIZE,
+                                          &frameLen);
+            if ((cobsStatus == USHELL_COBS_NO_ERR) &&
+                (frameLen >= sizeof(uint16_t)))
+            {
+                uShellMachineReqPut(session, machine->rx, frameLen);
+            }
+        }
 
-    return status;
+        /* Start the next frame */
+        machine->rxInd = 0U;
+        machine->rxIsDropped = false;
+
+    } while (0);
 }
 
 /**
- * \brief Deinitialize the runtime environment history
- * \param uShell - uShell object
- * \return USHELL_NO_ERR if success, otherwise error code
+ * \brief Queue the machine mode request (or leave machine mode by the empty one)
+ * \param[in] session - the uShell session
+ * \param[in] frame - decoded request frame
+ * \param[in] frameLen - size of the frame
+ * \return none
  */
-static UShellErr_e uShellRtEnvFuncHistoryDeInit(UShell_s* const uShell)
+static void uShellMachineReqPut(UShellSession_s* const session,
+                                const uint8_t* const frame,
+                                const size_t frameLen)
 {
     /* Local variables */
-    UShellErr_e status = USHELL_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShell_s* uShell = NULL;
+    UShellMachine_s* machine = NULL;
+    UShellMachineReq_s* req = NULL;
+    uint16_t seq = 0U;
+    size_t lineLen = 0U;
+    bool isQueued = false;
 
     do
     {
         /* Check input parameters */
-        if (uShell == NULL)
+        if ((session == NULL) ||
+            (frame == NULL) ||
+            (frameLen < sizeof(uint16_t)) ||
+            (frameLen > USHELL_MACHINE_FRAME_SIZE))
         {
             /* Invalid arguments */
             USHELL_ASSERT(0);
-            status = USHELL_INVALID_ARGS_ERR;
             break;
         }
+        uShell = (UShell_s*) session->shell;
+        machine = &session->machine;
+        seq = (uint16_t) (frame [0] | ((uint16_t) frame [1] << 8U));
+        lineLen = frameLen - sizeof(uint16_t);
 
-        /* Deinitialize the history */
-        status = UShellHistoryDeInit(&uShell->history);
-        if (status != USHELL_NO_ERR)
+        /* The empty request leaves machine mode (when nothing is in flight) */
+        if (lineLen == 0U)
         {
-            /* History deinit error */
-            USHELL_ASSERT(0);
+            if (uShellJobIsBusy(session) == true)
+            {
+                uShellMachineSend(session, seq, 0U, USHELL_MACHINE_STATUS_BUSY, NULL, 0U);
+                break;
+            }
+
+            uShellMachineSend(session, seq, 0U, USHELL_CMD_NO_ERR, NULL, 0U);
+
+            /* Change state to input */
+            uShellIoFlush(session);
+            uShellTermReset(session);
+            session->fsmState = USHELL_STATE_PROC_INP;
             break;
         }
 
-    } while (0);
+        /* Take the free slot of the ring */
+        uShellLock(uShell);
+        if (machine->qty < USHELL_MACHINE_REQ_NUM)
+        {
+            req = &machine->req [(machine->head + machine->qty) % USHELL_MACHINE_REQ_NUM];
+            req->seq = seq;
+            memcpy(req->line, &frame [sizeof(uint16_t)], lineLen);
+            req->line [lineLen] = '\0';
+            machine->qty++;
+
+            /* Wake the worker up if it does not serve the session yet */
+            if (session->job.isBusy == false)
+            {
+                session->job.isMachine = true;
+                session->job.isBusy = true;
+                isQueued = true;
+            }
+        }
+        uShellUnlock(uShell);
 
-    return status;
+        /* Reject the request if too many are in flight */
+        if (req == NULL)
+        {
+            uShellMachineSend(session, seq, 0U, USHELL_MACHINE_STATUS_BUSY, NULL, 0U);
+            break;
+        }
+
+        if (isQueued == false)
+        {
+            break;
+        }
+
+        /* Queue the job (the queue has a slot per session, so it does not wait) */
+        UShellSession_s* item = session;
+        osalStatus = UShellOsalQueueItemPut((UShellOsal_s*) uShell->osal,
+                                            uShell->cmdQueue,
+                                            &item);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* No worker is available, execute the requests on the session thread */
+            USHELL_ASSERT(0);
+            uShellMachineExec(session);
+        }
+
+    } while (0);
 }
 
 /**
- * \brief Find cmd by name
- * \param[in] uShell - uShell object
- * \return UShellCmd_s* - error code. non-zero = an error has occurred;
+ * \brief Execute the queued machine mode requests of the session (called by the command worker)
+ * \note The requests are executed in order, the request stays in the ring until it is answered.
+ * \param[in] session - the uShell session
+ * \return none
  */
-static UShellCmd_s* uShellCmdFind(UShell_s* const uShell)
+static void uShellMachineExec(UShellSession_s* const session)
 {
     /* Local variables */
-    UShellCmd_s* cmd = NULL;
-    UShellCmd_s* currCmd = (UShellCmd_s*) uShell->cmdRoot;
     UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;
-    char* cmdName = NULL;
-    size_t cmdNameLen = 0;
-    int cmpRes = 0;
+    UShell_s* uShell = NULL;
+    UShellMachine_s* machine = NULL;
+    UShellCmdJob_s* job = NULL;
+    UShellMachineReq_s* req = NULL;
+    uint8_t status = 0U;
 
-    /* Find cmd */
     do
     {
-        /* Check inp  */
-        if ((uShell == NULL) ||
-            (uShell->cmdRoot == NULL))
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->shell == NULL))
         {
             /* Invalid arguments */
             USHELL_ASSERT(0);
-            cmd = NULL;
             break;
         }
+        uShell = (UShell_s*) session->shell;
+        machine = &session->machine;
+        job = &session->job;
 
-        /* Go through the command list */
-        while (currCmd != NULL)
+        while (1)
         {
-            /* Get name of currCmd*/
-            cmdStatus = UShellCmdNameGet(currCmd, &cmdName);
-            if ((cmdStatus != USHELL_CMD_NO_ERR) ||
-                (cmdName == NULL))
+            /* Take the oldest request */
+            uShellLock(uShell);
+            if (machine->qty == 0U)
             {
-                /* Get name error */
-                cmd = NULL;
+                /* Release the session */
+                job->isMachine = false;
+                job->isBusy = false;
+                uShellUnlock(uShell);
+                uShellSessionEventSet(session, USHELL_SESSION_EVENT_JOB_DONE);
                 break;
             }
-
-            /* Find len */
-            cmdNameLen = strlen(cmdName);
-
-            /* Check if the name is equal to the input string */
-            cmpRes = strncmp(uShell->io.buffer, cmdName, cmdNameLen);
-
-            /* Check if the name is equal to the input string */
-            if ((cmpRes == 0) &&
-                ((uShell->io.buffer [cmdNameLen] == ' ') ||
-                 (uShell->io.buffer [cmdNameLen] == 0)))
+            req = &machine->req [machine->head];
+            uShellUnlock(uShell);
+
+            /* The request has no input, its output goes to the response */
+            job->readSocket = &machine->inpSocket;
+            job->writeSocket = &machine->socket;
+            job->seq = req->seq;
+            job->cmd = NULL;
+            job->cancel.isCanceled = false;
+            machine->txInd = 0U;
+
+            /* Prepare the job and find the command */
+            cmdStatus = uShellCmdJobPrepare(session, req->line);
+            if (cmdStatus == USHELL_CMD_NO_ERR)
             {
-                /* Check if the command is found */
-                cmd = currCmd;
-                break;
+                uShellLock(uShell);
+                job->cmd = uShellCmdIndexTake(uShell,
+                                              uShellCmdIndexFind(uShell,
+                                                                 job->argv [0],
+                                                                 strlen(job->argv [0])),
+                                              &job->cmdProxy);
+                uShellUnlock(uShell);
             }
 
-            /* Move to the next command */
-            cmdStatus = UShellCmdListNextGet(currCmd, &currCmd);
+            /* Execute the command */
             if (cmdStatus != USHELL_CMD_NO_ERR)
             {
-                /* Move to the next command error */
-                USHELL_ASSERT(0);
-                cmd = NULL;
-                break;
+                status = (uint8_t) cmdStatus;
+            }
+            else if (job->cmd == NULL)
+            {
+                status = USHELL_MACHINE_STATUS_NOT_FOUND;
+            }
+            else
+            {
+                status = (uint8_t) uShellCmdJobRun(session);
             }
+
+            /* Answer with the rest of the output and the status */
+            uShellMachineFlush(session);
+            uShellMachineSend(session, job->seq, 0U, status, machine->tx, machine->txInd);
+            machine->txInd = 0U;
+            job->cmd = NULL;
+            job->pipeCmd = NULL;
+
+            /* Free the slot */
+            uShellLock(uShell);
+            machine->head = (machine->head + 1U) % USHELL_MACHINE_REQ_NUM;
+            machine->qty--;
+            uShellUnlock(uShell);
         }
 
     } while (0);
-
-    /* Check status */
-    return cmd;
 }
 
 /**
- * \brief Lock the uShell monitor
- * \param[in] uShell - pointer to a UShell_s instance;
- * \return no;
+ * \brief Move the output of the request to the response, send every full response frame
+ * \param[in] session - the uShell session
+ * \return none
  */
-static void uShellLock(const UShell_s* const uShell)
+static void uShellMachineFlush(UShellSession_s* const session)
 {
     /* Local variables */
-    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
-    UShellOsalLockObjHandle_t lockObj = NULL;
-    UShellOsal_s* osal = (UShellOsal_s*) uShell->osal;
+    UShellMachine_s* machine = NULL;
+    UShellOsal_s* osal = NULL;
+    size_t readCount = 0U;
 
-    /* Lock */
     do
     {
         /* Check input parameters */
-        if ((uShell == NULL) ||
-            (osal == NULL))
+        if ((session == NULL) ||
+            (session->shell == NULL))
         {
             /* Invalid arguments */
             USHELL_ASSERT(0);
             break;
         }
+        machine = &session->machine;
+        osal = (UShellOsal_s*) ((UShell_s*) session->shell)->osal;
 
-        /* Get the lock object */
-        osalStatus = UShellOsalLockObjHandleGet(osal,
-                                                0U,
-                                                &lockObj);
-        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
-            (lockObj == NULL))
+        /* Fill the response from the stream */
+        do
         {
-            /* Get lock object error */
-            USHELL_ASSERT(0);
-            break;
-        }
+            readCount = UShellOsalStreamBuffReceive(osal,
+                                                    machine->stream,
+                                                    &machine->tx [machine->txInd],
+                                                    sizeof(machine->tx) - machine->txInd,
+                                                    0U);
+            machine->txInd += readCount;
+
+            /* Send the full response, more frames follow */
+            if (machine->txInd == sizeof(machine->tx))
+            {
+                uShellMachineSend(session,
+                                  session->job.seq,
+                                  USHELL_MACHINE_FLAG_MORE,
+                                  USHELL_CMD_NO_ERR,
+                                  machine->tx,
+                                  machine->txInd);
+                machine->txInd = 0U;
+            }
 
-        /* Lock */
-        osalStatus = UShellOsalLock(osal, lockObj);
-        if (osalStatus != USHELL_OSAL_NO_ERR)
-        {
-            /* Lock error */
-            USHELL_ASSERT(0);
-            break;
-        }
+        } while (readCount > 0U);
 
     } while (0);
 }
 
-/**
- * \brief Unlock the uShell monitor
- * \param[in] uShell - pointer to a UShell_s instance;
- * \return no;
+/**
+ * \brief Encode and send the response frame
+ * \param[in] session - the uShell session
+ * \param[in] seq - sequence id of the request
+ * \param[in] flags - flags of the frame (USHELL_MACHINE_FLAG_...)
+ * \param[in] status - status of the request (UShellCmdErr_e or USHELL_MACHINE_STATUS_...)
+ * \param[in] data - output of the command
+ * \param[in] len - size of the output
+ * \return none
  */
-static void uShellUnlock(const UShell_s* const uShell)
+static void uShellMachineSend(UShellSession_s* const session,
+                              const uint16_t seq,
+                              const uint8_t flags,
+                              const uint8_t status,
+                              const uint8_t* const data,
+                              const size_t len)
 {
     /* Local variables */
-    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
-    UShellOsalLockObjHandle_t lockObj = NULL;
-    UShellOsal_s* osal = (UShellOsal_s*) uShell->osal;
+    UShellCobsErr_e cobsStatus = USHELL_COBS_NO_ERR;
+    UShellOsal_s* osal = NULL;
+    uint8_t frame [USHELL_MACHINE_FRAME_SIZE] = {0};
+    uint8_t encoded [USHELL_COBS_ENCODED_SIZE(USHELL_MACHINE_FRAME_SIZE) + 1U] = {0};
+    size_t encodedLen = 0U;
 
-    /* Unlock */
     do
     {
         /* Check input parameters */
-        if ((uShell == NULL) ||
-            (osal == NULL))
+        if ((session == NULL) ||
+            ((data == NULL) && (len > 0U)) ||
+            (len > (USHELL_MACHINE_FRAME_SIZE - USHELL_MACHINE_HEADER_SIZE)))
         {
             /* Invalid arguments */
             USHELL_ASSERT(0);
             break;
         }
 
-        /* Get the lock object */
-        osalStatus = UShellOsalLockObjHandleGet(osal,
-                                                0U,
-                                                &lockObj);
-        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
-            (lockObj == NULL))
+        /* Build the frame */
+        frame [0] = (uint8_t) (seq & 0xFFU);
+        frame [1] = (uint8_t) (seq >> 8U);
+        frame [2] = flags;
+        frame [3] = status;
+        if (len > 0U)
         {
-            /* Get lock object error */
-            USHELL_ASSERT(0);
-            break;
+            memcpy(&frame [USHELL_MACHINE_HEADER_SIZE], data, len);
         }
 
-        /* Unlock */
-        osalStatus = UShellOsalUnlock(osal, lockObj);
-        if (osalStatus != USHELL_OSAL_NO_ERR)
+        /* Encode and terminate it */
+        cobsStatus = UShellCobsEncode(frame,
+                                      USHELL_MACHINE_HEADER_SIZE + len,
+                                      encoded,
+                                      sizeof(encoded) - 1U,
+                                      &encodedLen);
+        if (cobsStatus != USHELL_COBS_NO_ERR)
         {
-            /* Lock error */
+            /* Encode error */
             USHELL_ASSERT(0);
             break;
         }
+        encoded [encodedLen++] = USHELL_COBS_DELIMITER;
+
+        /* The session thread and the worker both answer, the frames are not mixed
+           (the lock of the session only: the blocking write does not stop the other sessions) */
+        osal = (UShellOsal_s*) ((UShell_s*) session->shell)->osal;
+        UShellOsalLock(osal, session->txLock);
+        uShellPrintBuf(session, (const char*) encoded, encodedLen);
+        UShellOsalUnlock(osal, session->txLock);
 
     } while (0);
 }
 
 /**
- * \brief Lock the cmd
- * \param cmd - the cmd to be locked
+ * \brief Callback of the machine mode output socket (moves the written items to the response)
+ * \param[in] socket - socket object
+ * \param[in] type - type of the callback
+ * \param[in] parent - the uShell session
  * \return none
  */
-static void uShellCmdLock(void* const cmd)
+static void uShellMachineSocketCb(void* socket,
+                                  UShellSocketCbType_e type,
+                                  void* parent)
+{
+    (void) socket;
+
+    /* Every written chunk is taken at once, so the stream never blocks the command */
+    if (type == USHELL_SOCKET_CB_TYPE_WRITE)
+    {
+        uShellMachineFlush((UShellSession_s*) parent);
+    }
+}
+
+/**
+ * \brief Auto complete the command
+ * \param session - the uShell session
+ * \return none
+ *
+ * This function finds the range of the indexed commands which names start with the input.
+ * The input is completed to the longest common prefix of the range (the first and the last names).
+ * If the input can not be extended, the names of the range are printed in columns by one write.
+ */
+static void uShellCmdAutoComplete(UShellSession_s* const session)
 {
+    /* Shared uShell object */
+    UShell_s* const uShell = (UShell_s*) session->shell;
+
     /* Local variables */
-    USHELL_ASSERT(cmd != NULL);
-    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
-    UShellCmd_s* uShellCmd = (UShellCmd_s*) cmd;
-    UShell_s* uShell = (UShell_s*) uShellCmd->parent;
-    UShellOsal_s* osal = (UShellOsal_s*) uShell->osal;
-    UShellOsalLockObjHandle_t lockObj = NULL;
+    UShellCmdIndex_s* index = NULL;
+    size_t inputLen = 0U;
+    size_t first = 0U;
+    size_t last = 0U;
+    size_t prefixLen = 0U;
+    const char* firstName = NULL;
+    const char* lastName = NULL;
 
-    /* Lock */
     do
     {
         /* Check input parameters */
-        if ((uShellCmd == NULL) ||
-            (uShell == NULL) ||
-            (osal == NULL))
+        if ((session == NULL) ||
+            (uShell->cmdRoot == NULL))
         {
             break;
         }
 
-        /* Get the lock object */
-        osalStatus = UShellOsalLockObjHandleGet(osal,
-                                                1U,
-                                                &lockObj);
-        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
-            (lockObj == NULL))
+        /* Only the command name is completed */
+        inputLen = session->io.ind;
+        if ((inputLen == 0U) ||
+            (memchr(session->io.buffer, ' ', inputLen) != NULL))
         {
-            /* Get lock object error */
-            USHELL_ASSERT(0);
             break;
         }
 
-        /* Unlock */
-        osalStatus = UShellOsalLock(osal, lockObj);
-        if (osalStatus != USHELL_OSAL_NO_ERR)
+        /* Lock */
+        uShellLock(uShell);
+
+        /* Find the range of matches */
+        index = &uShell->cmdIndex;
+        first = uShellCmdIndexLowerBound(uShell, session->io.buffer, inputLen);
+        last = first;
+        while ((last < index->qty) &&
+               (strncmp(index->item [last].name, session->io.buffer, inputLen) == 0))
         {
-            /* Lock error */
-            USHELL_ASSERT(0);
+            last++;
+        }
+
+        /* Check we have any match */
+        if (first == last)
+        {
+            uShellUnlock(uShell);
             break;
         }
 
+        /* The common prefix of the sorted range is the prefix of its first and last names */
+        firstName = index->item [first].name;
+        lastName = index->item [last - 1U].name;
+        prefixLen = inputLen;
+        while ((firstName [prefixLen] != '\0') &&
+               (firstName [prefixLen] == lastName [prefixLen]) &&
+               (prefixLen < (USHELL_BUFFER_SIZE - 1U)))
+        {
+            prefixLen++;
+        }
+
+        if (prefixLen > inputLen)
+        {
+            /* Complete the input buffer up to the common prefix */
+            memcpy(session->io.buffer, firstName, prefixLen);
+            session->io.buffer [prefixLen] = '\0';
+            session->io.ind = prefixLen;
+            session->io.cursor = prefixLen;
+        }
+        else if ((last - first) > 1U)
+        {
+            /* Nothing to complete — show the candidates */
+            uShellCmdCandidatesPrint(session, first, last);
+
+            /* The prompt has to be printed again */
+            uShellTermReset(session);
+        }
+
+        /* Unlock */
+        uShellUnlock(uShell);
+
     } while (0);
 }
 
 /**
- * \brief Unlock the cmd
- * \param cmd - the cmd to be unlocked
+ * \brief Find the first indexed command which name is not less than the prefix
+ * \param[in] uShell - the uShell object
+ * \param[in] prefix - prefix (not necessarily terminated)
+ * \param[in] prefixLen - length of the prefix
+ * \return size_t - position in the index (qty if there is no such command)
+ */
+static size_t uShellCmdIndexLowerBound(UShell_s* const uShell,
+                                       const char* const prefix,
+                                       const size_t prefixLen)
+{
+    /* Local variables */
+    size_t low = 0U;
+    size_t high = uShell->cmdIndex.qty;
+    size_t mid = 0U;
+
+    /* Binary search over [low, high) */
+    while (low < high)
+    {
+        mid = low + ((high - low) / 2U);
+        if (strncmp(uShell->cmdIndex.item [mid].name, prefix, prefixLen) < 0)
+        {
+            low = mid + 1U;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * \brief Print the names of the indexed commands in columns
+ * \note The listing is collected in a local buffer and written at once (flushed earlier only if the buffer is full)
+ * \param[in] session - the uShell session
+ * \param[in] first - first command in the index
+ * \param[in] last - position after the last command in the index
  * \return none
  */
-static void uShellCmdUnlock(void* const cmd)
+static void uShellCmdCandidatesPrint(UShellSession_s* const session,
+                                     const size_t first,
+                                     const size_t last)
 {
+    /* Shared uShell object */
+    UShell_s* const uShell = (UShell_s*) session->shell;
+
     /* Local variables */
-    USHELL_ASSERT(cmd != NULL);
-    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
-    UShellCmd_s* uShellCmd = (UShellCmd_s*) cmd;
-    UShell_s* uShell = (UShell_s*) uShellCmd->parent;
-    UShellOsal_s* osal = (UShellOsal_s*) uShell->osal;
-    UShellOsalLockObjHandle_t lockObj = NULL;
+    char out [USHELL_BUFFER_SIZE] = {0};
+    size_t outLen = 0U;
+    size_t colWidth = 0U;
+    size_t colQty = 0U;
+    size_t nameLen = 0U;
+    size_t ind = 0U;
+    size_t pad = 0U;
+
+    /* Find the column width */
+    for (ind = first; ind < last; ind++)
+    {
+        nameLen = strlen(uShell->cmdIndex.item [ind].name);
+        colWidth = (nameLen > colWidth) ? nameLen : colWidth;
+    }
+    colWidth += 2U;
+    colQty = USHELL_TERM_WIDTH / colWidth;
+    colQty = (colQty == 0U) ? 1U : colQty;
 
-    /* Unlock */
-    do
+    /* Start from the new line */
+    out [outLen++] = '\n';
+
+    for (ind = first; ind < last; ind++)
     {
-        /* Check input parameters */
-        if ((uShellCmd == NULL) ||
-            (uShell == NULL) ||
-            (osal == NULL))
+        nameLen = strlen(uShell->cmdIndex.item [ind].name);
+
+        /* Flush if the name and the line end do not fit */
+        if ((outLen + colWidth + 1U) > sizeof(out))
         {
-            /* Invalid arguments */
-            break;
+            uShellPrintBuf(session, out, outLen);
+            outLen = 0U;
         }
 
-        /* Get the lock object */
-        osalStatus = UShellOsalLockObjHandleGet(osal,
-                                                1U,
-                                                &lockObj);
-        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
-            (lockObj == NULL))
+        /* Name */
+        memcpy(&out [outLen], uShell->cmdIndex.item [ind].name, nameLen);
+        outLen += nameLen;
+
+        /* End of the row or padding up to the next column */
+        if ((((ind - first) + 1U) % colQty == 0U) ||
+            ((ind + 1U) == last))
         {
-            /* Get lock object error */
-            USHELL_ASSERT(0);
+            out [outLen++] = '\n';
+        }
+        else
+        {
+            for (pad = nameLen; pad < colWidth; pad++)
+            {
+                out [outLen++] = ' ';
+            }
+        }
+    }
+
+    /* Write the listing */
+    uShellPrintBuf(session, out, outLen);
+}
+
+/**
+ * \brief Print the string
+ * \param[in] session - the uShell session
+ * \param[in] str - string to be printed
+ * \return none
+ */
+static void uShellPrintStr(UShellSession_s* const session,
+                           const char* const str)
+{ /* Local variable */
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
+    UShellSocket_s* socket = (UShellSocket_s*) session->vcpSessionCfg.writeSocket;
+    size_t len = strlen(str);
+    /* Print */
+    do
+    {
+        /* Check input parameter */
+        if ((session == NULL) ||
+            (str == NULL) ||
+            (socket == NULL) ||
+            (len == 0))
+        {
+            /* Invalid arguments */
             break;
         }
 
-        /* Unlock */
-        osalStatus = UShellOsalUnlock(osal, lockObj);
-        if (osalStatus != USHELL_OSAL_NO_ERR)
+        /* Print */
+        socketStatus = UShellSocketWriteBlocking(socket,
+                                                 (char*) str,
+                                                 strlen(str));
+        if (socketStatus != USHELL_SOCKET_NO_ERR)
         {
-            /* Lock error */
+            /* Print error */
             USHELL_ASSERT(0);
             break;
         }
@@ -1918,76 +5118,77 @@ static void uShellCmdUnlock(void* const cmd)
 }
 
 /**
- * \brief Io flush function
- * \param[in] uShell - uShell object
+ * \brief Print the buffer
+ * \param[in] session - the uShell session
+ * \param[in] buf - buffer to be printed
+ * \param[in] len - number of items to be printed
  * \return none
  */
-static void uShellIoFlush(UShell_s* const uShell)
+static void uShellPrintBuf(UShellSession_s* const session,
+                           const char* const buf,
+                           const size_t len)
 {
+    /* Local variable */
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
 
+    /* Print */
     do
     {
-        /* Check input parameters */
-        if (uShell == NULL)
+        /* Check input parameter */
+        if ((session == NULL) ||
+            (buf == NULL) ||
+            (session->vcpSessionCfg.writeSocket == NULL) ||
+            (len == 0))
         {
             /* Invalid arguments */
-            USHELL_ASSERT(0);
             break;
         }
 
-        /* Clear the buffer */
-        memset(uShell->io.buffer, 0, USHELL_BUFFER_SIZE);
-        uShell->io.ind = 0;
+        /* Print */
+        socketStatus = UShellSocketWriteBlocking(session->vcpSessionCfg.writeSocket,
+                                                 buf,
+                                                 len);
+        if (socketStatus != USHELL_SOCKET_NO_ERR)
+        {
+            /* Print error */
+            USHELL_ASSERT(0);
+            break;
+        }
 
     } while (0);
 }
 
 /**
- * \brief Execute the command
- * \param[in] uShell - the uShell object
+ * \brief Print the string to the output of the command job
+ * \param[in] session - the uShell session
+ * \param[in] str - string to be printed
  * \return none
  */
-static void uShellCmdCurExec(UShell_s* const uShell)
+static void uShellJobPrintStr(UShellSession_s* const session,
+                              const char* const str)
 {
-    /* Local variables */
-    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;
-    char* argv [USHELL_CMD_MAX_ARGV] = {NULL};
-    int argc = 0;
-    char* token = NULL;
+    /* Local variable */
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
 
+    /* Print */
     do
     {
-        /* Check if current command exists */
-        if ((uShell == NULL) ||
-            (uShell->currCmd == NULL))
+        /* Check input parameter */
+        if ((session == NULL) ||
+            (str == NULL) ||
+            (session->job.writeSocket == NULL))
         {
             /* Invalid arguments */
-            USHELL_ASSERT(0);
             break;
         }
 
-        /* Check we have any arg */
-        token = strtok(uShell->io.buffer, " ");
-        if (token != NULL)
-        {
-            /* Пропускаем имя команды (так как оно уже в uShell->currCmd) */
-            token = strtok(NULL, " ");
-        }
-        while ((token != NULL) && (argc < USHELL_CMD_MAX_ARGV))
-        {
-            argv [argc++] = token;
-            token = strtok(NULL, " ");
-        }
-
-        /* Execute the command */
-        cmdStatus = UShellCmdExec(uShell->currCmd,
-                                  uShell->vcpSessionCfg.readSocket,
-                                  uShell->vcpSessionCfg.writeSocket,
-                                  argc,
-                                  argv);
-        if (cmdStatus != USHELL_CMD_NO_ERR)
+        /* Print */
+        socketStatus = UShellSocketWriteBlocking(session->job.writeSocket,
+                                                 str,
+                                                 strlen(str));
+        if (socketStatus != USHELL_SOCKET_NO_ERR)
         {
-            /* Command execution error */
+            /* Print error */
             USHELL_ASSERT(0);
             break;
         }
@@ -1996,148 +5197,185 @@ static void uShellCmdCurExec(UShell_s* const uShell)
 }
 
 /**
- * \brief Auto complete the command
- * \param uShell - the uShell object
+ * \brief Render the input line on the terminal
+ * \note Only the delta between the terminal and the io buffer is sent
+ * \param[in] session - the uShell session
+ * \param[in] prompt - prompt to be printed if the line is not shown yet
  * \return none
- *
- * This function compares the current input buffer with the names of all available commands.
- * If exactly one command matches the input, it auto-completes the command in the input buffer.
- * If multiple matches are found, it prints out all matching command names.
  */
-static void uShellCmdAutoComplete(UShell_s* const uShell)
+static void uShellTermRender(UShellSession_s* const session,
+                             const char* const prompt)
 {
     /* Local variables */
-    UShellCmdErr_e cmdStatus = USHELL_CMD_NO_ERR;
-    UShellCmd_s* matches [USHELL_MAX_CMD] = {0};
-    uint8_t matchCount = 0;
-    UShellCmd_s* currCmd = (UShellCmd_s*) uShell->cmdRoot;
-    char* cmdName = NULL;
-    size_t inputLen = strlen(uShell->io.buffer);
+    UShellTerm_s* term = NULL;
+    UShellIo_s* io = NULL;
+    size_t diffInd = 0U;
 
     do
     {
         /* Check input parameters */
-        if ((uShell == NULL) ||
-            (uShell->cmdRoot == NULL) ||
-            (inputLen == 0))
+        if ((session == NULL) ||
+            (prompt == NULL))
         {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
             break;
         }
 
-        /* Find qty of matches */
-        while (currCmd != NULL)
-        {
-            /* Get name of currCmd */
-            cmdStatus = UShellCmdNameGet(currCmd, &cmdName);
-            if ((cmdStatus != USHELL_CMD_NO_ERR) ||
-                (cmdName == NULL))
-            {
-                break;
-            }
+        term = &session->term;
+        io = &session->io;
 
-            /* Check if the name matches the input string */
-            if (strncmp(uShell->io.buffer, cmdName, inputLen) == 0)
-            {
-                matches [matchCount++] = currCmd;
-            }
+        /* Print the prompt if the line is not shown yet */
+        if (term->isValid == false)
+        {
+            uShellPrintStr(session, USHELL_CLEAR_LINE);
+            uShellPrintStr(session, prompt);
+            term->ind = 0U;
+            term->cursor = 0U;
+            term->isValid = true;
+        }
 
-            /* Move to the next command */
-            cmdStatus = UShellCmdListNextGet(currCmd, &currCmd);
-            if (cmdStatus != USHELL_CMD_NO_ERR)
-            {
-                /* Move to the next command error */
-                USHELL_ASSERT(0);
-                break;
-            }
+        /* Find the first changed item */
+        while ((diffInd < term->ind) &&
+               (diffInd < io->ind) &&
+               (term->buffer [diffInd] == io->buffer [diffInd]))
+        {
+            diffInd++;
         }
 
-        if (matchCount == 1)
+        /* Check anything is changed */
+        if ((diffInd == term->ind) &&
+            (diffInd == io->ind) &&
+            (term->cursor == io->cursor))
         {
-            /* One match — auto-complete the input buffer with the full command name */
-            strcpy(uShell->io.buffer, matches [0]->name);
-            uShell->io.ind = strlen(uShell->io.buffer);
+            break;
         }
 
-        else if (matchCount > 1)
+        /* Rewrite the changed tail */
+        if ((diffInd < term->ind) ||
+            (diffInd < io->ind))
         {
-            /* Multiple matches — print them */
-            uShellPrintStr(uShell, "\n");
-            for (uint8_t i = 0; i < matchCount; i++)
-            {
-                /* Get name of current command */
-                cmdStatus = UShellCmdNameGet(matches [i], &cmdName);
-                if ((cmdStatus != USHELL_CMD_NO_ERR) ||
-                    (cmdName == NULL))
-                {
-                    /* Get name error */
-                    USHELL_ASSERT(0);
-                    break;
-                }
+            uShellTermCursorMove(session, term->cursor, diffInd);
+            uShellPrintBuf(session, &io->buffer [diffInd], io->ind - diffInd);
 
-                /* Print the command */
-                uShellPrintStr(uShell, cmdName);
-                uShellPrintStr(uShell, "\n");
+            /* Erase the rest of the old line */
+            if (term->ind > io->ind)
+            {
+                uShellPrintStr(session, USHELL_ERASE_TAIL);
             }
+
+            term->cursor = io->ind;
+        }
+
+        /* Place the cursor */
+        uShellTermCursorMove(session, term->cursor, io->cursor);
+
+        /* Remember the shown line */
+        memcpy(term->buffer, io->buffer, io->ind);
+        term->ind = io->ind;
+        term->cursor = io->cursor;
+
+    } while (0);
+}
+
+/**
+ * \brief Invalidate the terminal line (the next render prints the prompt and the whole line)
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellTermReset(UShellSession_s* const session)
+{
+    do
+    {
+        /* Check input parameters */
+        if (session == NULL)
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            break;
         }
 
+        /* Forget the shown line */
+        session->term.isValid = false;
+        session->term.ind = 0U;
+        session->term.cursor = 0U;
+
     } while (0);
 }
 
 /**
- * \brief Print the string
- * \param[in] uShell - the uShell object
- * \param[in] str - string to be printed
+ * \brief Move the terminal cursor
+ * \param[in] session - the uShell session
+ * \param[in] from - current cursor position
+ * \param[in] to - new cursor position
  * \return none
  */
-static void uShellPrintStr(UShell_s* const uShell,
-                           const char* const str)
-{ /* Local variable */
-    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
-    UShellSocket_s* socket = (UShellSocket_s*) uShell->vcpSessionCfg.writeSocket;
-    size_t len = strlen(str);
-    /* Print */
+static void uShellTermCursorMove(UShellSession_s* const session,
+                                 const size_t from,
+                                 const size_t to)
+{
+    /* Local variables */
+    char seq [16] = {0};
+    size_t steps = 0U;
+
     do
     {
-        /* Check input parameter */
-        if ((uShell == NULL) ||
-            (str == NULL) ||
-            (socket == NULL) ||
-            (len == 0))
+        /* Check input parameters */
+        if (session == NULL)
         {
             /* Invalid arguments */
+            USHELL_ASSERT(0);
             break;
         }
 
-        /* Print */
-        socketStatus = UShellSocketWriteBlocking(socket,
-                                                 (char*) str,
-                                                 strlen(str));
-        if (socketStatus != USHELL_SOCKET_NO_ERR)
+        /* Check the cursor is already in place */
+        if (from == to)
         {
-            /* Print error */
-            USHELL_ASSERT(0);
             break;
         }
 
+        /* Move right */
+        if (to > from)
+        {
+            UShellSocketFormat(seq, sizeof(seq), NULL, USHELL_CURSOR_RIGHT, (unsigned) (to - from));
+            uShellPrintStr(session, seq);
+            break;
+        }
+
+        /* Move left, a few steps are cheaper as plain backspaces */
+        steps = from - to;
+        if (steps <= USHELL_CURSOR_BACK_MAX)
+        {
+            while (steps-- > 0U)
+            {
+                seq [steps] = USHELL_CURSOR_BACK [0];
+            }
+            uShellPrintStr(session, seq);
+            break;
+        }
+
+        UShellSocketFormat(seq, sizeof(seq), NULL, USHELL_CURSOR_LEFT, (unsigned) steps);
+        uShellPrintStr(session, seq);
+
     } while (0);
 }
 
 /**
  * \brief Add cmd to history
- * \param[in] uShell - the uShell object
+ * \param[in] session - the uShell session
  * \return none
  */
-static void uShellHistoryCmdAdd(UShell_s* const uShell)
+static void uShellHistoryCmdAdd(UShellSession_s* const session)
 {
     /* Local variable */
     UShellHistoryErr_e hiStoryStatus = USHELL_HISTORY_NO_ERR;
-    UShellHistory_s* history = (UShellHistory_s*) &uShell->history;
+    UShellHistory_s* history = (UShellHistory_s*) &session->history;
 
     /* Add to history */
     do
     {
         /* Check input parameter */
-        if ((uShell == NULL) ||
+        if ((session == NULL) ||
             (history == NULL))
         {
             /* Invalid arguments */
@@ -2146,7 +5384,7 @@ static void uShellHistoryCmdAdd(UShell_s* const uShell)
         }
 
         /* Check history is enabled */
-        if (uShell->cfg.historyIsEn == false)
+        if (session->cfg.historyIsEn == false)
         {
             /* History is disabled */
             USHELL_ASSERT(0);
@@ -2154,7 +5392,7 @@ static void uShellHistoryCmdAdd(UShell_s* const uShell)
         }
 
         /* Add to history */
-        hiStoryStatus = UShellHistoryAdd(history, uShell->io.buffer);
+        hiStoryStatus = UShellHistoryAdd(history, session->io.buffer);
         USHELL_ASSERT(hiStoryStatus == USHELL_HISTORY_NO_ERR);
         if (hiStoryStatus != USHELL_HISTORY_NO_ERR)
         {
@@ -2168,23 +5406,23 @@ static void uShellHistoryCmdAdd(UShell_s* const uShell)
 
 /**
  * \brief Get previous cmd from history
- * \param[in] uShell - the uShell object
+ * \param[in] session - the uShell session
  * \return none
  */
-static void uShellHistoryPrevCmdGet(UShell_s* const uShell)
+static void uShellHistoryPrevCmdGet(UShellSession_s* const session)
 {
     /* Check inp */
-    USHELL_ASSERT(uShell != NULL);
+    USHELL_ASSERT(session != NULL);
 
     /* Local variable */
     UShellHistoryErr_e hiStoryStatus = USHELL_HISTORY_NO_ERR;
-    UShellHistory_s* history = (UShellHistory_s*) &uShell->history;
+    UShellHistory_s* history = (UShellHistory_s*) &session->history;
 
     /* Get previous cmd */
     do
     {
         /* Check input parameter */
-        if ((uShell == NULL) ||
+        if ((session == NULL) ||
             (history == NULL))
         {
             /* Invalid arguments */
@@ -2193,17 +5431,17 @@ static void uShellHistoryPrevCmdGet(UShell_s* const uShell)
         }
 
         /* Check history is enabled */
-        if (uShell->cfg.historyIsEn == false)
+        if (session->cfg.historyIsEn == false)
         {
             break;
         }
 
         /* Flush io */
-        uShellIoFlush(uShell);
+        uShellIoFlush(session);
 
         /* Get previous cmd */
         hiStoryStatus = UShellHistoryCmdPrevGet(history,
-                                                uShell->io.buffer,
+                                                session->io.buffer,
                                                 USHELL_BUFFER_SIZE);
         if (hiStoryStatus != USHELL_HISTORY_NO_ERR)
         {
@@ -2213,27 +5451,28 @@ static void uShellHistoryPrevCmdGet(UShell_s* const uShell)
         }
 
         /* Update the index */
-        uShell->io.ind = strlen(uShell->io.buffer);
+        session->io.ind = strlen(session->io.buffer);
+        session->io.cursor = session->io.ind;
 
     } while (0);
 }
 
 /**
  * \brief Get next cmd from history
- * \param[in] uShell - the uShell object
+ * \param[in] session - the uShell session
  * \return none
  */
-static void uShellHistoryNextCmdGet(UShell_s* const uShell)
+static void uShellHistoryNextCmdGet(UShellSession_s* const session)
 {
     /* Local variable */
     UShellHistoryErr_e hiStoryStatus = USHELL_HISTORY_NO_ERR;
-    UShellHistory_s* history = (UShellHistory_s*) &uShell->history;
+    UShellHistory_s* history = (UShellHistory_s*) &session->history;
 
     /* Get next cmd */
     do
     {
         /* Check input parameter */
-        if ((uShell == NULL) ||
+        if ((session == NULL) ||
             (history == NULL))
         {
             /* Invalid arguments */
@@ -2242,17 +5481,17 @@ static void uShellHistoryNextCmdGet(UShell_s* const uShell)
         }
 
         /* Check history is enabled */
-        if (uShell->cfg.historyIsEn == false)
+        if (session->cfg.historyIsEn == false)
         {
             break;
         }
 
         /* Flush io */
-        uShellIoFlush(uShell);
+        uShellIoFlush(session);
 
         /* Get next cmd */
         hiStoryStatus = UShellHistoryCmdNextGet(history,
-                                                uShell->io.buffer,
+                                                session->io.buffer,
                                                 USHELL_BUFFER_SIZE);
         if (hiStoryStatus != USHELL_HISTORY_NO_ERR)
         {
@@ -2262,7 +5501,8 @@ static void uShellHistoryNextCmdGet(UShell_s* const uShell)
         }
 
         /* Update the index */
-        uShell->io.ind = strlen(uShell->io.buffer);
+        session->io.ind = strlen(session->io.buffer);
+        session->io.cursor = session->io.ind;
 
     } while (0);
 }
@@ -2303,13 +5543,391 @@ static inline void uShellDelayMs(const UShell_s* const uShell,
     } while (0);
 }
 
+/**
+ * \brief Forward the input to the running command (up to Ctrl-C, which is left to the session)
+ * \note The raw input (USHELL_CMD_INP_RAW) goes to the command as a whole, Ctrl-C included.
+ *       The input of the command which does not read the console is typed ahead for the shell.
+ * \param[in] session - the uShell session
+ * \param[in] item - input items
+ * \param[in] qty - number of the input items
+ * \return size_t - number of the forwarded items (0 - the session takes the first item)
+ */
+static size_t uShellInpForward(UShellSession_s* const session,
+                               const UShellItem_t* const item,
+                               const size_t qty)
+{
+    /* Local variable */
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
+    size_t runLen = 0U;
+    size_t room = 0U;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (item == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Only the running command takes the input */
+        if (session->fsmState != USHELL_STATE_PROC_CMD)
+        {
+            break;
+        }
+
+        /* The raw input is data as a whole, otherwise take the run up to Ctrl-C */
+        if (session->job.inp == USHELL_CMD_INP_RAW)
+        {
+            runLen = qty;
+        }
+        else
+        {
+            while ((runLen < qty) &&
+                   (item [runLen] != USHELL_ASCII_CHAR_ETX))
+            {
+                runLen++;
+            }
+        }
+        if (runLen == 0U)
+        {
+            break;
+        }
+
+        /* The command which does not read the console leaves the run to the shell */
+        if (session->job.inp == USHELL_CMD_INP_NONE)
+        {
+            /* The session reads no more than the room, so the run fits */
+            room = USHELL_INP_TYPE_AHEAD_SIZE - session->typeAheadLen;
+            USHELL_ASSERT(runLen <= room);
+            runLen = (runLen < room) ? runLen : room;
+            memcpy(&session->typeAhead [session->typeAheadLen], item, runLen);
+            session->typeAheadLen += runLen;
+            break;
+        }
+
+        /* Write the run in one piece */
+        socketStatus = UShellSocketWrite(&session->input.writeSocket,
+                                         item,
+                                         runLen,
+                                         0U);
+        (void) socketStatus;
+
+    } while (0);
+
+    return runLen;
+}
+
+/**
+ * \brief Replay the input typed ahead to the shell (after the command which does not read the console)
+ * \note The replay stops at the next command which does not read the console, the rest waits for it.
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellInpTypeAheadProc(UShellSession_s* const session)
+{
+    /* Local variable */
+    size_t ind = 0U;
+    size_t fwdLen = 0U;
+
+    do
+    {
+        /* Check input parameters */
+        if (session == NULL)
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Process the items the way the chunk is processed, until a command leaves them to the shell again */
+        while ((ind < session->typeAheadLen) &&
+               ((session->fsmState != USHELL_STATE_PROC_CMD) ||
+                (session->job.inp != USHELL_CMD_INP_NONE)))
+        {
+            fwdLen = uShellInpForward(session,
+                                      &session->typeAhead [ind],
+                                      session->typeAheadLen - ind);
+            if (fwdLen > 0U)
+            {
+                ind += fwdLen;
+                continue;
+            }
+
+            uShellFsmProc(session, session->typeAhead [ind]);
+            ind++;
+        }
+
+        /* Ctrl-C drops the rest */
+        if (ind > session->typeAheadLen)
+        {
+            ind = session->typeAheadLen;
+        }
+
+        /* Keep the rest for the next command */
+        memmove(session->typeAhead,
+                &session->typeAhead [ind],
+                session->typeAheadLen - ind);
+        session->typeAheadLen -= ind;
+
+    } while (0);
+}
+
+/**
+ * \brief Get the number of the input items the session can take now
+ * \param[in] session - the uShell session
+ * \return size_t - number of the items (0 - the input waits until the command is done)
+ */
+static size_t uShellInpRoomGet(const UShellSession_s* const session)
+{
+    /* Local variable */
+    size_t room = USHELL_INP_CHUNK_SIZE;
+
+    do
+    {
+        /* Check input parameters */
+        if (session == NULL)
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            room = 0U;
+            break;
+        }
+
+        /* The input typed ahead of the command which does not read the console is kept for the shell */
+        if ((session->fsmState == USHELL_STATE_PROC_CMD) &&
+            (session->job.inp == USHELL_CMD_INP_NONE))
+        {
+            room = USHELL_INP_TYPE_AHEAD_SIZE - session->typeAheadLen;
+            room = (room < USHELL_INP_CHUNK_SIZE) ? room : USHELL_INP_CHUNK_SIZE;
+        }
+
+    } while (0);
+
+    return room;
+}
+
+/**
+ * \brief Callback of the read session of the vcp (the input has arrived)
+ * \param[in] owner - the uShell session
+ * \return none
+ */
+static void uShellInpCb(void* const owner)
+{
+    uShellSessionEventSet((UShellSession_s*) owner, USHELL_SESSION_EVENT_INPUT);
+}
+
+/**
+ * \brief Set the event of the session (wake the session thread up)
+ * \param[in] session - the uShell session
+ * \param[in] event - event to be set
+ * \return none
+ */
+static void uShellSessionEventSet(UShellSession_s* const session,
+                                  const UShellSessionEvent_e event)
+{
+    /* Local variable */
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->shell == NULL) ||
+            (session->event == NULL))
+        {
+            break;
+        }
+
+        /* Set the event */
+        osalStatus = UShellEventGroupSetBits((UShellOsal_s*) ((UShell_s*) session->shell)->osal,
+                                             session->event,
+                                             (UShellOsalEventGroupBits_e) event);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* Set event error */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+    } while (0);
+}
+
+/**
+ * \brief Check the command job of the session is queued or running
+ * \param[in] session - the uShell session
+ * \return bool - true if the job is busy
+ */
+static bool uShellJobIsBusy(UShellSession_s* const session)
+{
+    /* Local variable */
+    bool isBusy = false;
+
+    /* The flag is changed by the session and the worker, it is read under the lock */
+    uShellLock((UShell_s*) session->shell);
+    isBusy = session->job.isBusy;
+    uShellUnlock((UShell_s*) session->shell);
+
+    return isBusy;
+}
+
+/**
+ * \brief Report the console input lost since the previous report (the overrun counter of the read session)
+ * \param[in] session - the uShell session
+ * \return none
+ */
+static void uShellInpOverrunReport(UShellSession_s* const session)
+{
+    /* Local variables */
+    UShellVcpErr_e vcpStatus = USHELL_VCP_NO_ERR;
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
+    size_t overrun = 0U;
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (session->vcp == NULL) ||
+            (session->vcpSessionCfg.writeSocket == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            break;
+        }
+
+        /* Take the counter */
+        vcpStatus = UShellVcpSessionOverrunGet((UShellVcp_s*) session->vcp,
+                                               session->vcpSessionCfg.readParam,
+                                               &overrun);
+        if ((vcpStatus != USHELL_VCP_NO_ERR) ||
+            (overrun == session->inpOverrun))
+        {
+            break;
+        }
+
+        /* Print the lost items */
+        socketStatus = UShellSocketPrint(session->vcpSessionCfg.writeSocket,
+                                         USHELL_INP_OVERRUN_MSG,
+                                         (unsigned long) (overrun - session->inpOverrun));
+        USHELL_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);
+        (void) socketStatus;
+        session->inpOverrun = overrun;
+
+    } while (0);
+}
+
+/**
+ * \brief Wait for the input and take all available symbols
+ * \note In the event-driven mode the caller sleeps on the read socket until the input arrives,
+ *       otherwise the function returns immediately if the read socket is empty.
+ *       With no room (size 0) the input is left in the read socket and only the job done is waited for.
+ * \param[in] session - the uShell session
+ * \param[out] chunk - buffer for the received symbols
+ * \param[in] size - size of the buffer
+ * \param[out] chunkLen - number of the received symbols
+ * \return UShellSocketErr_e - error code. non-zero = no symbol was received;
+ */
+static UShellSocketErr_e uShellInpWait(UShellSession_s* const session,
+                                       UShellItem_t* const chunk,
+                                       const size_t size,
+                                       size_t* const chunkLen)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+#if (USHELL_WORKER_EVENT_DRIVEN == TRUE)
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellOsalEventGroupBits_e bits = USHELL_OSAL_EVENT_GROUP_BIT_NONE;
+#endif
+
+    do
+    {
+        /* Check input parameters */
+        if ((session == NULL) ||
+            (chunk == NULL) ||
+            (chunkLen == NULL) ||
+            (session->vcpSessionCfg.readSocket == NULL))
+        {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* No room, the input waits in the read socket until the job is done */
+        if (size == 0U)
+        {
+            *chunkLen = 0U;
+#if (USHELL_WORKER_EVENT_DRIVEN == TRUE)
+            osalStatus = UShellEventGroupBitsWait((UShellOsal_s*) ((UShell_s*) session->shell)->osal,
+                                                  session->event,
+                                                  (UShellOsalEventGroupBits_e) USHELL_SESSION_EVENT_JOB_DONE,
+                                                  &bits,
+                                                  true,
+                                                  false);
+            USHELL_ASSERT(osalStatus == USHELL_OSAL_NO_ERR);
+            (void) osalStatus;
+#endif
+            status = USHELL_SOCKET_EMPTY_ERR;
+            break;
+        }
+
+#if (USHELL_WORKER_EVENT_DRIVEN == TRUE)
+        /* Take the input which is already in the stream */
+        status = UShellSocketReadChunk(session->vcpSessionCfg.readSocket,
+                                       chunk,
+                                       size,
+                                       0U,
+                                       chunkLen);
+        if ((status == USHELL_SOCKET_NO_ERR) &&
+            (*chunkLen > 0U))
+        {
+            break;
+        }
+
+        /* Sleep until the input arrives or the job is done (the events set meanwhile are kept, so none is lost) */
+        osalStatus = UShellEventGroupBitsWait((UShellOsal_s*) ((UShell_s*) session->shell)->osal,
+                                              session->event,
+                                              USHELL_SESSION_EVENT_INPUT | USHELL_SESSION_EVENT_JOB_DONE,
+                                              &bits,
+                                              true,
+                                              false);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* Wait error */
+            USHELL_ASSERT(0);
+            status = USHELL_SOCKET_PORT_ERR;
+            break;
+        }
+
+        /* Take the input (none if only the job is done, the caller shows the new state then) */
+        status = UShellSocketReadChunk(session->vcpSessionCfg.readSocket,
+                                       chunk,
+                                       size,
+                                       0U,
+                                       chunkLen);
+#else
+        /* Check we have any input symbol */
+        status = UShellSocketReadChunk(session->vcpSessionCfg.readSocket,
+                                       chunk,
+                                       size,
+                                       0U,
+                                       chunkLen);
+#endif
+
+    } while (0);
+
+    return status;
+}
+
 /**
  * \brief Add char to the uShell
- * \param[in] uShell - the uShell object
+ * \param[in] session - the uShell session
  * \param[in] ch - char to be added
  * \return none
  */
-static void uShellIoAddChar(UShell_s* const uShell,
+static void uShellIoAddChar(UShellSession_s* const session,
                             const char ch)
 {
 
@@ -2317,15 +5935,15 @@ static void uShellIoAddChar(UShell_s* const uShell,
     do
     {
         /* Check input parameters */
-        if (uShell == NULL)
+        if (session == NULL)
         {
             /* Invalid arguments */
             USHELL_ASSERT(0);
             break;
         }
 
-        /* Check size of buffer */
-        if (uShell->io.ind >= USHELL_BUFFER_SIZE)
+        /* Check size of buffer (keep the place for the terminator) */
+        if (session->io.ind >= (USHELL_BUFFER_SIZE - 1U))
         {
             break;
         }
@@ -2337,42 +5955,84 @@ static void uShellIoAddChar(UShell_s* const uShell,
             break;
         }
 
-        /* Add char to the buffer */
-        uShell->io.buffer [uShell->io.ind++] = ch;
+        /* Insert char at the cursor */
+        memmove(&session->io.buffer [session->io.cursor + 1U],
+                &session->io.buffer [session->io.cursor],
+                session->io.ind - session->io.cursor);
+        session->io.buffer [session->io.cursor++] = ch;
+        session->io.ind++;
 
     } while (0);
 }
 
 /**
  * \brief Delete char from the uShell
- * \param[in] uShell - the uShell object
+ * \param[in] session - the uShell session
  * \param[in] ch - char to be deleted
  * \return none
  */
-static void uShellIoDelChar(UShell_s* const uShell)
+static void uShellIoDelChar(UShellSession_s* const session)
 {
     /* Check input parameters */
-    USHELL_ASSERT(uShell != NULL);
+    USHELL_ASSERT(session != NULL);
 
     /* Delete char */
     do
     {
         /* Check input parameters */
-        if (uShell == NULL)
+        if (session == NULL)
         {
             /* Invalid arguments */
             USHELL_ASSERT(0);
             break;
         }
 
-        /* Check size of buffer */
-        if (uShell->io.ind == 0U)
+        /* Check the cursor */
+        if (session->io.cursor == 0U)
+        {
+            break;
+        }
+
+        /* Delete char before the cursor */
+        memmove(&session->io.buffer [session->io.cursor - 1U],
+                &session->io.buffer [session->io.cursor],
+                session->io.ind - session->io.cursor);
+        session->io.cursor--;
+        session->io.buffer [--session->io.ind] = 0;
+
+    } while (0);
+}
+
+/**
+ * \brief Move the io cursor
+ * \param[in] session - the uShell session
+ * \param[in] toRight - true to move the cursor right, false to move it left
+ * \return none
+ */
+static void uShellIoCursorMove(UShellSession_s* const session,
+                               const bool toRight)
+{
+    do
+    {
+        /* Check input parameters */
+        if (session == NULL)
         {
+            /* Invalid arguments */
+            USHELL_ASSERT(0);
             break;
         }
 
-        /* Delete char from the buffer */
-        uShell->io.buffer [--uShell->io.ind] = 0;
+        /* Move the cursor inside the line */
+        if ((toRight == true) &&
+            (session->io.cursor < session->io.ind))
+        {
+            session->io.cursor++;
+        }
+        else if ((toRight == false) &&
+                 (session->io.cursor > 0U))
+        {
+            session->io.cursor--;
+        }
 
     } while (0);
 }
\ No newline at end of file
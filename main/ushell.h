@@ -21,6 +21,7 @@ extern "C" {
 #include "ushell_vcp.h"
 #include "ushell_cfg.h"
 #include "ushell_socket.h"
+#include "ushell_cobs.h"
 
 /*===========================================================[MACRO DEFINITIONS]============================================*/
 
@@ -28,7 +29,7 @@ extern "C" {
  * \brief The maximum number of commands in the UShell.
  */
 #ifndef USHELL_MAX_CMD
-    #define USHELL_MAX_CMD 15
+    #define USHELL_MAX_CMD 64
 #endif
 
 /**
@@ -39,10 +40,28 @@ extern "C" {
 #endif
 
 /**
- * \brief The delay time in milliseconds before starting the UShell.
+ * \brief Event-driven mode of the UShell worker.
+ * If TRUE the worker thread sleeps on the event group of the session until the input arrives or the command is done,
+ * otherwise the worker polls the read socket every USHELL_UPD_TIME_MS.
  */
-#ifndef USHELL_OSAL_START_DELAY_MS
-    #define USHELL_OSAL_START_DELAY_MS 1000U
+#ifndef USHELL_WORKER_EVENT_DRIVEN
+    #define USHELL_WORKER_EVENT_DRIVEN TRUE
+#endif
+
+/**
+ * \brief The maximum number of input symbols the UShell takes from the read socket at once.
+ */
+#ifndef USHELL_INP_CHUNK_SIZE
+    #define USHELL_INP_CHUNK_SIZE 64U
+#endif
+
+/**
+ * \brief The maximum number of sessions (consoles) served by one UShell object.
+ * \note Every session has its own thread, pipe thread, event group, tx lock and USHELL_SESSION_STREAM_BUFF_NUM stream buffers,
+ *       the OSAL limits are checked against this value below.
+ */
+#ifndef USHELL_SESSION_MAX
+    #define USHELL_SESSION_MAX 1U
 #endif
 
 /**
@@ -52,6 +71,13 @@ extern "C" {
     #define USHELL_BUFFER_SIZE 256
 #endif
 
+/**
+ * \brief The terminal width in columns (used to format the autocomplete candidates).
+ */
+#ifndef USHELL_TERM_WIDTH
+    #define USHELL_TERM_WIDTH 80U
+#endif
+
 /**
  * \brief The default password in the UShell.
  */
@@ -80,6 +106,35 @@ extern "C" {
     #define USHELL_THREAD_PRIORITY USHELL_OSAL_THREAD_PRIORITY_LOW
 #endif
 
+/**
+ * \brief The number of the command worker threads (the pool is shared by the sessions).
+ * \note USHELL_OSAL_THREADS_NUM must be not less than 2 * USHELL_SESSION_MAX + USHELL_CMD_WORKER_NUM (checked below).
+ */
+#ifndef USHELL_CMD_WORKER_NUM
+    #define USHELL_CMD_WORKER_NUM 1U
+#endif
+
+/**
+ * \brief The name of the UShell command worker thread.
+ */
+#ifndef USHELL_CMD_WORKER_THREAD_NAME
+    #define USHELL_CMD_WORKER_THREAD_NAME "USHELL_CMD"
+#endif
+
+/**
+ * \brief The stack size of the UShell command worker thread in bytes.
+ */
+#ifndef USHELL_CMD_WORKER_THREAD_STACK_SIZE_BYTE
+    #define USHELL_CMD_WORKER_THREAD_STACK_SIZE_BYTE 4096U
+#endif
+
+/**
+ * \brief The OSAL thread priority for the UShell command worker.
+ */
+#ifndef USHELL_CMD_WORKER_THREAD_PRIORITY
+    #define USHELL_CMD_WORKER_THREAD_PRIORITY USHELL_OSAL_THREAD_PRIORITY_LOW
+#endif
+
 /**
  * \brief The default prompt displayed by the UShell.
  */
@@ -122,6 +177,204 @@ extern "C" {
     #define USHELL_CMD_NOT_FOUND_MSG "Command not found \n"
 #endif
 
+/**
+ * \brief The message displayed when the command has more arguments than USHELL_CMD_MAX_ARGV.
+ */
+#ifndef USHELL_CMD_ARGS_OVERFLOW_MSG
+    #define USHELL_CMD_ARGS_OVERFLOW_MSG "Too many arguments \n"
+#endif
+
+/**
+ * \brief The message displayed when the command line has an unterminated quote.
+ */
+#ifndef USHELL_CMD_ARGS_SYNTAX_MSG
+    #define USHELL_CMD_ARGS_SYNTAX_MSG "Unterminated quote \n"
+#endif
+
+/**
+ * \brief The message displayed when the running command is interrupted by Ctrl-C.
+ * \note The job prints it to the output of the command once the command has stopped.
+ */
+#ifndef USHELL_CMD_CANCEL_MSG
+    #define USHELL_CMD_CANCEL_MSG "^C\n"
+#endif
+
+/**
+ * \brief The message displayed with the prompt when the console input was lost (the read stream was full).
+ * \note The argument is the number of the items lost since the previous message.
+ */
+#ifndef USHELL_INP_OVERRUN_MSG
+    #define USHELL_INP_OVERRUN_MSG "Input overrun: %lu items lost \n"
+#endif
+
+/**
+ * \brief The size of the pipe buffer (the output of the left command kept for the right one).
+ * \note The commands of the pipe run at once, the left command waits while the buffer is full.
+ */
+#ifndef USHELL_PIPE_BUFFER_SIZE
+    #define USHELL_PIPE_BUFFER_SIZE 256U
+#endif
+
+/**
+ * \brief The time the pipe thread waits for the output of the left command per read (the right command is done).
+ * \note The pipe thread drains the pipe until the left command is done, so the left command never waits forever.
+ */
+#ifndef USHELL_PIPE_DRAIN_TIMEOUT_MS
+    #define USHELL_PIPE_DRAIN_TIMEOUT_MS 10U
+#endif
+
+/**
+ * \brief The name of the UShell pipe thread (the right command of the pipe runs on it).
+ */
+#ifndef USHELL_PIPE_THREAD_NAME
+    #define USHELL_PIPE_THREAD_NAME "USHELL_PIPE"
+#endif
+
+/**
+ * \brief The stack size of the UShell pipe thread in bytes.
+ */
+#ifndef USHELL_PIPE_THREAD_STACK_SIZE_BYTE
+    #define USHELL_PIPE_THREAD_STACK_SIZE_BYTE USHELL_CMD_WORKER_THREAD_STACK_SIZE_BYTE
+#endif
+
+/**
+ * \brief The OSAL thread priority for the UShell pipe thread.
+ */
+#ifndef USHELL_PIPE_THREAD_PRIORITY
+    #define USHELL_PIPE_THREAD_PRIORITY USHELL_CMD_WORKER_THREAD_PRIORITY
+#endif
+
+/**
+ * \brief The size of the input buffer of the running command (the console input forwarded by the session).
+ * \note Only the command which reads the console (USHELL_CMD_INP_TEXT, USHELL_CMD_INP_RAW) gets the input.
+ *       The session does not wait for the command, the input which does not fit is dropped.
+ */
+#ifndef USHELL_CMD_INP_BUFFER_SIZE
+    #define USHELL_CMD_INP_BUFFER_SIZE 256U
+#endif
+
+/**
+ * \brief The size of the input typed ahead while the command which does not read the console runs.
+ * \note The input is replayed to the shell when the command is done (a pasted script runs line by line).
+ *       When the buffer is full, the session stops reading the console until the command is done.
+ */
+#ifndef USHELL_INP_TYPE_AHEAD_SIZE
+    #define USHELL_INP_TYPE_AHEAD_SIZE 256U
+#endif
+
+/**
+ * \brief The message displayed when the line has more than one pipe or an empty side of the pipe.
+ */
+#ifndef USHELL_CMD_PIPE_SYNTAX_MSG
+    #define USHELL_CMD_PIPE_SYNTAX_MSG "Only one pipe (cmd | cmd) is supported \n"
+#endif
+
+/**
+ * \brief The size of the block written to the sink by the redirection (cmd > file).
+ * \note Set it to the program (cache) size of the file system to write whole pages only.
+ */
+#ifndef USHELL_REDIRECT_BLOCK_SIZE
+    #define USHELL_REDIRECT_BLOCK_SIZE 256U
+#endif
+
+/**
+ * \brief The message displayed when the redirection has no file or more than one.
+ */
+#ifndef USHELL_REDIRECT_SYNTAX_MSG
+    #define USHELL_REDIRECT_SYNTAX_MSG "Usage: cmd > file or cmd >> file \n"
+#endif
+
+/**
+ * \brief The message displayed when the redirection is used, but no sink is attached.
+ */
+#ifndef USHELL_REDIRECT_NO_SINK_MSG
+    #define USHELL_REDIRECT_NO_SINK_MSG "Redirection is not supported \n"
+#endif
+
+/**
+ * \brief The message displayed when the sink can not be opened or written.
+ */
+#ifndef USHELL_REDIRECT_FAIL_MSG
+    #define USHELL_REDIRECT_FAIL_MSG "Redirection failed, the output is lost \n"
+#endif
+
+/**
+ * \brief The maximum size of the machine mode frame (decoded, without the delimiter).
+ * \note The request frame is: seq (2 bytes, LE) + command line.
+ *       The response frame is: seq (2 bytes, LE) + flags (1 byte) + status (1 byte) + output.
+ */
+#ifndef USHELL_MACHINE_FRAME_SIZE
+    #define USHELL_MACHINE_FRAME_SIZE 128U
+#endif
+
+/**
+ * \brief The number of the machine mode requests the session keeps in flight (queued or running).
+ */
+#ifndef USHELL_MACHINE_REQ_NUM
+    #define USHELL_MACHINE_REQ_NUM 4U
+#endif
+
+/**
+ * \brief The priority of the session output in the VCP tx scheduler (the higher one is served first).
+ */
+#ifndef USHELL_VCP_WRITE_PRIORITY
+    #define USHELL_VCP_WRITE_PRIORITY 0U
+#endif
+
+/**
+ * \brief The weight of the session output among the VCP write sessions of the same priority.
+ */
+#ifndef USHELL_VCP_WRITE_WEIGHT
+    #define USHELL_VCP_WRITE_WEIGHT 1U
+#endif
+
+/**
+ * \brief The size of the response frame header (seq, flags, status).
+ */
+#define USHELL_MACHINE_HEADER_SIZE 4U
+
+/**
+ * \brief The flag of the response frame: more frames of the same request follow.
+ */
+#define USHELL_MACHINE_FLAG_MORE 0x01U
+
+/**
+ * \brief The status of the response frame: the command is not found.
+ * \note The other statuses are the values of UShellCmdErr_e returned by the command.
+ */
+#define USHELL_MACHINE_STATUS_NOT_FOUND 0xFEU
+
+/**
+ * \brief The status of the response frame: the request is rejected, too many requests are in flight.
+ */
+#define USHELL_MACHINE_STATUS_BUSY 0xFFU
+
+/**
+ * \brief The number of the stream buffers of the session (pipe, input, redirection, machine mode in and out).
+ */
+#define USHELL_SESSION_STREAM_BUFF_NUM 5U
+
+/* The OSAL object slots of the UShell object: the sessions, the command workers, the uShell and cmd locks and the cmd queue */
+#if (USHELL_OSAL_THREADS_NUM < ((2U * USHELL_SESSION_MAX) + USHELL_CMD_WORKER_NUM))
+    #error "USHELL_OSAL_THREADS_NUM must be not less than 2 * USHELL_SESSION_MAX + USHELL_CMD_WORKER_NUM"
+#endif
+
+#if (USHELL_OSAL_STREAM_BUFF_SLOTS_NUM < (USHELL_SESSION_STREAM_BUFF_NUM * USHELL_SESSION_MAX))
+    #error "USHELL_OSAL_STREAM_BUFF_SLOTS_NUM must be not less than USHELL_SESSION_STREAM_BUFF_NUM * USHELL_SESSION_MAX"
+#endif
+
+#if (USHELL_OSAL_LOCK_OBJS_NUM < (2U + USHELL_SESSION_MAX))
+    #error "USHELL_OSAL_LOCK_OBJS_NUM must be not less than 2 + USHELL_SESSION_MAX"
+#endif
+
+#if (USHELL_OSAL_EVENT_GROUPS_NUM < USHELL_SESSION_MAX)
+    #error "USHELL_OSAL_EVENT_GROUPS_NUM must be not less than USHELL_SESSION_MAX"
+#endif
+
+#if (USHELL_OSAL_QUEUE_SLOTS_NUM < 1U)
+    #error "USHELL_OSAL_QUEUE_SLOTS_NUM must be not less than 1"
+#endif
+
 /*========================================================[DATA TYPES DEFINITIONS]==========================================*/
 
 /**
@@ -147,6 +400,7 @@ typedef enum
     USHELL_CMD_ERR,             ///< Exit: error - no space for command
     USHELL_XFER_ERR,            ///< Exit: error - transfer error
     USHELL_TIMEOUT_ERR,         ///< Exit: error - timeout error
+    USHELL_SESSION_ERR,         ///< Exit: error - no free session slot
 
 } UShellErr_e;
 
@@ -158,8 +412,42 @@ typedef struct
 {
     UShellItem_t buffer [USHELL_BUFFER_SIZE];    ///< Buffer for commands
     size_t ind;                                  ///< Size of the buffer
+    size_t cursor;                               ///< Cursor position in the buffer
 } UShellIo_s;
 
+/**
+ * \brief Description of the uShell terminal line object
+ * \note This object mirrors what is already shown on the terminal, so only the delta is sent on redraw
+ */
+typedef struct
+{
+    UShellItem_t buffer [USHELL_BUFFER_SIZE];    ///< Copy of the io buffer shown on the terminal
+    size_t ind;                                  ///< Number of items shown on the terminal
+    size_t cursor;                               ///< Cursor position on the terminal
+    bool isValid;                                ///< Flag to indicate the prompt and the line are shown
+} UShellTerm_s;
+
+/**
+ * \brief Description of the uShell command index item
+ * \note The item refers to the attached command or to the command defined by USHELL_CMD_DEFINE
+ */
+typedef struct
+{
+    const char* name;               ///< Name of the command
+    UShellCmd_s* cmd;               ///< Attached command (NULL for the defined one)
+    const UShellCmdDesc_s* desc;    ///< Defined command (NULL for the attached one)
+} UShellCmdIndexItem_s;
+
+/**
+ * \brief Description of the uShell command index object
+ * \note The index keeps the attached and the defined commands sorted by name, so lookup is a binary search
+ */
+typedef struct
+{
+    UShellCmdIndexItem_s item [USHELL_MAX_CMD];    ///< Commands sorted by name
+    size_t qty;                                    ///< Number of commands in the index
+} UShellCmdIndex_s;
+
 /**
  * \brief Enumeration of the uShell finite state machine states.
  *
@@ -173,6 +461,7 @@ typedef enum
     USHELL_STATE_PROC_CMD,        ///< uShell is processing command
     USHELL_STATE_PROC_ESC_SEQ,    ///< uShell is processing escape sequence
     USHELL_STATE_ERROR,           ///< uShell is in error state
+    USHELL_STATE_MACHINE,         ///< uShell is in machine mode (COBS frames, no echo, no prompt)
 } UShellFsmState_e;
 
 /**
@@ -184,6 +473,7 @@ typedef enum
     USHELL_FEATURE_AUTH = 0,    ///< Enable authentication
     USHELL_FEATURE_PROMPT,      ///< Enable prompt display
     USHELL_FEATURE_HISTORY,     ///< Enable command history
+    USHELL_FEATURE_MACHINE,     ///< Start in machine mode
 
 } UShellFeature_e;
 
@@ -199,6 +489,8 @@ typedef struct
     UShellFeature_b authIsEn;       ///< Enable authentication.
     UShellFeature_b promptIsEn;     ///< Enable prompt display.
     UShellFeature_b historyIsEn;    ///< Enable command history.
+    UShellFeature_b machineIsEn;    ///< Start in machine mode without the authentication (otherwise it is entered by the frame delimiter at the prompt).
+    size_t vcpPort;                 ///< Port of the VCP the session is served on (0 is the port given to UShellVcpInit).
 
 } UShellCfg_s;
 
@@ -214,28 +506,155 @@ typedef struct
 } UShellVcpSessionConfig_s;
 
 /**
- * \brief Description of the uShell object
+ * \brief Description of the uShell command job object
+ * \note The job is filled by the session and executed by the command worker pool.
+ */
+typedef struct
+{
+    UShellCmd_s* cmd;                             ///< Command to be executed
+    UShellCmd_s cmdProxy;                         ///< Object to execute the defined command (USHELL_CMD_DEFINE)
+    UShellCmd_s pipeCmdProxy;                     ///< Object to execute the defined pipe command
+    UShellItem_t line [USHELL_BUFFER_SIZE];       ///< Copy of the command line (argv points into it)
+    char* argv [USHELL_CMD_MAX_ARGV + 1U];        ///< Arguments (argv [0] is the command name)
+    int argc;                                     ///< Number of the arguments
+    UShellCmd_s* pipeCmd;                         ///< Command reading the output of cmd (NULL without the pipe)
+    char* pipeArgv [USHELL_CMD_MAX_ARGV + 1U];    ///< Arguments of the pipe command (argv [0] is the command name)
+    int pipeArgc;                                 ///< Number of the arguments of the pipe command
+    UShellSocket_s* pipeWriteSocket;              ///< Output of the pipe command (the console or the redirection)
+    UShellCmdErr_e pipeStatus;                    ///< Error code of the pipe command (set by the pipe thread)
+    char* redirectPath;                           ///< Path of the redirection (NULL without the redirection)
+    bool redirectIsAppend;                        ///< Flag to indicate the output is appended (cmd >> file)
+    UShellSocket_s* readSocket;                   ///< Input of the command (the console or the empty machine mode input)
+    UShellSocket_s* writeSocket;                  ///< Output of the command and the messages (the console or the response)
+    bool isMachine;                               ///< Flag to indicate the job executes the machine mode requests
+    uint16_t seq;                                 ///< Sequence id of the machine mode request
+    UShellCmdCancel_s cancel;                     ///< Cancellation token (set by Ctrl-C)
+    UShellCmdInp_e inp;                           ///< How the command takes the console input
+    bool isBusy;                                  ///< Flag to indicate the job is queued or running (changed under the uShell lock)
+
+} UShellCmdJob_s;
+
+/**
+ * \brief Description of the uShell pipe object
+ * \note The left command writes to the stream through writeSocket, the right one reads it through readSocket.
+ *       The commands of the pipe run at once: the write end waits while the stream is full, the read end waits
+ *       for the items (with the timeout of the read) until the left command is done, then it reads the stream
+ *       up to the end and fails with USHELL_SOCKET_EMPTY_ERR (the end of the input).
+ */
+typedef struct
+{
+    UShellOsalStreamBuffHandle_t stream;    ///< Pipe buffer
+    UShellSocket_s writeSocket;             ///< Write end of the pipe
+    UShellSocket_s readSocket;              ///< Read end of the pipe
+
+} UShellPipe_s;
+
+/**
+ * \brief Description of the uShell redirection object
+ * \note The command writes to the stream through socket. The write callback moves the stream to the block
+ *       and the full block is written to the sink, so the sink is written by whole blocks only.
+ */
+typedef struct
+{
+    UShellOsalStreamBuffHandle_t stream;                ///< Stream of the socket
+    UShellSocket_s socket;                              ///< Socket given to the command
+    UShellItem_t block [USHELL_REDIRECT_BLOCK_SIZE];    ///< Block for the sink
+    size_t ind;                                         ///< Number of the items in the block
+    bool isFailed;                                      ///< Flag to indicate the sink write failed
+
+} UShellRedirect_s;
+
+/**
+ * \brief Description of the uShell machine mode request
+ */
+typedef struct
+{
+    uint16_t seq;                                     ///< Sequence id of the request
+    UShellItem_t line [USHELL_MACHINE_FRAME_SIZE];    ///< Command line of the request (terminated)
+
+} UShellMachineReq_s;
+
+/**
+ * \brief Description of the uShell machine mode object
+ * \note The session thread takes the request frames and queues the requests. The command worker executes
+ *       the requests one by one, the output of the command is sent by the response frames of its request.
  */
 typedef struct
+{
+    UShellMachineReq_s req [USHELL_MACHINE_REQ_NUM];                        ///< Queued requests (ring)
+    size_t head;                                                            ///< Index of the oldest request
+    size_t qty;                                                             ///< Number of the queued requests
+    uint8_t rx [USHELL_COBS_ENCODED_SIZE(USHELL_MACHINE_FRAME_SIZE)];       ///< Request frame being received (encoded)
+    size_t rxInd;                                                           ///< Number of the received items
+    bool rxIsDropped;                                                       ///< Flag to drop the frame up to the delimiter
+    UShellOsalStreamBuffHandle_t inpStream;                                 ///< Stream of the input socket (always empty)
+    UShellSocket_s inpSocket;                                               ///< Input socket of the running request
+    UShellOsalStreamBuffHandle_t stream;                                    ///< Stream of the output socket
+    UShellSocket_s socket;                                                  ///< Output socket of the running request
+    uint8_t tx [USHELL_MACHINE_FRAME_SIZE - USHELL_MACHINE_HEADER_SIZE];    ///< Output collected for the next response frame
+    size_t txInd;                                                           ///< Number of the items in tx
+
+} UShellMachine_s;
 
+/**
+ * \brief Description of the uShell session object
+ * \note The session keeps the state of one console. All sessions of the uShell share its command registry
+ */
+typedef struct
 {
     /* Non-optional fields */
-    const void* parent;    ///< Parent object
-    const char* name;      ///< Name of the object
+    void* shell;    ///< Parent uShell object
+    size_t ind;     ///< Index of the session
+    bool used;      ///< Flag to indicate if the session is used
 
     /* Dependencies */
-    const UShellOsal_s* osal;    ///< OSAL object
-    const UShellHal_s* hal;      ///< HAL object
-    const UShellVcp_s* vcp;      ///< VCP object
+    const UShellVcp_s* vcp;    ///< VCP object
 
     /* Internal use */
     UShellFsmState_e fsmState;                 ///< Finite state machine state
     UShellCfg_s cfg;                           ///< Configuration object
-    UShellCmd_s* cmdRoot;                      ///< Commands array
     UShellHistory_s history;                   ///< History object
     UShellCmd_s* currCmd;                      ///< Current command
     UShellIo_s io;                             ///< IO object
+    UShellTerm_s term;                         ///< Terminal line object
     UShellVcpSessionConfig_s vcpSessionCfg;    ///< Session configuration object
+    UShellOsalThreadHandle_t thread;           ///< Thread of the session
+    UShellOsalThreadHandle_t pipeThread;       ///< Thread of the right command of the pipe
+    UShellOsalEventGroupHandle_t event;        ///< Events of the session (the input has arrived, the job is done)
+    UShellOsalLockObjHandle_t txLock;          ///< Lock of the response frames (the session thread and the worker both answer)
+    size_t inpOverrun;                         ///< Overrun counter of the read session already reported
+    UShellCmdJob_s job;                        ///< Command job running on the worker pool
+    UShellPipe_s pipe;                         ///< Pipe of the command job
+    UShellPipe_s input;                        ///< Input of the command job (the session writes the console input to it)
+    UShellItem_t typeAhead [USHELL_INP_TYPE_AHEAD_SIZE];    ///< Input left for the shell while the command job runs
+    size_t typeAheadLen;                       ///< Number of the items in typeAhead
+    UShellRedirect_s redirect;                 ///< Redirection of the command job
+    UShellMachine_s machine;                   ///< Machine mode object
+
+} UShellSession_s;
+
+/**
+ * \brief Description of the uShell object
+ */
+typedef struct
+
+{
+    /* Non-optional fields */
+    const void* parent;    ///< Parent object
+    const char* name;      ///< Name of the object
+
+    /* Dependencies */
+    const UShellOsal_s* osal;    ///< OSAL object
+    const UShellHal_s* hal;      ///< HAL object
+
+    /* Internal use */
+    UShellCmd_s* cmdRoot;                                          ///< Commands array (shared by the sessions)
+    UShellCmdIndex_s cmdIndex;                                     ///< Commands sorted by name (shared by the sessions)
+    UShellCmdExecStats_s cmdDescStats [USHELL_MAX_CMD];            ///< Statistics of the defined commands (in the order of the descriptor table)
+    UShellSession_s session [USHELL_SESSION_MAX];                  ///< Sessions (consoles)
+    UShellOsalQueueHandle_t cmdQueue;                              ///< Queue of the command jobs (items are sessions)
+    UShellOsalThreadHandle_t cmdWorker [USHELL_CMD_WORKER_NUM];    ///< Command worker pool
+    const UShellCmdSink_s* sink;                                   ///< Sink of the redirection (NULL if not supported)
 
 } UShell_s;
 
@@ -284,6 +703,20 @@ UShellErr_e UShellRun(UShell_s* const uShell);
  */
 UShellErr_e UShellStop(UShell_s* const uShell);
 
+/**
+ * \brief Add a session (one more console) to the uShell object
+ * \note The session shares the command registry of the uShell, but has its own io, history and state.
+ *       The session is started by UShellRun().
+ * \param[in] uShell - uShell object
+ * \param[in] vcp - vcp object of the console
+ * \param[in] cfg - configuration of the session
+ * \param[out] none
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+UShellErr_e UShellSessionAdd(UShell_s* const uShell,
+                             const UShellVcp_s* const vcp,
+                             const UShellCfg_s* const cfg);
+
 /**
  * \brief Attach command to uShell object
  * \param[in] uShell - uShell object
@@ -303,6 +736,16 @@ UShellErr_e UShellCmdAttach(UShell_s* const uShell,
 UShellErr_e UShellCmdDetach(UShell_s* const uShell,
                             const UShellCmd_s* const cmd);
 
+/**
+ * \brief Attach the sink of the redirection (cmd > file, cmd >> file) to uShell object
+ * \param[in] uShell - uShell object
+ * \param[in] sink - sink to be attached (NULL to detach)
+ * \param[out] none
+ * \return USHELL_NO_ERR if success, otherwise error code
+ */
+UShellErr_e UShellRedirectSinkAttach(UShell_s* const uShell,
+                                     const UShellCmdSink_s* const sink);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
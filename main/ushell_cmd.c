@@ -25,6 +25,12 @@
 
 //====================================================================[ INTERNAL DATA TYPES DEFINITIONS ]===========================================================================
 
+/**
+ * \brief Bounds of the section of the defined cmds (provided by the linker, NULL if no cmd is defined)
+ */
+extern const UShellCmdDesc_s __start_ushell_cmd [] __attribute__((weak));
+extern const UShellCmdDesc_s __stop_ushell_cmd [] __attribute__((weak));
+
 //===============================================================[ INTERNAL FUNCTIONS AND OBJECTS DECLARATION ]=====================================================================
 
 /**
@@ -41,6 +47,38 @@ static void uShellCmdLock(UShellCmd_s* const cmd);
  */
 static void uShellCmdUnlock(UShellCmd_s* const cmd);
 
+/**
+ * \brief Get the time for the statistics
+ * \param cmd - cmd to be measured
+ * \return uint32_t - time in milliseconds (0 without the time hook)
+ */
+static uint32_t uShellCmdTimeGet(UShellCmd_s* const cmd);
+
+/**
+ * \brief Tell the owner of the list the list is changed (e.g. the shell rebuilds its index)
+ * \param cmd - cmd of the changed list (it has the hook table of the owner)
+ * \return none
+ */
+static void uShellCmdListChanged(UShellCmd_s* const cmd);
+
+/**
+ * \brief Add the execution to the statistics of the cmd
+ * \param cmd - executed cmd
+ * \param timeMs - duration of the execution
+ * \param writeCount - number of the items written by the execution
+ * \return none
+ */
+static void uShellCmdStatsAdd(UShellCmd_s* const cmd,
+                              const uint32_t timeMs,
+                              const size_t writeCount);
+
+/**
+ * \brief Get the record of the statistics of the cmd
+ * \param cmd - UShellCmd obj
+ * \return UShellCmdExecStats_s* - the outside record if it is set, the record of the object otherwise
+ */
+static UShellCmdExecStats_s* uShellCmdStatsRecordGet(UShellCmd_s* const cmd);
+
 //=======================================================================[ PUBLIC INTERFACE FUNCTIONS ]=============================================================================
 
 /**
@@ -176,6 +214,36 @@ UShellCmdErr_e UShellCmdHookTableSet(UShellCmd_s* const cmd,
     return status;
 }
 
+/**
+ * \brief Set the way the cmd takes the console input while it runs
+ * \param[in] cmd - the cmd to be set
+ * \param[in] inp - the way (USHELL_CMD_INP_...)
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdInpSet(UShellCmd_s* const cmd,
+                               const UShellCmdInp_e inp)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+
+    do
+    {
+        /* Check input parameter */
+        if ((NULL == cmd) ||
+            (inp > USHELL_CMD_INP_RAW))
+        {
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Set the way */
+        cmd->inp = inp;
+
+    } while (0);
+
+    return status;
+}
+
 /**
  * \brief Execute the cmd
  * \param[in] cmd - UShellCmd obj to be executed
@@ -183,16 +251,20 @@ UShellCmdErr_e UShellCmdHookTableSet(UShellCmd_s* const cmd,
  * \param[in] writeSocket - socket to write to
  * \param[in] argc - number of arguments
  * \param[in] argv - array of arguments
+ * \param[in] cancel - cancellation token (may be NULL if the command can not be canceled)
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 UShellCmdErr_e UShellCmdExec(UShellCmd_s* const cmd,
                              UShellSocket_s* const readSocket,
                              UShellSocket_s* const writeSocket,
                              const int argc,
-                             char* const argv [])
+                             char* const argv [],
+                             const UShellCmdCancel_s* const cancel)
 {
     /* Local variable */
     UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+    uint32_t startTime = 0U;
+    size_t startWriteCount = 0U;
 
     do
     {
@@ -204,23 +276,479 @@ UShellCmdErr_e UShellCmdExec(UShellCmd_s* const cmd,
             break;
         }
 
-        /* lock the cmd */
+        /* Take the marks for the statistics */
+        startWriteCount = (writeSocket != NULL) ? writeSocket->writeCount : 0U;
+        startTime = uShellCmdTimeGet(cmd);
+
+        /* Execute the cmd (not under the lock: the sessions run their cmds in parallel,
+           a cmd with a shared state guards it itself) */
+        status = cmd->execFunc(cmd, readSocket, writeSocket, argc, argv, cancel);
+
+        /* Account the execution (the failed one too) */
         uShellCmdLock(cmd);
+        uShellCmdStatsAdd(cmd,
+                          uShellCmdTimeGet(cmd) - startTime,
+                          (writeSocket != NULL) ? (writeSocket->writeCount - startWriteCount) : 0U);
+        uShellCmdUnlock(cmd);
 
-        /* Thread safety */
-        do
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Find the cmd by name the way the shell of the cmd does (the attached and the defined cmds)
+ * \note The defined cmd is made in the proxy, the proxy has to live while the found cmd is used.
+ * \param[in] cmd - UShellCmd obj which looks for (attached to the shell)
+ * \param[in] name - name of the cmd to be found
+ * \param[in] proxy - object to be filled for the defined cmd
+ * \param[out] found - found cmd (NULL if there is no such cmd)
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred (USHELL_CMD_NOT_INIT_ERR - no lookup hook);
+ */
+UShellCmdErr_e UShellCmdFind(UShellCmd_s* const cmd,
+                             const char* const name,
+                             UShellCmd_s* const proxy,
+                             UShellCmd_s** const found)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+
+    do
+    {
+        /* Check input parameter */
+        if ((NULL == cmd) ||
+            (NULL == name) ||
+            (NULL == proxy) ||
+            (NULL == found))
+        {
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* The lookup is provided by the shell */
+        *found = NULL;
+        if ((cmd->hook == NULL) ||
+            (cmd->hook->find == NULL))
+        {
+            status = USHELL_CMD_NOT_INIT_ERR;
+            break;
+        }
+
+        *found = cmd->hook->find(cmd, name, proxy);
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Get the table of the cmds defined by USHELL_CMD_DEFINE
+ * \param[out] table - first descriptor of the table (NULL if no cmd is defined)
+ * \param[out] qty - number of the descriptors
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdDescTableGet(const UShellCmdDesc_s** const table,
+                                     size_t* const qty)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+
+    do
+    {
+        /* Check input parameter */
+        if ((NULL == table) ||
+            (NULL == qty))
+        {
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Take the bounds of the section */
+        *table = NULL;
+        *qty = 0U;
+        if ((__start_ushell_cmd == NULL) ||
+            (__stop_ushell_cmd == NULL))
+        {
+            break;
+        }
+
+        *table = __start_ushell_cmd;
+        *qty = (size_t) (__stop_ushell_cmd - __start_ushell_cmd);
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Clear the execution statistics of the cmd
+ * \param[in] cmd - UShellCmd obj
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdExecStatsReset(UShellCmd_s* const cmd)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+
+    do
+    {
+        /* Check input parameter */
+        if (NULL == cmd)
+        {
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Clear the record */
+        uShellCmdLock(cmd);
+        memset(uShellCmdStatsRecordGet(cmd), 0, sizeof(UShellCmdExecStats_s));
+        uShellCmdUnlock(cmd);
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Take a copy of the execution statistics of the cmd
+ * \param[in] cmd - UShellCmd obj
+ * \param[out] stats - copy of the record
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdExecStatsGet(UShellCmd_s* const cmd,
+                                     UShellCmdExecStats_s* const stats)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+
+    do
+    {
+        /* Check input parameter */
+        if ((NULL == cmd) ||
+            (NULL == stats))
+        {
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Copy the record */
+        uShellCmdLock(cmd);
+        *stats = *uShellCmdStatsRecordGet(cmd);
+        uShellCmdUnlock(cmd);
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Keep the execution statistics of the cmd in the given record
+ * \note It is used for the proxy of the defined cmd, so the record outlives the proxy.
+ * \param[in] cmd - UShellCmd obj
+ * \param[in] record - record of the statistics (NULL - the record of the object)
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdExecStatsRecordSet(UShellCmd_s* const cmd,
+                                           UShellCmdExecStats_s* const record)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+
+    do
+    {
+        /* Check input parameter */
+        if (NULL == cmd)
         {
-            /* Execute the cmd */
-            status = cmd->execFunc(cmd, readSocket, writeSocket, argc, argv);
-            if (status != USHELL_CMD_NO_ERR)
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Set the record */
+        cmd->record = record;
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Estimate the percentile of the cmd duration by the histogram
+ * \note The result is the upper bound of the bucket holding the percentile (limited by the maximum).
+ * \param[in] cmd - UShellCmd obj
+ * \param[in] percent - percentile (1 ... 100)
+ * \param[out] timeMs - duration (0 if the cmd was not executed)
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdExecStatsPercentileGet(const UShellCmd_s* const cmd,
+                                               const uint32_t percent,
+                                               uint32_t* const timeMs)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+    const UShellCmdExecStats_s* stats = NULL;
+    uint64_t rank = 0U;
+    uint64_t sum = 0U;
+    size_t ind = 0U;
+
+    do
+    {
+        /* Check input parameter */
+        if ((NULL == cmd) ||
+            (NULL == timeMs) ||
+            (percent == 0U) ||
+            (percent > 100U))
+        {
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        *timeMs = 0U;
+        stats = uShellCmdStatsRecordGet((UShellCmd_s*) cmd);
+        if (stats->count == 0U)
+        {
+            break;
+        }
+
+        /* Find the bucket of the execution with the rank (rounded up) */
+        rank = (((uint64_t) stats->count * percent) + 99U) / 100U;
+        for (ind = 0U; ind < USHELL_CMD_STATS_BUCKET_NUM; ind++)
+        {
+            sum += stats->bucket [ind];
+            if (sum >= rank)
             {
                 break;
             }
+        }
 
-        } while (0);
+        /* Take the upper bound of the bucket (the last one is bounded by the maximum only) */
+        *timeMs = stats->timeMax;
+        if (ind == 0U)
+        {
+            *timeMs = 0U;
+        }
+        else if ((ind < (USHELL_CMD_STATS_BUCKET_NUM - 1U)) &&
+                 (ind < 32U) &&
+                 (((1UL << ind) - 1U) < *timeMs))
+        {
+            *timeMs = (uint32_t) ((1UL << ind) - 1U);
+        }
 
-        /* unlock the cmd */
-        uShellCmdUnlock(cmd);
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Check the command has to stop
+ * \param[in] cancel - cancellation token passed to the exec function
+ * \return true if the execution was canceled, false otherwise (or if the token is NULL)
+ */
+bool UShellCmdIsCanceled(const UShellCmdCancel_s* const cancel)
+{
+    return ((cancel != NULL) &&
+            (cancel->isCanceled == true));
+}
+
+/**
+ * \brief Split the command line into arguments in place (reentrant, no copy)
+ * \note Arguments are separated by spaces or tabs. Single and double quotes group the items
+ *       (the quotes are removed), a backslash escapes the next item outside of single quotes.
+ *       The line is modified: argv points into the line and every argument is terminated.
+ * \param[in,out] line - command line (terminated string)
+ * \param[out] argv - array of the arguments
+ * \param[in] argvSize - size of the argv array
+ * \param[out] argc - number of the arguments
+ * \return UShellCmdErr_e - error code. USHELL_CMD_EXECUTE_NUMB_ARGS_ERR if argv is too small,
+ *         USHELL_CMD_ARGS_SYNTAX_ERR if a quote is not terminated;
+ */
+UShellCmdErr_e UShellCmdArgsParse(char* const line,
+                                  char* argv [],
+                                  const size_t argvSize,
+                                  int* const argc)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+    char* rd = line;
+    char* wr = line;
+    char quote = '\0';
+    char ch = '\0';
+    size_t qty = 0U;
+
+    do
+    {
+        /* Check input parameter */
+        if ((line == NULL) ||
+            (argv == NULL) ||
+            (argc == NULL))
+        {
+            USHELL_CMD_ASSERT(0);
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* One pass: rd reads the line, wr writes the unquoted items back (wr never passes rd) */
+        while (status == USHELL_CMD_NO_ERR)
+        {
+            /* Skip the separators */
+            while ((*rd == ' ') || (*rd == '\t'))
+            {
+                rd++;
+            }
+
+            /* Check the end of the line */
+            if (*rd == '\0')
+            {
+                break;
+            }
+
+            /* Check we have space for one more argument */
+            if (qty >= argvSize)
+            {
+                status = USHELL_CMD_EXECUTE_NUMB_ARGS_ERR;
+                break;
+            }
+
+            /* Start the argument */
+            argv [qty++] = wr;
+
+            /* Collect the argument */
+            for (; *rd != '\0'; rd++)
+            {
+                ch = *rd;
+
+                if (quote != '\0')
+                {
+                    /* Close the quote */
+                    if (ch == quote)
+                    {
+                        quote = '\0';
+                        continue;
+                    }
+
+                    /* Escape inside double quotes */
+                    if ((quote == '"') &&
+                        (ch == '\\') &&
+                        ((rd [1] == '"') || (rd [1] == '\\')))
+                    {
+                        ch = *(++rd);
+                    }
+                }
+                else
+                {
+                    /* End of the argument */
+                    if ((ch == ' ') || (ch == '\t'))
+                    {
+                        break;
+                    }
+
+                    /* Open the quote */
+                    if ((ch == '"') || (ch == '\''))
+                    {
+                        quote = ch;
+                        continue;
+                    }
+
+                    /* Escape the next item */
+                    if ((ch == '\\') && (rd [1] != '\0'))
+                    {
+                        ch = *(++rd);
+                    }
+                }
+
+                *wr++ = ch;
+            }
+
+            /* Check the quote is closed */
+            if (quote != '\0')
+            {
+                status = USHELL_CMD_ARGS_SYNTAX_ERR;
+                break;
+            }
+
+            /* Step over the separator before the terminator is written in its place */
+            if (*rd != '\0')
+            {
+                rd++;
+            }
+
+            /* Terminate the argument */
+            *wr++ = '\0';
+        }
+
+        /* Set the result */
+        *argc = (int) qty;
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Split the command line at the first separator outside of quotes (e.g. a pipe)
+ * \note The quotes and the escapes are the ones of UShellCmdArgsParse(), they stay in both parts.
+ *       The separator is replaced by the terminator, so the line holds only the first part.
+ * \param[in,out] line - command line (terminated string)
+ * \param[in] sep - separator
+ * \param[out] rest - the part after the separator, NULL if the line has no separator
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdLineSplit(char* const line,
+                                  const char sep,
+                                  char** const rest)
+{
+    /* Local variable */
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+    char quote = '\0';
+
+    do
+    {
+        /* Check input parameter */
+        if ((line == NULL) ||
+            (rest == NULL))
+        {
+            USHELL_CMD_ASSERT(0);
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        *rest = NULL;
+
+        /* Find the separator, skip the quoted and the escaped items */
+        for (char* rd = line; *rd != '\0'; rd++)
+        {
+            if (quote != '\0')
+            {
+                /* Close the quote */
+                if (*rd == quote)
+                {
+                    quote = '\0';
+                }
+                /* Escape inside double quotes */
+                else if ((quote == '"') &&
+                         (*rd == '\\') &&
+                         ((rd [1] == '"') || (rd [1] == '\\')))
+                {
+                    rd++;
+                }
+            }
+            else if ((*rd == '"') || (*rd == '\''))
+            {
+                /* Open the quote */
+                quote = *rd;
+            }
+            else if ((*rd == '\\') && (rd [1] != '\0'))
+            {
+                /* Escape the next item */
+                rd++;
+            }
+            else if (*rd == sep)
+            {
+                /* Cut the line */
+                *rd = '\0';
+                *rest = rd + 1;
+                break;
+            }
+        }
 
     } while (0);
 
@@ -342,6 +870,64 @@ UShellCmdErr_e UShellCmdListAdd(UShellCmd_s* const cmdRoot,
         /* Unlock the command list */
         uShellCmdUnlock(cmdRoot);
 
+        /* The owner of the list takes the new cmd */
+        if (USHELL_CMD_NO_ERR == status)
+        {
+            uShellCmdListChanged(cmdRoot);
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Find cmd in the list by name
+ * \param[in] cmdRoot - the root of the list
+ * \param[in] name - name of the cmd (terminated string)
+ * \param[out] cmd - the cmd found (NULL if there is no such cmd)
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdListFind(UShellCmd_s* const cmdRoot,
+                                 const char* const name,
+                                 UShellCmd_s** const cmd)
+{
+    UShellCmdErr_e status = USHELL_CMD_NO_ERR;
+    UShellCmd_s* currCmd = cmdRoot;
+
+    do
+    {
+        if ((NULL == cmdRoot) ||
+            (NULL == name) ||
+            (NULL == cmd))
+        {
+            status = USHELL_CMD_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Nothing found yet */
+        *cmd = NULL;
+
+        /* Lock the command list */
+        uShellCmdLock(cmdRoot);
+
+        /* Thread safe */
+        while (currCmd != NULL)
+        {
+            if ((currCmd->name != NULL) &&
+                (strcmp(currCmd->name, name) == 0))
+            {
+                *cmd = currCmd;
+                break;
+            }
+
+            /* Move to the next cmd */
+            currCmd = currCmd->next;
+        }
+
+        /* Unlock the command list */
+        uShellCmdUnlock(cmdRoot);
+
     } while (0);
 
     return status;
@@ -401,6 +987,12 @@ UShellCmdErr_e UShellCmdListRemove(UShellCmd_s** const cmdRoot, UShellCmd_s* con
         /* Unlock the command list */
         uShellCmdUnlock(*cmdRoot);
 
+        /* The owner of the list drops the removed cmd (the removed cmd still has its hook table) */
+        if (current != NULL)
+        {
+            uShellCmdListChanged(cmd);
+        }
+
     } while (0);
 
     return status;
@@ -565,4 +1157,123 @@ static void uShellCmdUnlock(UShellCmd_s* const cmd)
         cmd->hook->unlock(cmd);
 
     } while (0);
+}
+
+/**
+ * \brief Get the time for the statistics
+ * \param cmd - cmd to be measured
+ * \return uint32_t - time in milliseconds (0 without the time hook)
+ */
+static uint32_t uShellCmdTimeGet(UShellCmd_s* const cmd)
+{
+    /* Local variable */
+    uint32_t timeMs = 0U;
+
+    do
+    {
+        /* Check hook table */
+        if ((cmd == NULL) ||
+            (cmd->hook == NULL) ||
+            (cmd->hook->timeGet == NULL))
+        {
+            break;
+        }
+
+        /* Get the time */
+        timeMs = cmd->hook->timeGet(cmd);
+
+    } while (0);
+
+    return timeMs;
+}
+
+/**
+ * \brief Tell the owner of the list the list is changed (e.g. the shell rebuilds its index)
+ * \param cmd - cmd of the changed list (it has the hook table of the owner)
+ * \return none
+ */
+static void uShellCmdListChanged(UShellCmd_s* const cmd)
+{
+    do
+    {
+        /* Check input parameter */
+        if (cmd == NULL)
+        {
+            break;
+        }
+
+        /* Check hook table (the list is not owned yet) */
+        if ((cmd->hook == NULL) ||
+            (cmd->hook->listChanged == NULL))
+        {
+            break;
+        }
+
+        /* Notify the owner */
+        cmd->hook->listChanged(cmd);
+
+    } while (0);
+}
+
+/**
+ * \brief Add the execution to the statistics of the cmd
+ * \param cmd - executed cmd
+ * \param timeMs - duration of the execution
+ * \param writeCount - number of the items written by the execution
+ * \return none
+ */
+static void uShellCmdStatsAdd(UShellCmd_s* const cmd,
+                              const uint32_t timeMs,
+                              const size_t writeCount)
+{
+    /* Local variable */
+    UShellCmdExecStats_s* stats = NULL;
+    uint32_t rest = timeMs;
+    size_t ind = 0U;
+
+    do
+    {
+        /* Check input parameter */
+        if (cmd == NULL)
+        {
+            break;
+        }
+        stats = uShellCmdStatsRecordGet(cmd);
+
+        /* Update the limits */
+        if ((stats->count == 0U) ||
+            (timeMs < stats->timeMin))
+        {
+            stats->timeMin = timeMs;
+        }
+        if (timeMs > stats->timeMax)
+        {
+            stats->timeMax = timeMs;
+        }
+
+        /* Update the sums */
+        stats->count++;
+        stats->timeSum += timeMs;
+        stats->writeSum += writeCount;
+
+        /* The bucket is the number of the significant bits of the duration */
+        while ((rest > 0U) &&
+               (ind < (USHELL_CMD_STATS_BUCKET_NUM - 1U)))
+        {
+            rest >>= 1U;
+            ind++;
+        }
+        stats->bucket [ind]++;
+
+    } while (0);
+}
+
+/**
+ * \brief Get the record of the statistics of the cmd
+ * \param cmd - UShellCmd obj
+ * \return UShellCmdExecStats_s* - the outside record if it is set, the record of the object otherwise
+ */
+static UShellCmdExecStats_s* uShellCmdStatsRecordGet(UShellCmd_s* const cmd)
+{
+    return (cmd->record != NULL) ? cmd->record : &cmd->stats;
 }
\ No newline at end of file
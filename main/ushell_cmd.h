@@ -27,6 +27,30 @@ extern "C" {
     #define USHELL_CMD_MAX_ARGV 5
 #endif
 
+/**
+ * \brief The number of the buckets of the command duration histogram.
+ * Bucket 0 holds 0 ms, bucket n holds [2^(n-1), 2^n) ms, the last one holds the rest.
+ */
+#ifndef USHELL_CMD_STATS_BUCKET_NUM
+    #define USHELL_CMD_STATS_BUCKET_NUM 16U
+#endif
+
+/**
+ * \brief Define a command at build time (no UShellCmd_s object, no registration).
+ * The constant descriptor is placed into the "ushell_cmd" linker section, the shell indexes the section on init.
+ * The name is a C identifier, so the GNU linker provides the bounds of the section by itself
+ * (a linker script which drops the unused sections has to KEEP(*(ushell_cmd))).
+ * \param cmdName - name of the command (identifier, e.g. reboot)
+ * \param cmdHelp - help string
+ * \param cmdFunc - function to be executed (UShellCmdExec_f)
+ */
+#define USHELL_CMD_DEFINE(cmdName, cmdHelp, cmdFunc)                                 \
+    static const UShellCmdDesc_s uShellCmdDesc_##cmdName                             \
+        __attribute__((used, section("ushell_cmd"), aligned(sizeof(void*)))) = {     \
+            .name = #cmdName,                                                        \
+            .help = cmdHelp,                                                         \
+            .execFunc = cmdFunc}
+
 /*========================================================[DATA TYPES DEFINITIONS]==========================================*/
 
 /**
@@ -40,6 +64,8 @@ typedef enum
     USHELL_CMD_PORT_ERR,                 ///< Exit: error - port error (e.g. port layer error)
     USHELL_CMD_EXECUTE_NUMB_ARGS_ERR,    ///< Exit: error - number of arguments error
     USHELL_CMD_ALREADY_EXISTS_ERR,       ///< Exit: error - command already exists
+    USHELL_CMD_ARGS_SYNTAX_ERR,          ///< Exit: error - arguments syntax error (e.g. unterminated quote)
+    USHELL_CMD_CANCELED_ERR,             ///< Exit: error - execution was canceled (e.g. Ctrl-C)
 
 } UShellCmdErr_e;
 
@@ -58,6 +84,42 @@ typedef char* UShellCmdName_t;
  */
 typedef char UShellCmdItem_t;
 
+/**
+ * \brief Describe a cmd cancellation token.
+ * \note The token is set by the shell (e.g. Ctrl-C) while the command is running.
+ *       A long command has to poll it by UShellCmdIsCanceled() and return USHELL_CMD_CANCELED_ERR.
+ */
+typedef struct
+{
+    volatile bool isCanceled;    ///< Flag to indicate the command has to stop
+
+} UShellCmdCancel_s;
+
+/**
+ * \brief Describe how a cmd takes the console input while it runs.
+ */
+typedef enum
+{
+    USHELL_CMD_INP_NONE = 0,    ///< The cmd does not read the console (the input waits for the shell, Ctrl-C cancels the cmd)
+    USHELL_CMD_INP_TEXT,        ///< The cmd reads the typed text (Ctrl-C cancels the cmd and is not passed to it)
+    USHELL_CMD_INP_RAW,         ///< The cmd reads the binary stream, e.g. XModem (every item is passed, Ctrl-C is data)
+
+} UShellCmdInp_e;
+
+/**
+ * \brief Describe an output sink (e.g. a file for "cmd > file").
+ * \note The sink is provided by a command module (e.g. the file system one) and used by the shell.
+ *       The shell writes whole blocks and calls close once per open.
+ */
+typedef struct
+{
+    void* parent;                                                                               ///< Owner of the sink
+    UShellCmdErr_e (*open)(void* const parent, const char* const path, const bool isAppend);    ///< Open the sink
+    UShellCmdErr_e (*write)(void* const parent, const char* const data, const size_t size);     ///< Write a block
+    UShellCmdErr_e (*close)(void* const parent);                                                ///< Flush and close the sink
+
+} UShellCmdSink_s;
+
 /**
  * \brief Describe a cmd exec function.
  */
@@ -65,18 +127,49 @@ typedef UShellCmdErr_e(UShellCmdExec_f)(void* const cmd,
                                         UShellSocket_s* const readSocket,
                                         UShellSocket_s* const writeSocket,
                                         const int argc,
-                                        char* const argv []);
+                                        char* const argv [],
+                                        const UShellCmdCancel_s* const cancel);
 
 /**
  * \brief Describe a cmd hook function.
  */
 typedef struct
 {
-    void (*lock)(void* const cmd);      ///< Pointer to the lock function
-    void (*unlock)(void* const cmd);    ///< Pointer to the unlock function
+    void (*lock)(void* const cmd);           ///< Pointer to the lock function
+    void (*unlock)(void* const cmd);         ///< Pointer to the unlock function
+    uint32_t (*timeGet)(void* const cmd);    ///< Pointer to the time function (ms, used by the statistics)
+    struct UShellCmd_t* (*find)(void* const cmd, const char* const name, struct UShellCmd_t* const proxy);    ///< Pointer to the lookup function (the defined cmd is made in the proxy)
+    void (*listChanged)(void* const cmd);    ///< Pointer to the function called after a cmd is added to or removed from the list of the cmd
 
 } UShellCmdHookTable_s;
 
+/**
+ * \brief Describe a cmd defined at build time (see USHELL_CMD_DEFINE).
+ * \note The shell executes it through a UShellCmd_s made from the descriptor, the exec function gets that object.
+ */
+typedef struct
+{
+    const char* name;             ///< Name of the command
+    const char* help;             ///< Help string
+    UShellCmdExec_f* execFunc;    ///< Function to be executed
+
+} UShellCmdDesc_s;
+
+/**
+ * \brief Describe the execution statistics of a cmd.
+ * \note The record has a fixed size and is updated by UShellCmdExec() under the cmd lock.
+ */
+typedef struct
+{
+    uint32_t count;                                  ///< Number of the executions
+    uint32_t timeMin;                                ///< Minimal duration (ms)
+    uint32_t timeMax;                                ///< Maximal duration (ms)
+    uint64_t timeSum;                                ///< Sum of the durations (ms)
+    uint64_t writeSum;                               ///< Number of the items written to the write socket
+    uint32_t bucket [USHELL_CMD_STATS_BUCKET_NUM];    ///< Histogram of the durations (for the percentiles)
+
+} UShellCmdExecStats_s;
+
 /**
  * \brief Describe UShellCmd.
  */
@@ -89,6 +182,9 @@ typedef struct UShellCmd_t
     UShellCmdExec_f* execFunc;     ///< Pointer to the function to be executed
     struct UShellCmd_t* next;      ///< Pointer to the next command in the list
     UShellCmdHookTable_s* hook;    ///< Pointer to the hook table
+    UShellCmdExecStats_s stats;    ///< Execution statistics
+    UShellCmdExecStats_s* record;  ///< Execution statistics kept outside of the object (the proxy of the defined cmd), NULL - stats
+    UShellCmdInp_e inp;            ///< How the cmd takes the console input (USHELL_CMD_INP_NONE after the init)
 
 } UShellCmd_s;
 
@@ -134,6 +230,15 @@ UShellCmdErr_e UShellCmdParentSet(UShellCmd_s* const cmd,
 UShellCmdErr_e UShellCmdHookTableSet(UShellCmd_s* const cmd,
                                      UShellCmdHookTable_s* const hook);
 
+/**
+ * \brief Set the way the cmd takes the console input while it runs
+ * \param[in] cmd - the cmd to be set
+ * \param[in] inp - the way (USHELL_CMD_INP_...)
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdInpSet(UShellCmd_s* const cmd,
+                               const UShellCmdInp_e inp);
+
 /**
  * \brief Execute the cmd
  * \param[in] cmd - UShellCmd obj to be executed
@@ -141,13 +246,114 @@ UShellCmdErr_e UShellCmdHookTableSet(UShellCmd_s* const cmd,
  * \param[in] writeSocket - socket to write to
  * \param[in] argc - number of arguments
  * \param[in] argv - array of arguments
+ * \param[in] cancel - cancellation token (may be NULL if the command can not be canceled)
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 UShellCmdErr_e UShellCmdExec(UShellCmd_s* const cmd,
                              UShellSocket_s* const readSocket,
                              UShellSocket_s* const writeSocket,
                              const int argc,
-                             char* const argv []);
+                             char* const argv [],
+                             const UShellCmdCancel_s* const cancel);
+
+/**
+ * \brief Find the cmd by name the way the shell of the cmd does (the attached and the defined cmds)
+ * \note The defined cmd is made in the proxy, the proxy has to live while the found cmd is used.
+ * \param[in] cmd - UShellCmd obj which looks for (attached to the shell)
+ * \param[in] name - name of the cmd to be found
+ * \param[in] proxy - object to be filled for the defined cmd
+ * \param[out] found - found cmd (NULL if there is no such cmd)
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred (USHELL_CMD_NOT_INIT_ERR - no lookup hook);
+ */
+UShellCmdErr_e UShellCmdFind(UShellCmd_s* const cmd,
+                             const char* const name,
+                             UShellCmd_s* const proxy,
+                             UShellCmd_s** const found);
+
+/**
+ * \brief Get the table of the cmds defined by USHELL_CMD_DEFINE
+ * \param[out] table - first descriptor of the table (NULL if no cmd is defined)
+ * \param[out] qty - number of the descriptors
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdDescTableGet(const UShellCmdDesc_s** const table,
+                                     size_t* const qty);
+
+/**
+ * \brief Clear the execution statistics of the cmd
+ * \param[in] cmd - UShellCmd obj
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdExecStatsReset(UShellCmd_s* const cmd);
+
+/**
+ * \brief Take a copy of the execution statistics of the cmd
+ * \note The copy is taken under the cmd lock, so it is consistent while the cmd runs in other sessions.
+ * \param[in] cmd - UShellCmd obj
+ * \param[out] stats - copy of the record
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdExecStatsGet(UShellCmd_s* const cmd,
+                                     UShellCmdExecStats_s* const stats);
+
+/**
+ * \brief Keep the execution statistics of the cmd in the given record
+ * \note It is used for the proxy of the defined cmd, so the record outlives the proxy.
+ * \param[in] cmd - UShellCmd obj
+ * \param[in] record - record of the statistics (NULL - the record of the object)
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdExecStatsRecordSet(UShellCmd_s* const cmd,
+                                           UShellCmdExecStats_s* const record);
+
+/**
+ * \brief Estimate the percentile of the cmd duration by the histogram
+ * \note The result is the upper bound of the bucket holding the percentile (limited by the maximum).
+ * \param[in] cmd - UShellCmd obj
+ * \param[in] percent - percentile (1 ... 100)
+ * \param[out] timeMs - duration (0 if the cmd was not executed)
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdExecStatsPercentileGet(const UShellCmd_s* const cmd,
+                                               const uint32_t percent,
+                                               uint32_t* const timeMs);
+
+/**
+ * \brief Check the command has to stop
+ * \param[in] cancel - cancellation token passed to the exec function
+ * \return true if the execution was canceled, false otherwise (or if the token is NULL)
+ */
+bool UShellCmdIsCanceled(const UShellCmdCancel_s* const cancel);
+
+/**
+ * \brief Split the command line into arguments in place (reentrant, no copy)
+ * \note Arguments are separated by spaces or tabs. Single and double quotes group the items
+ *       (the quotes are removed), a backslash escapes the next item outside of single quotes.
+ *       The line is modified: argv points into the line and every argument is terminated.
+ * \param[in,out] line - command line (terminated string)
+ * \param[out] argv - array of the arguments
+ * \param[in] argvSize - size of the argv array
+ * \param[out] argc - number of the arguments
+ * \return UShellCmdErr_e - error code. USHELL_CMD_EXECUTE_NUMB_ARGS_ERR if argv is too small,
+ *         USHELL_CMD_ARGS_SYNTAX_ERR if a quote is not terminated;
+ */
+UShellCmdErr_e UShellCmdArgsParse(char* const line,
+                                  char* argv [],
+                                  const size_t argvSize,
+                                  int* const argc);
+
+/**
+ * \brief Split the command line at the first separator outside of quotes (e.g. a pipe)
+ * \note The quotes and the escapes are the ones of UShellCmdArgsParse(), they stay in both parts.
+ *       The separator is replaced by the terminator, so the line holds only the first part.
+ * \param[in,out] line - command line (terminated string)
+ * \param[in] sep - separator
+ * \param[out] rest - the part after the separator, NULL if the line has no separator
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdLineSplit(char* const line,
+                                  const char sep,
+                                  char** const rest);
 
 /**
  * \brief Get the name of the UShell  module.
@@ -176,6 +382,17 @@ UShellCmdErr_e UShellCmdHelpGet(UShellCmd_s* const cmd,
 UShellCmdErr_e UShellCmdListAdd(UShellCmd_s* const cmdRoot,
                                 UShellCmd_s* const cmd);
 
+/**
+ * \brief Find cmd in the list by name
+ * \param[in] cmdRoot - the root of the list
+ * \param[in] name - name of the cmd (terminated string)
+ * \param[out] cmd - the cmd found (NULL if there is no such cmd)
+ * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCmdErr_e UShellCmdListFind(UShellCmd_s* const cmdRoot,
+                                 const char* const name,
+                                 UShellCmd_s** const cmd);
+
 /**
  * \brief Remove cmd from the list
  * \param[in] cmdRoot - the root of the list
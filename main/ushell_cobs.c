@@ -0,0 +1,220 @@
+/**
+ * \file         ushell_cobs.c
+ * \brief        The file contains the implementation of the UShell COBS (Consistent Overhead Byte Stuffing) module.
+ * \warning      A warning may be placed here...
+ * \bug          Bug report may be placed here...
+ * \authors      Vladislav Kosten (vladkosten@gmail.com)
+ * \copyright    MIT License (c) 2025
+ */
+//===============================================================================[ INCLUDE ]========================================================================================
+
+#include "ushell_cobs.h"
+
+//=====================================================================[ INTERNAL MACRO DEFINITIONS ]===============================================================================
+
+/**
+ * \brief Assert macro for the UShellCobs module.
+ */
+#ifndef USHELL_COBS_ASSERT
+    #ifdef USHELL_ASSERT
+        #define USHELL_COBS_ASSERT(cond) USHELL_ASSERT(cond)
+    #else
+        #define USHELL_COBS_ASSERT(cond)
+    #endif
+#endif
+
+/**
+ * \brief The code of the full block (254 data bytes without the implicit zero).
+ */
+#define USHELL_COBS_CODE_MAX 0xFFU
+
+//====================================================================[ INTERNAL DATA TYPES DEFINITIONS ]===========================================================================
+
+//===============================================================[ INTERNAL FUNCTIONS AND OBJECTS DECLARATION ]=====================================================================
+
+//=======================================================================[ PUBLIC INTERFACE FUNCTIONS ]=============================================================================
+
+/**
+ * \brief Encode the data by COBS (Consistent Overhead Byte Stuffing)
+ * \note The delimiter is not added, the caller terminates the frame.
+ * \param[in] src - data to be encoded
+ * \param[in] srcLen - size of the data
+ * \param[out] dst - buffer for the encoded data (USHELL_COBS_ENCODED_SIZE(srcLen) is enough)
+ * \param[in] dstSize - size of the buffer
+ * \param[out] dstLen - size of the encoded data
+ * \return UShellCobsErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCobsErr_e UShellCobsEncode(const uint8_t* const src,
+                                 const size_t srcLen,
+                                 uint8_t* const dst,
+                                 const size_t dstSize,
+                                 size_t* const dstLen)
+{
+    /* Local variable */
+    UShellCobsErr_e status = USHELL_COBS_NO_ERR;
+    size_t rd = 0U;
+    size_t wr = 1U;
+    size_t codeInd = 0U;
+    uint8_t code = 1U;
+
+    do
+    {
+        /* Check input parameter */
+        if (((src == NULL) && (srcLen > 0U)) ||
+            (dst == NULL) ||
+            (dstSize == 0U) ||
+            (dstLen == NULL))
+        {
+            USHELL_COBS_ASSERT(0);
+            status = USHELL_COBS_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Every block starts with the code (distance to the next zero) */
+        for (rd = 0U; rd < srcLen; rd++)
+        {
+            /* Check we have space for one more item */
+            if (wr >= dstSize)
+            {
+                status = USHELL_COBS_SIZE_ERR;
+                break;
+            }
+
+            if (src [rd] == 0U)
+            {
+                /* The zero closes the block */
+                dst [codeInd] = code;
+                codeInd = wr++;
+                code = 1U;
+                continue;
+            }
+
+            dst [wr++] = src [rd];
+            code++;
+
+            /* The full block is closed without the zero */
+            if (code == USHELL_COBS_CODE_MAX)
+            {
+                dst [codeInd] = code;
+                code = 1U;
+
+                /* The next block is opened only if there is more data */
+                codeInd = wr;
+                if ((rd + 1U) < srcLen)
+                {
+                    wr++;
+                }
+            }
+        }
+
+        if (status != USHELL_COBS_NO_ERR)
+        {
+            break;
+        }
+
+        /* Close the last block (it is not opened after the full block at the end) */
+        if (codeInd < wr)
+        {
+            dst [codeInd] = code;
+        }
+        *dstLen = wr;
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Decode the COBS data
+ * \note The data is given without the delimiter. The data can be decoded in place (dst == src).
+ * \param[in] src - encoded data
+ * \param[in] srcLen - size of the encoded data
+ * \param[out] dst - buffer for the decoded data (srcLen is enough)
+ * \param[in] dstSize - size of the buffer
+ * \param[out] dstLen - size of the decoded data
+ * \return UShellCobsErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCobsErr_e UShellCobsDecode(const uint8_t* const src,
+                                 const size_t srcLen,
+                                 uint8_t* const dst,
+                                 const size_t dstSize,
+                                 size_t* const dstLen)
+{
+    /* Local variable */
+    UShellCobsErr_e status = USHELL_COBS_NO_ERR;
+    size_t rd = 0U;
+    size_t wr = 0U;
+    uint8_t code = 0U;
+    uint8_t item = 0U;
+
+    do
+    {
+        /* Check input parameter */
+        if ((src == NULL) ||
+            (dst == NULL) ||
+            (dstLen == NULL))
+        {
+            USHELL_COBS_ASSERT(0);
+            status = USHELL_COBS_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* The writer never passes the reader, so the data can be decoded in place */
+        while ((rd < srcLen) &&
+               (status == USHELL_COBS_NO_ERR))
+        {
+            /* Take the code of the block */
+            code = src [rd++];
+            if (code == 0U)
+            {
+                status = USHELL_COBS_FORMAT_ERR;
+                break;
+            }
+
+            /* Copy the items of the block */
+            for (uint8_t ind = 1U; ind < code; ind++)
+            {
+                if (rd >= srcLen)
+                {
+                    status = USHELL_COBS_FORMAT_ERR;
+                    break;
+                }
+
+                item = src [rd++];
+                if (item == 0U)
+                {
+                    status = USHELL_COBS_FORMAT_ERR;
+                    break;
+                }
+
+                if (wr >= dstSize)
+                {
+                    status = USHELL_COBS_SIZE_ERR;
+                    break;
+                }
+
+                dst [wr++] = item;
+            }
+
+            /* The block which is not full ends with the zero (except the last one) */
+            if ((status == USHELL_COBS_NO_ERR) &&
+                (code != USHELL_COBS_CODE_MAX) &&
+                (rd < srcLen))
+            {
+                if (wr >= dstSize)
+                {
+                    status = USHELL_COBS_SIZE_ERR;
+                    break;
+                }
+
+                dst [wr++] = 0U;
+            }
+        }
+
+        /* Set the result */
+        *dstLen = wr;
+
+    } while (0);
+
+    return status;
+}
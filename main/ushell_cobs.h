@@ -0,0 +1,83 @@
+#ifndef USHELL_COBS_H_
+#define USHELL_COBS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*================================================================[INCLUDE]================================================*/
+
+/* Standard includes */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "ushell_cfg.h"
+
+/*===========================================================[MACRO DEFINITIONS]============================================*/
+
+/**
+ * \brief Delimiter of the COBS frames (the encoded data never contains it).
+ */
+#define USHELL_COBS_DELIMITER 0x00U
+
+/**
+ * \brief The maximum size of the encoded data (without the delimiter).
+ * \param size - size of the data to be encoded
+ */
+#define USHELL_COBS_ENCODED_SIZE(size) ((size) + ((size) / 254U) + 1U)
+
+/*========================================================[DATA TYPES DEFINITIONS]==========================================*/
+
+/**
+ * \brief Enumeration of possible error codes
+ */
+typedef enum
+{
+    USHELL_COBS_NO_ERR = 0,          ///< Exit: no errors (success)
+    USHELL_COBS_INVALID_ARGS_ERR,    ///< Exit: error - invalid pointers (e.g. null pointers)
+    USHELL_COBS_SIZE_ERR,            ///< Exit: error - size error (e.g. the output buffer is too small)
+    USHELL_COBS_FORMAT_ERR,          ///< Exit: error - the encoded data is broken (e.g. it contains the delimiter)
+
+} UShellCobsErr_e;
+
+/*===========================================================[PUBLIC INTERFACE]=============================================*/
+
+/**
+ * \brief Encode the data by COBS (Consistent Overhead Byte Stuffing)
+ * \note The delimiter is not added, the caller terminates the frame.
+ * \param[in] src - data to be encoded
+ * \param[in] srcLen - size of the data
+ * \param[out] dst - buffer for the encoded data (USHELL_COBS_ENCODED_SIZE(srcLen) is enough)
+ * \param[in] dstSize - size of the buffer
+ * \param[out] dstLen - size of the encoded data
+ * \return UShellCobsErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCobsErr_e UShellCobsEncode(const uint8_t* const src,
+                                 const size_t srcLen,
+                                 uint8_t* const dst,
+                                 const size_t dstSize,
+                                 size_t* const dstLen);
+
+/**
+ * \brief Decode the COBS data
+ * \note The data is given without the delimiter. The data can be decoded in place (dst == src).
+ * \param[in] src - encoded data
+ * \param[in] srcLen - size of the encoded data
+ * \param[out] dst - buffer for the decoded data (srcLen is enough)
+ * \param[in] dstSize - size of the buffer
+ * \param[out] dstLen - size of the decoded data
+ * \return UShellCobsErr_e - error code. non-zero = an error has occurred;
+ */
+UShellCobsErr_e UShellCobsDecode(const uint8_t* const src,
+                                 const size_t srcLen,
+                                 uint8_t* const dst,
+                                 const size_t dstSize,
+                                 size_t* const dstLen);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* USHELL_COBS_H_ */
@@ -22,8 +22,26 @@
     #endif
 #endif
 
+/**
+ * \brief The maximum number of the fragments of one log line
+ */
+#define USHELL_LOG_FRAG_MAX 12U
+
 //====================================================================[ INTERNAL DATA TYPES DEFINITIONS ]===========================================================================
 
+/**
+ * \brief The log line being built (the fragments are written by one socket write)
+ */
+typedef struct
+{
+    UShellSocketIoVec_s frag [USHELL_LOG_FRAG_MAX];    ///< Fragments of the line
+    size_t fragNum;                                    ///< Number of the fragments
+    char time [24];                                    ///< Formatted time
+    char line [12];                                    ///< Formatted line number
+    char text [USHELL_LOG_MSG_SIZE];                   ///< Formatted text of the message
+
+} UShellLogMsg_s;
+
 //===============================================================[ INTERNAL FUNCTIONS AND OBJECTS DECLARATION ]=====================================================================
 
 /**
@@ -85,6 +103,15 @@ static void uShellLogLock(void);
  */
 static void uShellLogUnlock(void);
 
+/**
+ * \brief Add the fragment to the log line
+ * \param[in] base - first item of the fragment
+ * \param[in] len - number of the items
+ * \return none
+ */
+static void uShellLogFragAdd(const char* const base,
+                             const size_t len);
+
 /**
  * \brief Clear the current line in the log output
  * \param[in] none
@@ -128,18 +155,36 @@ static void uShellLogPrintModule(const char* const nameModule);
 static void uShellLogPrintFileLine(const char* const file,
                                    const int line);
 
+/**
+ * \brief Print the formatted text of the message in the log output
+ * \param[in] format - format string
+ * \param[in] args - va_list of arguments
+ * \return none
+ */
+static void uShellLogPrintText(const char* const format,
+                               va_list args);
+
+/**
+ * \brief Write the whole log line to the socket (one write)
+ * \param[in] none
+ * \return none
+ */
+static void uShellLogFlush(void);
+
 /**
  * \brief Execute the log command.
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellLogCmdExec(void* const cmd,
                                        UShellSocket_s* const readSocket,
                                        UShellSocket_s* const writeSocket,
                                        const int argc,
-                                       char* const argv []);
+                                       char* const argv [],
+                                       const UShellCmdCancel_s* const cancel);
 
 /**
  * \brief UShell log object (Singleton pattern)
@@ -148,6 +193,7 @@ UShellLog_s uShellLog = {0};    ///< UShell log object (base object)
 
 static UShellLogModule_s uShellLogModule [USHELL_LOG_MODULES_MAX];    ///< Array of log modules.
 static size_t uShellLogModuleCount;                                   ///< Count of registered log modules.
+static UShellLogMsg_s uShellLogMsg;                                   ///< Log line being built (guarded by the log lock).
 
 static const char* UShellLogLevelStrings [] = {
     "[NONE] ",       // USHELL_LOG_LEVEL_DEBUG
@@ -343,8 +389,7 @@ void UShellLogPrintWithFile(const UShellLogLevel_e level,
                             ...)
 {
     /* Local variable */
-    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;    // Variable to store the status of the operation
-    UShellLogModule_s* module = NULL;                   // Pointer to the log module
+    UShellLogModule_s* module = NULL;    // Pointer to the log module
     va_list args;
     va_start(args, format);
 
@@ -380,6 +425,9 @@ void UShellLogPrintWithFile(const UShellLogLevel_e level,
             break;
         }
 
+        /* Start the new log line */
+        uShellLogMsg.fragNum = 0U;
+
         /* Clear the current line */
         uShellLogClearLine();    // Clear the current line in the log output
 
@@ -396,18 +444,14 @@ void UShellLogPrintWithFile(const UShellLogLevel_e level,
         uShellLogPrintFileLine(file, line);    // Print the current file name and line number in the log output
 
         /* Print the formatted message */
-        status = UShellSocketPrintVaList(uShellLog.sessionCfg.writeSocket,
-                                         format,
-                                         args);    // Print the formatted message to the log output
-        if (status != USHELL_SOCKET_NO_ERR)
-        {
-            /* Print error message */
-            USHELL_LOG_ASSERT(0);    // Set status to error if printing fails
-        }
+        uShellLogPrintText(format, args);    // Print the formatted message to the log output
 
         /* Print a new line */
         uShellLogNewLine();    // Print a new line in the log output
 
+        /* Write the whole line at once */
+        uShellLogFlush();    // Write the log line to the socket
+
     } while (0);
 
     /* unlock */
@@ -431,8 +475,7 @@ void UShellLogPrint(const UShellLogLevel_e level,
                     ...)
 {
     /* Local variable */
-    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;    // Variable to store the status of the operation
-    UShellLogModule_s* module = NULL;                   // Pointer to the log module
+    UShellLogModule_s* module = NULL;    // Pointer to the log module
     va_list args;
     va_start(args, format);
 
@@ -468,6 +511,9 @@ void UShellLogPrint(const UShellLogLevel_e level,
             break;
         }
 
+        /* Start the new log line */
+        uShellLogMsg.fragNum = 0U;
+
         /* Clear the current line */
         uShellLogClearLine();    // Clear the current line in the log output
 
@@ -481,18 +527,14 @@ void UShellLogPrint(const UShellLogLevel_e level,
         uShellLogPrintModule(nameModule);    // Print the current module name in the log output
 
         /* Print the formatted message */
-        status = UShellSocketPrintVaList(uShellLog.sessionCfg.writeSocket,
-                                         format,
-                                         args);    // Print the formatted message to the log output
-        if (status != USHELL_SOCKET_NO_ERR)
-        {
-            /* Print error message */
-            USHELL_LOG_ASSERT(0);    // Set status to error if printing fails
-        }
+        uShellLogPrintText(format, args);    // Print the formatted message to the log output
 
         /* Print a new line */
         uShellLogNewLine();    // Print a new line in the log output
 
+        /* Write the whole line at once */
+        uShellLogFlush();    // Write the log line to the socket
+
     } while (0);
 
     /* unlock */
@@ -571,6 +613,8 @@ static UShellLogErr_e uShellLogRtEnvVcpInit(UShellVcp_s* const vcp)
     /* Local variables */
     UShellLogErr_e status = USHELL_LOG_NO_ERR;    // Variable to store the status of the operation
     UShellVcpErr_e vcpStatus = USHELL_VCP_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellOsalLockObjHandle_t lockObj = NULL;    // Lock of the writers of the log socket
     UShellSocket_s* writeSocket = NULL;
 
     /* Initialize the runtime environment vcp */
@@ -588,6 +632,9 @@ static UShellLogErr_e uShellLogRtEnvVcpInit(UShellVcp_s* const vcp)
         /* Init config for write */
         uShellLog.sessionCfg.writeParam.owner = &uShellLog;             // Set the owner of the session
         uShellLog.sessionCfg.writeParam.type = USHELL_VCP_DIR_WRITE;    // Set the type of the session
+        uShellLog.sessionCfg.writeParam.priority = USHELL_LOG_VCP_PRIORITY;    // Set the tx priority of the session
+        uShellLog.sessionCfg.writeParam.weight = USHELL_LOG_VCP_WEIGHT;        // Set the tx weight of the session
+        uShellLog.sessionCfg.writeParam.size = USHELL_LOG_LINE_SIZE;           // The stream holds the whole line
 
         /* Open session for write */
         vcpStatus = UShellVcpSessionOpen(vcp,
@@ -601,6 +648,20 @@ static UShellLogErr_e uShellLogRtEnvVcpInit(UShellVcp_s* const vcp)
             break;
         }
 
+        /* The log lines are written from the several threads, they are serialized by the log lock */
+        osalStatus = UShellOsalLockObjHandleGet(uShellLog.osal,
+                                                0U,
+                                                &lockObj);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (lockObj == NULL) ||
+            (UShellSocketWriteLockSet(writeSocket, uShellLog.osal, lockObj) != USHELL_SOCKET_NO_ERR))
+        {
+            /* Lock object is invalid */
+            USHELL_ASSERT(0);
+            status = USHELL_LOG_OSAL_ERR;
+            break;
+        }
+
         /* Save the write socket */
         uShellLog.sessionCfg.writeSocket = writeSocket;    // Save the write socket
 
@@ -816,6 +877,31 @@ static void uShellLogUnlock(void)
     } while (0);
 }
 
+/**
+ * \brief Add the fragment to the log line
+ * \param[in] base - first item of the fragment
+ * \param[in] len - number of the items
+ * \return none
+ */
+static void uShellLogFragAdd(const char* const base,
+                             const size_t len)
+{
+    do
+    {
+        /* Check we have space for the fragment */
+        if (uShellLogMsg.fragNum >= USHELL_LOG_FRAG_MAX)
+        {
+            USHELL_LOG_ASSERT(0);    // Increase USHELL_LOG_FRAG_MAX
+            break;
+        }
+
+        uShellLogMsg.frag [uShellLogMsg.fragNum].base = base;
+        uShellLogMsg.frag [uShellLogMsg.fragNum].len = len;
+        uShellLogMsg.fragNum++;
+
+    } while (0);
+}
+
 /**
  * \brief Clear the current line in the log output
  * \param[in] none
@@ -823,12 +909,7 @@ static void uShellLogUnlock(void)
  */
 static void uShellLogClearLine(void)
 {
-    USHELL_LOG_ASSERT(uShellLog.sessionCfg.writeSocket != NULL);    // Assert that the write socket is not NULL
-    UShellSocketErr_e socketStatus = UShellSocketWriteBlocking(uShellLog.sessionCfg.writeSocket,
-                                                               USHELL_LOG_CLEAR_LINE,
-                                                               strlen(USHELL_LOG_CLEAR_LINE));    // Write the clear line command to the socket
-    (void) socketStatus;                                                                          // Unused variable
-    USHELL_LOG_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);                                      // Assert that the socket status is no error
+    uShellLogFragAdd(USHELL_LOG_CLEAR_LINE, strlen(USHELL_LOG_CLEAR_LINE));    // Add the clear line command
 }
 
 /**
@@ -838,12 +919,7 @@ static void uShellLogClearLine(void)
  */
 static void uShellLogNewLine(void)
 {
-    USHELL_LOG_ASSERT(uShellLog.sessionCfg.writeSocket != NULL);    // Assert that the write socket is not NULL
-    UShellSocketErr_e socketStatus = UShellSocketWriteBlocking(uShellLog.sessionCfg.writeSocket,
-                                                               USHELL_LOG_NEW_LINE,
-                                                               strlen(USHELL_LOG_NEW_LINE));    // Write the new line command to the socket
-    (void) socketStatus;                                                                        // Unused variable
-    USHELL_LOG_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);                                    // Assert that the socket status is no error
+    uShellLogFragAdd(USHELL_LOG_NEW_LINE, strlen(USHELL_LOG_NEW_LINE));    // Add the new line command
 }
 
 /**
@@ -857,14 +933,14 @@ static void uShellLogPrintTime(void)
     UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;          // OSAL status
     UShellOsalTimeMs_t timeMs = 0U;                           // Time in milliseconds
     UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Socket status
+    size_t len = 0U;                                          // Length of the formatted time
 
     do
     {
         /* Check input parameters */
-        if ((uShellLog.osal == NULL) ||
-            (uShellLog.sessionCfg.writeSocket == NULL))
+        if (uShellLog.osal == NULL)
         {
-            USHELL_LOG_ASSERT(0);    // Assert that the OSAL and write socket are not NULL
+            USHELL_LOG_ASSERT(0);    // Assert that the OSAL is not NULL
             break;
         }
 
@@ -882,15 +958,19 @@ static void uShellLogPrintTime(void)
             break;
         }
 
-        socketStatus = UShellSocketPrint(uShellLog.sessionCfg.writeSocket,
-                                         "[%u mS] ",
-                                         timeMs);    // Print the current time to the socket
+        socketStatus = UShellSocketFormat(uShellLogMsg.time,
+                                          sizeof(uShellLogMsg.time),
+                                          &len,
+                                          "[%u mS] ",
+                                          timeMs);    // Format the current time
         if (socketStatus != USHELL_SOCKET_NO_ERR)
         {
             USHELL_LOG_ASSERT(0);    // Assert that the socket status is no error
             break;
         }
 
+        uShellLogFragAdd(uShellLogMsg.time, len);    // Add the current time
+
     } while (0);
 }
 
@@ -901,17 +981,8 @@ static void uShellLogPrintTime(void)
  */
 static void uShellLogPrintLevel(const UShellLogLevel_e level)
 {
-    /* Local variable */
-    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Socket status
-
     do
     {
-        /* Check input parameters */
-        if (uShellLog.sessionCfg.writeSocket == NULL)
-        {
-            break;    // Exit if write socket is NULL
-        }
-
         /* Check config */
         if (uShellLog.cfg.levelPrintEnable == false)
         {
@@ -925,14 +996,8 @@ static void uShellLogPrintLevel(const UShellLogLevel_e level)
         }
 
         /* Print the log level */
-        socketStatus = UShellSocketWriteBlocking(uShellLog.sessionCfg.writeSocket,
-                                                 UShellLogLevelStrings [level],
-                                                 strlen(UShellLogLevelStrings [level]));    // Write the log level to the socket
-        if (socketStatus != USHELL_SOCKET_NO_ERR)
-        {
-            USHELL_LOG_ASSERT(0);    // Assert that the socket status is no error
-            break;
-        }
+        uShellLogFragAdd(UShellLogLevelStrings [level],
+                         strlen(UShellLogLevelStrings [level]));    // Add the log level
 
     } while (0);
 }
@@ -944,16 +1009,12 @@ static void uShellLogPrintLevel(const UShellLogLevel_e level)
  */
 static void uShellLogPrintModule(const char* const nameModule)
 {
-    /* Local variable */
-    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Socket status
-
     do
     {
         /* Check input parameters */
-        if ((uShellLog.sessionCfg.writeSocket == NULL) ||
-            (nameModule == NULL))
+        if (nameModule == NULL)
         {
-            USHELL_LOG_ASSERT(0);    // Assert that the write socket and module name are not NULL
+            USHELL_LOG_ASSERT(0);    // Assert that the module name is not NULL
             break;
         }
 
@@ -963,15 +1024,10 @@ static void uShellLogPrintModule(const char* const nameModule)
             break;    // Exit if module name is not enabled in the config
         }
 
-        /* Print the module name */
-        socketStatus = UShellSocketPrint(uShellLog.sessionCfg.writeSocket,
-                                         "[%s] ",
-                                         nameModule);    // Write the module name to the socket
-        if (socketStatus != USHELL_SOCKET_NO_ERR)
-        {
-            USHELL_LOG_ASSERT(0);    // Assert that the socket status is no error
-            break;
-        }
+        /* Print the module name as "[name] " */
+        uShellLogFragAdd("[", 1U);
+        uShellLogFragAdd(nameModule, strlen(nameModule));
+        uShellLogFragAdd("] ", 2U);
 
     } while (0);
 }
@@ -986,15 +1042,15 @@ static void uShellLogPrintFileLine(const char* const file,
 {
     /* Local variable */
     UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Socket status
+    size_t len = 0U;                                          // Length of the formatted line number
 
     do
     {
         /* Check input parameters */
-        if ((uShellLog.sessionCfg.writeSocket == NULL) ||
-            (file == NULL) ||
+        if ((file == NULL) ||
             (line <= 0))
         {
-            USHELL_LOG_ASSERT(0);    // Assert that the write socket and file name are not NULL
+            USHELL_LOG_ASSERT(0);    // Assert that the file name is not NULL
             break;
         }
 
@@ -1004,17 +1060,87 @@ static void uShellLogPrintFileLine(const char* const file,
             break;    // Exit if file name is not enabled in the config
         }
 
-        /* Print the file name and line number */
-        socketStatus = UShellSocketPrint(uShellLog.sessionCfg.writeSocket,
-                                         "[%s:%d] ",
-                                         file,
-                                         line);    // Write the file name and line number to the socket
+        /* Print the file name and line number as "[file:line] " */
+        socketStatus = UShellSocketFormat(uShellLogMsg.line,
+                                          sizeof(uShellLogMsg.line),
+                                          &len,
+                                          ":%d] ",
+                                          line);    // Format the line number
         if (socketStatus != USHELL_SOCKET_NO_ERR)
         {
             USHELL_LOG_ASSERT(0);    // Assert that the socket status is no error
             break;
         }
 
+        uShellLogFragAdd("[", 1U);
+        uShellLogFragAdd(file, strlen(file));
+        uShellLogFragAdd(uShellLogMsg.line, len);
+
+    } while (0);
+}
+
+/**
+ * \brief Print the formatted text of the message in the log output
+ * \param[in] format - format string
+ * \param[in] args - va_list of arguments
+ * \return none
+ */
+static void uShellLogPrintText(const char* const format,
+                               va_list args)
+{
+    /* Local variable */
+    size_t len = 0U;    // Length of the formatted text
+
+    /* The text which does not fit the message is truncated */
+    UShellSocketFormatVaList(uShellLogMsg.text,
+                             sizeof(uShellLogMsg.text),
+                             &len,
+                             format,
+                             args);    // Format the message text
+
+    uShellLogFragAdd(uShellLogMsg.text, len);    // Add the message text
+}
+
+/**
+ * \brief Write the whole log line to the socket (one write)
+ * \param[in] none
+ * \return none
+ */
+static void uShellLogFlush(void)
+{
+    /* Local variable */
+    UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Socket status
+    size_t room = 0U;                                         // Items left for the fragments before the new line
+
+    do
+    {
+        /* Check input parameters */
+        if ((uShellLog.sessionCfg.writeSocket == NULL) ||
+            (uShellLogMsg.fragNum == 0U))
+        {
+            break;
+        }
+
+        /* Truncate the line to USHELL_LOG_LINE_SIZE, so it is sent in one piece (the last fragment is the new line) */
+        room = USHELL_LOG_LINE_SIZE - uShellLogMsg.frag [uShellLogMsg.fragNum - 1U].len;
+        for (size_t i = 0U; i < (uShellLogMsg.fragNum - 1U); i++)
+        {
+            uShellLogMsg.frag [i].len = (uShellLogMsg.frag [i].len < room) ? uShellLogMsg.frag [i].len : room;
+            room -= uShellLogMsg.frag [i].len;
+        }
+
+        /* Write all fragments at once (the line is dropped if the console does not take it) */
+        socketStatus = UShellSocketWriteV(uShellLog.sessionCfg.writeSocket,
+                                          uShellLogMsg.frag,
+                                          uShellLogMsg.fragNum,
+                                          USHELL_LOG_WRITE_TIMEOUT_MS);
+        if (socketStatus != USHELL_SOCKET_NO_ERR)
+        {
+            uShellLog.dropCount++;    // Count the dropped line
+        }
+
+        uShellLogMsg.fragNum = 0U;
+
     } while (0);
 }
 
@@ -1023,18 +1149,21 @@ static void uShellLogPrintFileLine(const char* const file,
  * \param cmd - UShellCmd object
  * \param argc - number of arguments
  * \param argv - array of arguments
+ * \param cancel - cancellation token
  * \return UShellCmdErr_e - error code. non-zero = an error has occurred;
  */
 static UShellCmdErr_e uShellLogCmdExec(void* const cmd,
                                        UShellSocket_s* const readSocket,
                                        UShellSocket_s* const writeSocket,
                                        const int argc,
-                                       char* const argv [])
+                                       char* const argv [],
+                                       const UShellCmdCancel_s* const cancel)
 {
     /* Local variables */
     UShellCmdErr_e status = USHELL_CMD_NO_ERR;                // Command execution status
     UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;    // Socket operation status
     (void) socketStatus;                                      // Suppress unused variable warning
+    (void) cancel;                                            // Suppress unused variable warning
 
     do
     {
@@ -1113,6 +1242,12 @@ static UShellCmdErr_e uShellLogCmdExec(void* const cmd,
                                                  "Current global log level: %s\r\n",
                                                  UShellLogLevelStrings [uShellLog.cfg.curLevel]);
                 USHELL_LOG_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);
+
+                /* Get the number of the dropped lines */
+                socketStatus = UShellSocketPrint(writeSocket,
+                                                 "Dropped log lines: %lu\r\n",
+                                                 (unsigned long) uShellLog.dropCount);
+                USHELL_LOG_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);
             }
             else
             {
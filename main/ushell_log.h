@@ -153,6 +153,46 @@ extern "C" {
     #define USHELL_LOG_MODULES_MAX 30U    ///< UShell log max modules count
 #endif
 
+/**
+ * @brief Maximum length of the formatted text of one log message.
+ *
+ * The longer text is truncated. The whole log line (prefixes, text and new line) is written by one socket write.
+ */
+#ifndef USHELL_LOG_MSG_SIZE
+    #define USHELL_LOG_MSG_SIZE 128U    ///< UShell log message text size
+#endif
+
+/**
+ * @brief Maximum length of the whole log line (prefixes, text and new line).
+ *
+ * The log output stream holds a line of this size, so the line is sent in one piece.
+ * The longer line is truncated (the new line is kept). It must fit USHELL_SOCKET_WRITEV_BUFF_SIZE.
+ */
+#ifndef USHELL_LOG_LINE_SIZE
+    #define USHELL_LOG_LINE_SIZE 256U    ///< UShell log line size
+#endif
+
+/**
+ * @brief Timeout of the log line write in milliseconds.
+ *
+ * The log line is dropped if the console does not take it in time (the dropped lines are counted).
+ */
+#ifndef USHELL_LOG_WRITE_TIMEOUT_MS
+    #define USHELL_LOG_WRITE_TIMEOUT_MS 500U    ///< UShell log write timeout
+#endif
+
+/**
+ * @brief Priority and weight of the log output in the VCP tx scheduler.
+ *
+ * The log of the same priority as the shell takes turns with it by weight * USHELL_VCP_TX_QUANTUM items.
+ */
+#ifndef USHELL_LOG_VCP_PRIORITY
+    #define USHELL_LOG_VCP_PRIORITY 0U    ///< UShell log output priority
+#endif
+#ifndef USHELL_LOG_VCP_WEIGHT
+    #define USHELL_LOG_VCP_WEIGHT 1U    ///< UShell log output weight
+#endif
+
 /*========================================================[DATA TYPES DEFINITIONS]==========================================*/
 
 /**
@@ -251,6 +291,7 @@ typedef struct
     /* Internal use */
     UShellLogCmd_s cmd;                     ///< Command object for the logging system.
     UShellLogSessionConfig_s sessionCfg;    ///< Session configuration for the logging system.
+    size_t dropCount;                       ///< Number of the log lines the console did not take.
 
 } UShellLog_s;
 
@@ -1464,6 +1464,153 @@ UShellOsalErr_e UShellOsalStreamBuffIsEmpty(UShellOsal_s* const osal,
     return status;
 }
 
+/**
+ * \brief Get the free space of the stream buffer
+ * \param[in] osal - pointer to OSAL instance
+ * \param[in] streamBuffHandle - stream buffer handle
+ * \param[out] space - number of the bytes which can be sent without the wait
+ * \return UShellOsalErr_e - error code. non-zero = an error has occurred;
+ */
+UShellOsalErr_e UShellOsalStreamBuffSpaceGet(UShellOsal_s* const osal,
+                                             const UShellOsalStreamBuffHandle_t streamBuffHandle,
+                                             size_t* const space)
+{
+    /* Local variables */
+    UShellOsalErr_e status = USHELL_OSAL_NO_ERR;
+
+    /* Get the free space */
+    do
+    {
+        /* Checking of params */
+        if ((NULL == osal) ||
+            (NULL == streamBuffHandle) ||
+            (NULL == space))
+        {
+            /* Invalid input parameter */
+            USHELL_OSAL_ASSERT(0);
+            status = USHELL_OSAL_INVALID_ARGS;
+            break;
+        }
+
+        /* Checking is init obj */
+        if ((NULL == osal->portable) ||
+            (NULL == osal->portable->streamBuffSpaceGet))
+        {
+            /* Invalid input parameter */
+            USHELL_OSAL_ASSERT(0);
+            status = USHELL_OSAL_PORT_SPECIFIC_ERR;
+            break;
+        }
+
+        /* Get the free space */
+        status = osal->portable->streamBuffSpaceGet(osal,
+                                                    streamBuffHandle,
+                                                    space);
+    } while (0);
+
+    /* Return the status */
+    return status;
+}
+
+/**
+ * \brief Reserve the contiguous free region inside the stream buffer
+ * \note The port support is optional, USHELL_OSAL_PORT_SPECIFIC_ERR is returned by the port without it.
+ * \param[in] osal - pointer to OSAL instance
+ * \param[in] streamBuffHandle - stream buffer handle
+ * \param[out] region - start of the free region
+ * \param[out] size - size of the free region in bytes (0 - the buffer is full)
+ * \return UShellOsalErr_e - error code. non-zero = an error has occurred;
+ */
+UShellOsalErr_e UShellOsalStreamBuffReserve(UShellOsal_s* const osal,
+                                            const UShellOsalStreamBuffHandle_t streamBuffHandle,
+                                            void** const region,
+                                            size_t* const size)
+{
+    /* Local variables */
+    UShellOsalErr_e status = USHELL_OSAL_NO_ERR;
+
+    /* Reserve the region */
+    do
+    {
+        /* Checking of params */
+        if ((NULL == osal) ||
+            (NULL == streamBuffHandle) ||
+            (NULL == region) ||
+            (NULL == size))
+        {
+            /* Invalid input parameter */
+            USHELL_OSAL_ASSERT(0);
+            status = USHELL_OSAL_INVALID_ARGS;
+            break;
+        }
+
+        /* The function is optional, the caller falls back to the copy */
+        if ((NULL == osal->portable) ||
+            (NULL == osal->portable->streamBuffReserve) ||
+            (NULL == osal->portable->streamBuffCommit))
+        {
+            status = USHELL_OSAL_PORT_SPECIFIC_ERR;
+            break;
+        }
+
+        /* Reserve the region */
+        status = osal->portable->streamBuffReserve(osal,
+                                                   streamBuffHandle,
+                                                   region,
+                                                   size);
+    } while (0);
+
+    /* Return the status */
+    return status;
+}
+
+/**
+ * \brief Commit the bytes written into the region reserved by UShellOsalStreamBuffReserve
+ * \param[in] osal - pointer to OSAL instance
+ * \param[in] streamBuffHandle - stream buffer handle
+ * \param[in] dataLengthBytes - number of the bytes written from the start of the region
+ * \return UShellOsalErr_e - error code. non-zero = an error has occurred;
+ */
+UShellOsalErr_e UShellOsalStreamBuffCommit(UShellOsal_s* const osal,
+                                           const UShellOsalStreamBuffHandle_t streamBuffHandle,
+                                           const size_t dataLengthBytes)
+{
+    /* Local variables */
+    UShellOsalErr_e status = USHELL_OSAL_NO_ERR;
+
+    /* Commit the region */
+    do
+    {
+        /* Checking of params */
+        if ((NULL == osal) ||
+            (NULL == streamBuffHandle))
+        {
+            /* Invalid input parameter */
+            USHELL_OSAL_ASSERT(0);
+            status = USHELL_OSAL_INVALID_ARGS;
+            break;
+        }
+
+        /* Checking is init obj */
+        if ((NULL == osal->portable) ||
+            (NULL == osal->portable->streamBuffCommit))
+        {
+            /* Invalid input parameter */
+            USHELL_OSAL_ASSERT(0);
+            status = USHELL_OSAL_PORT_SPECIFIC_ERR;
+            break;
+        }
+
+        /* Commit the region */
+        status = osal->portable->streamBuffCommit(osal,
+                                                  streamBuffHandle,
+                                                  dataLengthBytes);
+    } while (0);
+
+    /* Return the status */
+    return status;
+}
+
 /**
  * \brief Create the timer
  * \param[in] osal - pointer to OSAL instance
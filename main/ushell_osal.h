@@ -29,20 +29,22 @@ extern "C" {
  * Defines the number of lock objects available in the UShell OSAL.
  */
 #ifndef USHELL_OSAL_LOCK_OBJS_NUM
-    #define USHELL_OSAL_LOCK_OBJS_NUM (2)
+    #define USHELL_OSAL_LOCK_OBJS_NUM (3)
 #endif
 
 /**
  * \brief UShell OSAL threads number.
  *
  * Defines the number of threads available in the UShell OSAL.
+ * The UShell object takes two threads per session (the session and its pipe) and one per command worker (3 by default).
  */
 #ifndef USHELL_OSAL_THREADS_NUM
-    #define USHELL_OSAL_THREADS_NUM (1)
+    #define USHELL_OSAL_THREADS_NUM (3)
 #endif
 
 /**
  * \brief UShell OSAL stream buffer slots number
+ * \note The UShell object takes USHELL_SESSION_STREAM_BUFF_NUM (5) slots per session.
  */
 #ifndef USHELL_OSAL_STREAM_BUFF_SLOTS_NUM
     #define USHELL_OSAL_STREAM_BUFF_SLOTS_NUM (6)
@@ -835,6 +837,47 @@ typedef struct
                                          const UShellOsalStreamBuffHandle_t streamBuffHandle,
                                          bool* const isEmpty);
 
+    /**
+     * \brief Get the free space of the stream buffer.
+     *
+     * \param[in] osal Pointer to the OSAL instance.
+     * \param[in] streamBuffHandle Handle of the stream buffer.
+     * \param[out] space Pointer to store the number of the bytes which can be sent without the wait.
+     * \return Error code indicating the result of the operation.
+     */
+    UShellOsalErr_e (*streamBuffSpaceGet)(void* const osal,
+                                          const UShellOsalStreamBuffHandle_t streamBuffHandle,
+                                          size_t* const space);
+
+    /**
+     * \brief Reserve the contiguous free region inside the stream buffer [optional].
+     *
+     * The writer fills the region in place and makes it visible to the reader by streamBuffCommit.
+     * The port which can not expose its storage leaves this function NULL.
+     *
+     * \param[in] osal Pointer to the OSAL instance.
+     * \param[in] streamBuffHandle Handle of the stream buffer.
+     * \param[out] region Pointer to store the start of the free region.
+     * \param[out] size Pointer to store the size of the free region in bytes (0 - the buffer is full).
+     * \return Error code indicating the result of the operation.
+     */
+    UShellOsalErr_e (*streamBuffReserve)(void* const osal,
+                                         const UShellOsalStreamBuffHandle_t streamBuffHandle,
+                                         void** const region,
+                                         size_t* const size);
+
+    /**
+     * \brief Commit the bytes written into the reserved region of the stream buffer [optional].
+     *
+     * \param[in] osal Pointer to the OSAL instance.
+     * \param[in] streamBuffHandle Handle of the stream buffer.
+     * \param[in] dataLengthBytes Number of the bytes written from the start of the region.
+     * \return Error code indicating the result of the operation.
+     */
+    UShellOsalErr_e (*streamBuffCommit)(void* const osal,
+                                        const UShellOsalStreamBuffHandle_t streamBuffHandle,
+                                        const size_t dataLengthBytes);
+
     /**
      * \brief Create a timer.
      *
@@ -1416,6 +1459,42 @@ UShellOsalErr_e UShellOsalStreamBuffIsEmpty(UShellOsal_s* const osal,
                                             const UShellOsalStreamBuffHandle_t streamBuffHandle,
                                             bool* const isEmpty);
 
+/**
+ * \brief Get the free space of the stream buffer
+ * \param[in] osal - pointer to OSAL instance
+ * \param[in] streamBuffHandle - stream buffer handle
+ * \param[out] space - number of the bytes which can be sent without the wait
+ * \return UShellOsalErr_e - error code. non-zero = an error has occurred;
+ */
+UShellOsalErr_e UShellOsalStreamBuffSpaceGet(UShellOsal_s* const osal,
+                                             const UShellOsalStreamBuffHandle_t streamBuffHandle,
+                                             size_t* const space);
+
+/**
+ * \brief Reserve the contiguous free region inside the stream buffer
+ * \note The port support is optional, USHELL_OSAL_PORT_SPECIFIC_ERR is returned by the port without it.
+ * \param[in] osal - pointer to OSAL instance
+ * \param[in] streamBuffHandle - stream buffer handle
+ * \param[out] region - start of the free region
+ * \param[out] size - size of the free region in bytes (0 - the buffer is full)
+ * \return UShellOsalErr_e - error code. non-zero = an error has occurred;
+ */
+UShellOsalErr_e UShellOsalStreamBuffReserve(UShellOsal_s* const osal,
+                                            const UShellOsalStreamBuffHandle_t streamBuffHandle,
+                                            void** const region,
+                                            size_t* const size);
+
+/**
+ * \brief Commit the bytes written into the region reserved by UShellOsalStreamBuffReserve
+ * \param[in] osal - pointer to OSAL instance
+ * \param[in] streamBuffHandle - stream buffer handle
+ * \param[in] dataLengthBytes - number of the bytes written from the start of the region
+ * \return UShellOsalErr_e - error code. non-zero = an error has occurred;
+ */
+UShellOsalErr_e UShellOsalStreamBuffCommit(UShellOsal_s* const osal,
+                                           const UShellOsalStreamBuffHandle_t streamBuffHandle,
+                                           const size_t dataLengthBytes);
+
 /**
  * \brief Create the timer
  * \param[in] osal - pointer to OSAL instance
@@ -14,7 +14,7 @@
 #include <stddef.h>
 #include <stdbool.h>
 #include <string.h>
-#include <stdio.h>
+#include <float.h>
 
 /* Project includes */
 #include "ushell_socket.h"
@@ -28,8 +28,92 @@
     #define USHELL_SOCKET_ASSERT(cond)
 #endif
 
+/**
+ * \brief Size of the buffer of the converted number (64 binary digits and the spare)
+ */
+#define USHELL_SOCKET_FMT_NUM_SIZE 72U
+
+/**
+ * \brief The maximum number of the converted fraction digits (the rest of the precision is padded with zeros)
+ */
+#define USHELL_SOCKET_FMT_FLOAT_PREC_MAX 9
+
+/**
+ * \brief The maximum precision of the floating point conversion (the integer part and the point fit the buffer)
+ */
+#define USHELL_SOCKET_FMT_FLOAT_PREC_LIMIT ((int) USHELL_SOCKET_FMT_NUM_SIZE - 24)
+
+/**
+ * \brief Number of the decimal digits of a limb of the integer part out of the uint64_t range
+ */
+#define USHELL_SOCKET_FMT_FLOAT_LIMB_DIGITS 9
+
+/**
+ * \brief Base of a limb of the integer part out of the uint64_t range
+ */
+#define USHELL_SOCKET_FMT_FLOAT_LIMB_BASE 1000000000U
+
+/**
+ * \brief Number of the limbs of the integer part out of the uint64_t range (the digits of DBL_MAX)
+ */
+#define USHELL_SOCKET_FMT_FLOAT_LIMB_NUM ((DBL_MAX_10_EXP / USHELL_SOCKET_FMT_FLOAT_LIMB_DIGITS) + 1)
+
 //====================================================================[ INTERNAL DATA TYPES DEFINITIONS ]===========================================================================
 
+/**
+ * \brief Staging buffer of the formatted print
+ * \note The items are collected here and written to the stream by one send.
+ *       The buffer without the socket is the output of the formatting into the memory (the rest is truncated).
+ */
+typedef struct
+{
+    UShellSocket_s* socket;    ///< Socket to be written (NULL - the memory output)
+    char* buff;                ///< Collected items
+    size_t size;               ///< Size of the buffer
+    size_t len;                ///< Number of the collected items
+
+} UShellSocketPrintBuff_s;
+
+/**
+ * \brief Flags of the conversion specification
+ */
+typedef enum
+{
+    USHELL_SOCKET_FMT_FLAG_NONE = 0x00U,     ///< No flags
+    USHELL_SOCKET_FMT_FLAG_LEFT = 0x01U,     ///< '-' - left justify
+    USHELL_SOCKET_FMT_FLAG_ZERO = 0x02U,     ///< '0' - pad with zeros
+    USHELL_SOCKET_FMT_FLAG_PLUS = 0x04U,     ///< '+' - always print the sign
+    USHELL_SOCKET_FMT_FLAG_SPACE = 0x08U,    ///< ' ' - space instead of the plus sign
+    USHELL_SOCKET_FMT_FLAG_ALT = 0x10U,      ///< '#' - alternative form (0x, 0b, 0 prefixes)
+    USHELL_SOCKET_FMT_FLAG_UPPER = 0x20U,    ///< Upper case digits (%X)
+
+} UShellSocketFmtFlag_e;
+
+/**
+ * \brief Conversion specification of the format string (%[flags][width][.precision][length]type)
+ */
+typedef struct
+{
+    uint32_t flags;    ///< Flags of the conversion (UShellSocketFmtFlag_e)
+    int width;         ///< Minimum width of the field
+    int precision;     ///< Precision (-1 = not given)
+
+} UShellSocketFmtSpec_s;
+
+/**
+ * \brief Input of the formatted scan
+ * \note The items are taken from the stream in chunks into the lookahead of the socket,
+ *       the items which are not consumed stay there for the next scan.
+ */
+typedef struct
+{
+    UShellSocket_s* socket;           ///< Socket to be read
+    UShellOsalTimeMs_t start;         ///< Time the scan is started
+    UShellSocketTimeMs_t timeout;     ///< Time the input is waited for (from the start)
+    size_t consumed;                  ///< Number of the consumed items (%n)
+
+} UShellSocketScan_s;
+
 //===============================================================[ INTERNAL FUNCTIONS AND OBJECTS DECLARATION ]=====================================================================
 
 /**
@@ -57,6 +141,36 @@ static UShellSocketErr_e uShellSocketWriteBytesNonBlock(UShellSocket_s* const so
                                                         size_t len,
                                                         UShellSocketTimeMs_t timeout);
 
+/**
+ * \brief Write a block of data to the uShell socket object at once (all items or nothing)
+ * \note The free space of the stream is checked every USHELL_SOCKET_WRITEV_POLL_MS until the block fits it
+ *       or the timeout is over. The writers hold the lock of the socket and the reader only frees the space,
+ *       so the block which fits is sent completely.
+ * \param[in] socket - uShell object to be written
+ * \param[in] data - items to be written
+ * \param[in] len - number of the items
+ * \param[in] timeout - timeout in milliseconds
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred (USHELL_SOCKET_TIMEOUT_ERR - nothing is written);
+ */
+static UShellSocketErr_e uShellSocketWriteWhole(UShellSocket_s* const socket,
+                                                const char* data,
+                                                size_t len,
+                                                UShellSocketTimeMs_t timeout);
+
+/**
+ * \brief Take the lock of the writers of the socket (if it is set)
+ * \param[in] socket - uShell object to be written (may be NULL)
+ * \return none
+ */
+static void uShellSocketWriteLock(UShellSocket_s* const socket);
+
+/**
+ * \brief Release the lock of the writers of the socket (if it is set)
+ * \param[in] socket - uShell object to be written (may be NULL)
+ * \return none
+ */
+static void uShellSocketWriteUnlock(UShellSocket_s* const socket);
+
 /**
  * \brief Read a block of data from the uShell socket object in non-blocking mode
  * \note This function is non-blocking and will return immediately if no data is available.
@@ -82,17 +196,263 @@ static UShellSocketErr_e uShellSocketReadNonBlock(UShellSocket_s* const socket,
 UShellSocketErr_e uShellSocketReadBlocking(UShellSocket_s* const socket,
                                            char* data,
                                            size_t len);
+
+/**
+ * \brief Read all available data (up to len) from the uShell socket object
+ * \param[in] socket - uShell object to be read
+ * \param[out] data - buffer to store the read data
+ * \param[in] len - size of the buffer
+ * \param[in] timeout - timeout in milliseconds (ignored in the blocking mode)
+ * \param[in] isBlocking - true to wait for the first item without timeout
+ * \param[out] readCount - number of the items read
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketReadAvailable(UShellSocket_s* const socket,
+                                                   char* data,
+                                                   size_t len,
+                                                   UShellSocketTimeMs_t timeout,
+                                                   bool isBlocking,
+                                                   size_t* const readCount);
+
 /**
- * \brief Process the format string and write to the uShell socket object
- * \param[in] socket - uShell object to be processed
+ * \brief Process the format string and put the output into the staging buffer
+ * \note The caller flushes the staging buffer.
+ * \param[in] printBuff - staging buffer
  * \param[in] format - format string
  * \param[in] args - variable arguments list
  * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
  */
-static UShellSocketErr_e uShellSocketProcessFormat(UShellSocket_s* const socket,
+static UShellSocketErr_e uShellSocketProcessFormat(UShellSocketPrintBuff_s* const printBuff,
                                                    const char* const format,
                                                    va_list args);
 
+/**
+ * \brief Print formatted string to the socket through the staging buffer on the stack
+ * \param[in] socket - uShell object to be printed
+ * \param[in] format - format string
+ * \param[in] args - variable arguments list
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketPrintFormat(UShellSocket_s* const socket,
+                                                 const char* const format,
+                                                 va_list args);
+
+/**
+ * \brief Put the items into the staging buffer (the full buffer is written to the socket)
+ * \param[in] printBuff - staging buffer
+ * \param[in] data - items to be put
+ * \param[in] len - number of the items
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketPrintBuffPut(UShellSocketPrintBuff_s* const printBuff,
+                                                  const char* data,
+                                                  size_t len);
+
+/**
+ * \brief Write the collected items of the staging buffer to the socket
+ * \param[in] printBuff - staging buffer
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketPrintBuffFlush(UShellSocketPrintBuff_s* const printBuff);
+
+/**
+ * \brief Put the same item into the staging buffer several times (the padding)
+ * \param[in] printBuff - staging buffer
+ * \param[in] item - item to be put
+ * \param[in] count - number of the items
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketPrintBuffFill(UShellSocketPrintBuff_s* const printBuff,
+                                                   const char item,
+                                                   int count);
+
+/**
+ * \brief Put the converted field into the staging buffer with the padding of the specification
+ * \param[in] printBuff - staging buffer
+ * \param[in] spec - conversion specification
+ * \param[in] prefix - sign and/or base prefix (may be NULL)
+ * \param[in] digits - converted digits
+ * \param[in] digitsLen - number of the digits
+ * \param[in] zeros - number of the leading zeros required by the precision
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketFmtField(UShellSocketPrintBuff_s* const printBuff,
+                                              const UShellSocketFmtSpec_s* const spec,
+                                              const char* const prefix,
+                                              const char* const digits,
+                                              const int digitsLen,
+                                              const int zeros);
+
+/**
+ * \brief Convert the unsigned value to the decimal digits (two digits per step)
+ * \param[in] value - value to be converted
+ * \param[in] end - end of the buffer (the digits are written backward)
+ * \return char* - first digit
+ */
+static char* uShellSocketFmtDec(uint64_t value,
+                                char* end);
+
+/**
+ * \brief Convert the unsigned value to the digits of the power of two base (no division)
+ * \param[in] value - value to be converted
+ * \param[in] shift - bits per digit (1 - binary, 3 - octal, 4 - hexadecimal)
+ * \param[in] upper - upper case digits
+ * \param[in] end - end of the buffer (the digits are written backward)
+ * \return char* - first digit
+ */
+static char* uShellSocketFmtPow2(uint64_t value,
+                                 const uint8_t shift,
+                                 const bool upper,
+                                 char* end);
+
+/**
+ * \brief Put the integer into the staging buffer
+ * \param[in] printBuff - staging buffer
+ * \param[in] spec - conversion specification
+ * \param[in] value - absolute value
+ * \param[in] isNegative - the value is negative (only for the signed conversions)
+ * \param[in] type - type of the conversion (d, u, x, X, o, b, p)
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketFmtInt(UShellSocketPrintBuff_s* const printBuff,
+                                            const UShellSocketFmtSpec_s* const spec,
+                                            const uint64_t value,
+                                            const bool isNegative,
+                                            const char type);
+
+/**
+ * \brief Put the floating point value into the staging buffer (fixed point notation)
+ * \note Only USHELL_SOCKET_FMT_FLOAT_PREC_MAX fraction digits are converted (the rest are zeros),
+ *       the values out of the uint64_t range are converted by uShellSocketFmtFloatBig.
+ * \param[in] printBuff - staging buffer
+ * \param[in] spec - conversion specification
+ * \param[in] value - value to be put
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketFmtFloat(UShellSocketPrintBuff_s* const printBuff,
+                                              const UShellSocketFmtSpec_s* const spec,
+                                              double value);
+
+/**
+ * \brief Put the floating point value out of the uint64_t range into the staging buffer (fixed point notation)
+ * \note The value is an integer there (the fraction digits are zeros). It is split to the mantissa and the power of two,
+ *       the mantissa is shifted by the power in the base 10^9 limbs and the limbs are put from the most significant one.
+ * \param[in] printBuff - staging buffer
+ * \param[in] spec - conversion specification
+ * \param[in] prefix - sign prefix (may be NULL)
+ * \param[in] value - absolute value (finite, not less than 2^64)
+ * \param[in] precision - number of the fraction digits
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketFmtFloatBig(UShellSocketPrintBuff_s* const printBuff,
+                                                 const UShellSocketFmtSpec_s* const spec,
+                                                 const char* const prefix,
+                                                 double value,
+                                                 const int precision);
+
+/**
+ * \brief Pairs of the decimal digits "00".."99" (the decimal conversion takes two digits per division)
+ */
+static const char uShellSocketFmtDigitPairs [] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * \brief Digits of the power of two bases
+ */
+static const char uShellSocketFmtDigitsLower [] = "0123456789abcdef";
+static const char uShellSocketFmtDigitsUpper [] = "0123456789ABCDEF";
+
+/**
+ * \brief Process the scan format string and assign the results
+ * \param[in] scan - input of the scan
+ * \param[in] format - format string
+ * \param[in] args - variable arguments list (pointers to the results)
+ * \param[out] count - number of the assigned conversions
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketProcessScan(UShellSocketScan_s* const scan,
+                                                 const char* const format,
+                                                 va_list args,
+                                                 size_t* const count);
+
+/**
+ * \brief Take the next item of the input without consuming it
+ * \note The lookahead is refilled by one chunk of the stream when it is drained.
+ * \param[in] scan - input of the scan
+ * \param[out] ch - next item
+ * \param[in] isWaiting - true to wait for the item up to the end of the timeout
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred (USHELL_SOCKET_TIMEOUT_ERR - no input);
+ */
+static UShellSocketErr_e uShellSocketScanPeek(UShellSocketScan_s* const scan,
+                                              char* const ch,
+                                              const bool isWaiting);
+
+/**
+ * \brief Skip the white space of the input
+ * \param[in] scan - input of the scan
+ * \param[in] isWaiting - true to wait for the first item which is not the white space
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred (USHELL_SOCKET_TIMEOUT_ERR - no input);
+ */
+static UShellSocketErr_e uShellSocketScanSpace(UShellSocketScan_s* const scan,
+                                               const bool isWaiting);
+
+/**
+ * \brief Scan the integer
+ * \param[in] scan - input of the scan
+ * \param[in] width - maximum number of the items to be consumed
+ * \param[in] base - base of the number (0 - by the prefix: 0x, 0b, 0 or decimal)
+ * \param[out] value - absolute value (saturated)
+ * \param[out] isNegative - the minus sign is given
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketScanInt(UShellSocketScan_s* const scan,
+                                             size_t width,
+                                             uint8_t base,
+                                             uint64_t* const value,
+                                             bool* const isNegative);
+
+/**
+ * \brief Scan the floating point number ([sign]digits[.digits][e[sign]digits])
+ * \note The result is exact for up to 15 significant digits and the decimal exponent up to 22.
+ * \param[in] scan - input of the scan
+ * \param[in] width - maximum number of the items to be consumed
+ * \param[out] value - scanned value
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketScanFloat(UShellSocketScan_s* const scan,
+                                               size_t width,
+                                               double* const value);
+
+/**
+ * \brief Check the item is the white space
+ * \param[in] ch - item to be checked
+ * \return true - the item is the white space
+ */
+static bool uShellSocketScanIsSpace(const char ch);
+
+/**
+ * \brief Take the value of the digit (bases up to 16)
+ * \param[in] ch - item to be converted
+ * \return value of the digit, 0xFF - the item is not a digit
+ */
+static uint8_t uShellSocketScanDigit(const char ch);
+
+/**
+ * \brief Powers of ten exactly representable by the double (the scaling of the scanned float)
+ */
+static const double uShellSocketScanPow10 [] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
 //=======================================================================[ PUBLIC INTERFACE FUNCTIONS ]=============================================================================
 
 /**
@@ -224,6 +584,8 @@ UShellSocketErr_e UShellSocketWriteBlocking(UShellSocket_s* const socket,
     /* Local variable */
     UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
 
+    uShellSocketWriteLock(socket);
+
     do
     {
         /* Check input parameters */
@@ -251,6 +613,8 @@ UShellSocketErr_e UShellSocketWriteBlocking(UShellSocket_s* const socket,
 
     } while (0);
 
+    uShellSocketWriteUnlock(socket);
+
     return status;
 }
 
@@ -271,6 +635,8 @@ UShellSocketErr_e UShellSocketWrite(UShellSocket_s* const socket,
     /* Local variable */
     UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
 
+    uShellSocketWriteLock(socket);
+
     do
     {
         /* Check input parameters */
@@ -308,6 +674,8 @@ UShellSocketErr_e UShellSocketWrite(UShellSocket_s* const socket,
 
     } while (0);
 
+    uShellSocketWriteUnlock(socket);
+
     return status;
 }
 
@@ -421,6 +789,121 @@ UShellSocketErr_e UShellSocketReadBlocking(UShellSocket_s* const socket,
     return status;
 }
 
+/**
+ * \brief Read all available items (up to size) from the uShell socket object
+ * \note The function waits up to timeout for the first item and does not wait for the rest.
+ * \note This function will return USHELL_SOCKET_TIMEOUT_ERR if no item is available.
+ * \param[in] socket - socket object to be read
+ * \param[out] item - buffer to store the items
+ * \param[in] size - size of the buffer
+ * \param[in] timeout - timeout in milliseconds
+ * \param[out] readCount - number of the items read
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+UShellSocketErr_e UShellSocketReadChunk(UShellSocket_s* const socket,
+                                        UShellSocketItem_t* const item,
+                                        const size_t size,
+                                        const UShellSocketTimeMs_t timeout,
+                                        size_t* const readCount)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+
+    do
+    {
+        /* Check input parameters */
+        if ((socket == NULL) ||
+            (item == NULL) ||
+            (size == 0U) ||
+            (readCount == NULL))
+        {
+            /* Input parameters are invalid */
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Check the type of the socket */
+        if (socket->cfg.type != USHELL_SOCKET_TYPE_READ)
+        {
+            /* Type is invalid */
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_TYPE_ERR;
+            break;
+        }
+
+        /* Read from the stream buffer (empty stream is not an error here) */
+        status = uShellSocketReadAvailable(socket,
+                                           item,
+                                           size,
+                                           timeout,
+                                           false,
+                                           readCount);
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Read all available items (up to size) from the uShell socket object
+ * \note This function is blocking and will wait for the first item to be read.
+ * \param[in] socket - socket object to be read
+ * \param[out] item - buffer to store the items
+ * \param[in] size - size of the buffer
+ * \param[out] readCount - number of the items read
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+UShellSocketErr_e UShellSocketReadChunkBlocking(UShellSocket_s* const socket,
+                                                UShellSocketItem_t* const item,
+                                                const size_t size,
+                                                size_t* const readCount)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+
+    do
+    {
+        /* Check input parameters */
+        if ((socket == NULL) ||
+            (item == NULL) ||
+            (size == 0U) ||
+            (readCount == NULL))
+        {
+            /* Input parameters are invalid */
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Check the type of the socket */
+        if (socket->cfg.type != USHELL_SOCKET_TYPE_READ)
+        {
+            /* Type is invalid */
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_TYPE_ERR;
+            break;
+        }
+
+        /* Read from the stream buffer */
+        status = uShellSocketReadAvailable(socket,
+                                           item,
+                                           size,
+                                           0U,
+                                           true,
+                                           readCount);
+        if (status != USHELL_SOCKET_NO_ERR)
+        {
+            /* Stream buffer is invalid */
+            USHELL_SOCKET_ASSERT(0);
+            break;
+        }
+
+    } while (0);
+
+    return status;
+}
+
 /**
  * \brief Check if the socket is empty
  * \param[in] socket - socket object to be checked
@@ -514,7 +997,7 @@ UShellSocketErr_e UShellSocketPrint(UShellSocket_s* const socket,
         }
 
         /* Process the format string */
-        status = uShellSocketProcessFormat(socket, format, args);
+        status = uShellSocketPrintFormat(socket, format, args);
 
     } while (0);
 
@@ -536,6 +1019,8 @@ UShellSocketErr_e UShellSocketPrintVaList(UShellSocket_s* const socket,
 {
     UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
 
+    uShellSocketWriteLock(socket);
+
     do
     {
         /* Check input parameters */
@@ -555,7 +1040,7 @@ UShellSocketErr_e UShellSocketPrintVaList(UShellSocket_s* const socket,
         }
 
         /* Process the format string */
-        status = uShellSocketProcessFormat(socket, format, args);
+        status = uShellSocketPrintFormat(socket, format, args);
         if (status != USHELL_SOCKET_NO_ERR)
         {
             /* Print failed */
@@ -565,30 +1050,45 @@ UShellSocketErr_e UShellSocketPrintVaList(UShellSocket_s* const socket,
 
     } while (0);
 
+    uShellSocketWriteUnlock(socket);
+
     return status;
 }
 
 /**
- * \brief Scan formatted string from the uShell socket object
- * \param[in] socket - uShell object to be scanned
- * \param[in] format - format string to be scanned
- * \param[out] none
+ * \brief Write several fragments to the uShell socket object as one message
+ * \note The fragments are gathered and committed to the stream by one send with one write callback
+ *       under the lock of the writers, so the message is not split by the other writers. The gathered items are
+ *       sent when the stream has the room for all of them: on the timeout nothing is written.
+ *       The message longer than USHELL_SOCKET_WRITEV_BUFF_SIZE is committed by one send per
+ *       USHELL_SOCKET_WRITEV_BUFF_SIZE items.
+ * \param[in] socket - uShell object to be written
+ * \param[in] vec - fragments of the message (the empty fragments are skipped)
+ * \param[in] num - number of the fragments
+ * \param[in] timeout - timeout in milliseconds
  * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
  */
-UShellSocketErr_e UShellSocketScanf(UShellSocket_s* const socket,
-                                    const char* const format,
-                                    ...)
+UShellSocketErr_e UShellSocketWriteV(UShellSocket_s* const socket,
+                                     const UShellSocketIoVec_s* const vec,
+                                     const size_t num,
+                                     const UShellSocketTimeMs_t timeout)
 {
     /* Local variable */
     UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
-    va_list args;
-    va_start(args, format);
+    UShellSocketItem_t buff [USHELL_SOCKET_WRITEV_BUFF_SIZE];
+    size_t buffLen = 0U;
+    size_t chunkLen = 0U;
+    size_t offset = 0U;
+    size_t ind = 0U;
+
+    uShellSocketWriteLock(socket);
 
     do
     {
         /* Check input parameters */
         if ((socket == NULL) ||
-            (format == NULL))
+            (vec == NULL) ||
+            (num == 0U))
         {
             USHELL_SOCKET_ASSERT(0);
             status = USHELL_SOCKET_INVALID_ARGS_ERR;
@@ -596,419 +1096,456 @@ UShellSocketErr_e UShellSocketScanf(UShellSocket_s* const socket,
         }
 
         /* Check the type of the socket */
-        if (socket->cfg.type != USHELL_SOCKET_TYPE_READ)
+        if (socket->cfg.type != USHELL_SOCKET_TYPE_WRITE)
         {
-            /* Type is invalid */
             USHELL_SOCKET_ASSERT(0);
             status = USHELL_SOCKET_INVALID_TYPE_ERR;
             break;
         }
 
-        /* Iterate through the format string */
-        for (const char* p = format; *p != '\0'; p++)
+        /* Gather the fragments */
+        for (ind = 0U; (ind < num) && (status == USHELL_SOCKET_NO_ERR); ind++)
         {
-            if (*p == '%')    // Handle format specifiers
+            if ((vec [ind].base == NULL) &&
+                (vec [ind].len > 0U))
             {
-                p++;                           // Move to the next character
-                if (*p == 'd' || *p == 'i')    // Decimal integer
-                {
-                    int* value = va_arg(args, int*);
-                    char numStr [12];    // Enough for a 32-bit
-                    snprintf(numStr, sizeof(numStr), "%d", *value);
-                    status = uShellSocketWriteBytesBlock(socket, numStr, strlen(numStr));
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        USHELL_SOCKET_ASSERT(0);
-                        break;
-                    }
-                }
-                else if (*p == 'c')    // Character
-                {
-                    char* value = va_arg(args, char*);
-                    status = uShellSocketWriteBytesBlock(socket, value, 1);
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        USHELL_SOCKET_ASSERT(0);
-                        break;
-                    }
-                }
-                else if (*p == 's')    // String
-                {
-                    char* str = va_arg(args, char*);
-                    status = uShellSocketWriteBytesBlock(socket, str, strlen(str));
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        USHELL_SOCKET_ASSERT(0);
-                        break;
-                    }
-                }
-                else if (*p == 'x' || *p == 'X')    // Hexadecimal
-                {
-                    unsigned int* value = va_arg(args, unsigned int*);
-                    char hexStr [9];    // Enough for a 32-bit hex number
-                    snprintf(hexStr, sizeof(hexStr), "%X", *value);
-                    status = uShellSocketWriteBytesBlock(socket, hexStr, strlen(hexStr));
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        USHELL_SOCKET_ASSERT(0);
-                        break;
-                    }
-                }
+                USHELL_SOCKET_ASSERT(0);
+                status = USHELL_SOCKET_INVALID_ARGS_ERR;
+                break;
+            }
 
-                else if (*p == 'f')    // Float
+            for (offset = 0U; offset < vec [ind].len; offset += chunkLen)
+            {
+                /* Commit the full buffer */
+                if (buffLen >= sizeof(buff))
                 {
-                    double* value = va_arg(args, double*);
-                    char floatStr [32];    // Enough for a double
-                    snprintf(floatStr, sizeof(floatStr), "%f", *value);
-                    status = uShellSocketWriteBytesBlock(socket, floatStr, strlen(floatStr));
+                    status = uShellSocketWriteWhole(socket, buff, buffLen, timeout);
+                    buffLen = 0U;
                     if (status != USHELL_SOCKET_NO_ERR)
                     {
-                        USHELL_SOCKET_ASSERT(0);
                         break;
                     }
                 }
-                else if (*p == 'l')    // Long
-                {
-                    long* value = va_arg(args, long*);
-                    char longStr [32];    // Enough for a long
-                    snprintf(longStr, sizeof(longStr), "%ld", *value);
-                    status = uShellSocketWriteBytesBlock(socket, longStr, strlen(longStr));
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        USHELL_SOCKET_ASSERT(0);
-                        break;
-                    }
-                }
-                else if (*p == 'u')    // Unsigned integer
-                {
-                    unsigned int* value = va_arg(args, unsigned int*);
-                    char uintStr [12];    // Enough for a 32-bit unsigned int
-                    snprintf(uintStr, sizeof(uintStr), "%u", *value);
-                    status = uShellSocketWriteBytesBlock(socket, uintStr, strlen(uintStr));
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        USHELL_SOCKET_ASSERT(0);
-                        break;
-                    }
-                }
-                else if (*p == 'p')    // Pointer
-                {
-                    void** ptr = va_arg(args, void**);
-                    char ptrStr [16];    // Enough for a pointer
-                    snprintf(ptrStr, sizeof(ptrStr), "%p", *ptr);
-                    status = uShellSocketWriteBytesBlock(socket, ptrStr, strlen(ptrStr));
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        USHELL_SOCKET_ASSERT(0);
-                        break;
-                    }
-                }
-                else if (*p == '%')    // Literal '%'
-                {
-                    status = uShellSocketWriteBytesBlock(socket, p, 1);
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        USHELL_SOCKET_ASSERT(0);
-                        break;
-                    }
-                }
-
-                else if (*p == 'b')    // Binary
-                {
-                    unsigned int* value = va_arg(args, unsigned int*);
-                    char binStr [33];    // Enough for a 32-bit binary number
-                    snprintf(binStr, sizeof(binStr), "%u", *value);
-                    status = uShellSocketWriteBytesBlock(socket, binStr, strlen(binStr));
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        USHELL_SOCKET_ASSERT(0);
-                        break;
-                    }
-                }
-                else
-                {
-                    // Unsupported format specifier
-                    USHELL_SOCKET_ASSERT(0);
-                    break;
-                }
-            }
 
-            else    // Regular character
-            {
-                status = uShellSocketWriteBytesBlock(socket, p, 1);
-                if (status != USHELL_SOCKET_NO_ERR)
-                {
-                    USHELL_SOCKET_ASSERT(0);
-                    break;
-                }
+                chunkLen = vec [ind].len - offset;
+                chunkLen = (chunkLen < (sizeof(buff) - buffLen)) ? chunkLen : (sizeof(buff) - buffLen);
+                memcpy(&buff [buffLen], &vec [ind].base [offset], chunkLen);
+                buffLen += chunkLen;
             }
+        }
 
-            /* Check if the write was successful */
-            if (status != USHELL_SOCKET_NO_ERR)
-            {
-                /* Print failed */
-                USHELL_SOCKET_ASSERT(0);
-                break;
-            }
+        /* Commit the rest */
+        if ((status == USHELL_SOCKET_NO_ERR) &&
+            (buffLen > 0U))
+        {
+            status = uShellSocketWriteWhole(socket, buff, buffLen, timeout);
         }
 
     } while (0);
 
-    va_end(args);
+    uShellSocketWriteUnlock(socket);
 
     return status;
 }
 
-//============================================================================ [PRIVATE FUNCTIONS ]=================================================================================
-
 /**
- * \brief Print a block of data to the uShell socket object.
- * \param[in] socket   - uShell socket object.
- * \param[in] data  - pointer to the data to be printed.
- * \param[in] len   - length of the data to send.
- * \return UShellSocketErr_e - error code. non-zero means an error occurred.
+ * \brief Set the lock of the writers of the uShell socket object
+ * \note The lock is taken by every write and print of the socket, so the writes of the several threads
+ *       are not interleaved. The socket without the lock has one writer.
+ * \param[in] socket - uShell object to be written
+ * \param[in] osal - OSAL object of the lock
+ * \param[in] lock - lock of the writers (NULL - no lock)
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
  */
-static UShellSocketErr_e uShellSocketWriteBytesBlock(UShellSocket_s* const socket,
-                                                     const char* data,
-                                                     size_t len)
+UShellSocketErr_e UShellSocketWriteLockSet(UShellSocket_s* const socket,
+                                           UShellOsal_s* const osal,
+                                           const UShellOsalLockObjHandle_t lock)
 {
     /* Local variable */
     UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
-    UShellOsalStreamBuffHandle_t streamBuff = socket->stream;
-    UShellOsal_s* const osal = (UShellOsal_s*) socket->osal;
-    uint8_t* ptr = (uint8_t*) data;
-    size_t totalSent = 0U;
-    size_t remaining = len;
-    size_t chunkSize = 0U;
-    size_t chunkWriteCount = 0U;
 
     do
     {
         /* Check input parameters */
         if ((socket == NULL) ||
-            (streamBuff == NULL) ||
-            (data == NULL) ||
-            (len == 0U))
+            ((lock != NULL) && (osal == NULL)))
         {
-            /* Input parameters are invalid */
             USHELL_SOCKET_ASSERT(0);
             status = USHELL_SOCKET_INVALID_ARGS_ERR;
             break;
         }
 
-        /* Loop to send the data in chunks */
-        while (remaining > 0U)
+        /* Check the type of the socket */
+        if (socket->cfg.type != USHELL_SOCKET_TYPE_WRITE)
         {
-            /* Calculate the chunk size */
-            chunkSize = (remaining < socket->cfg.size)
-                            ? remaining
-                            : socket->cfg.size;
-
-            /* Write to the stream buffer */
-            chunkWriteCount = UShellOsalStreamBuffSendBlocking(osal,
-                                                               streamBuff,
-                                                               (void*) &ptr [totalSent],
-                                                               chunkSize);
-            /* Check if the write was successful */
-            if (chunkWriteCount == 0U)
-            {
-                /* Send error */
-                USHELL_SOCKET_ASSERT(0);
-                status = USHELL_SOCKET_PORT_ERR;
-                break;
-            }
-
-            /* Update the total sent bytes and remaining bytes */
-            totalSent += chunkWriteCount;
-            remaining -= chunkWriteCount;
-
-            /* Call callback function if available */
-            if (socket->cbTable->writeCb != NULL)
-            {
-                socket->cbTable->writeCb(socket, USHELL_SOCKET_CB_TYPE_WRITE, (void*) socket->parent);
-            }
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_TYPE_ERR;
+            break;
         }
 
+        /* Set the lock */
+        socket->writeLockOsal = osal;
+        socket->writeLock = lock;
+
     } while (0);
 
     return status;
 }
 
 /**
- * \brief Print a block of data to the uShell socket object in non-blocking mode
- * \note This function is non-blocking and will return the timeout period.
- * \param[in] socket - uShell object to be printed
- * \param[in] data - item to be printed
- * \param[in] len - size of the item to be printed
- * \param[in] timeout - timeout in milliseconds
- * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ * \brief Reserve the contiguous region to be written in place (zero-copy write)
+ * \note The region is inside the stream when the OSAL port supports it (UShellOsalStreamBuffReserve),
+ *       otherwise it is the staging region of the socket (USHELL_SOCKET_RESERVE_SIZE items)
+ *       which is committed by one send. One reservation per socket is open at a time,
+ *       it is closed by UShellSocketWriteCommit.
+ * \param[in] socket - uShell object to be written
+ * \param[out] region - start of the reserved region
+ * \param[out] size - size of the reserved region (number of the items)
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred (USHELL_SOCKET_OVERFLOW_ERR - the stream is full);
  */
-static UShellSocketErr_e uShellSocketWriteBytesNonBlock(UShellSocket_s* const socket,
-                                                        const char* data,
-                                                        size_t len,
-                                                        UShellSocketTimeMs_t timeout)
+UShellSocketErr_e UShellSocketWriteReserve(UShellSocket_s* const socket,
+                                           UShellSocketItem_t** const region,
+                                           size_t* const size)
 {
     /* Local variable */
     UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
-    UShellOsalStreamBuffHandle_t streamBuff = socket->stream;
-    UShellOsal_s* const osal = (UShellOsal_s*) socket->osal;
-    uint8_t* ptr = (uint8_t*) data;
-    size_t totalSent = 0U;
-    size_t remaining = len;
-    size_t chunkSize = 0U;
-    size_t chunkWriteCount = 0U;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    void* streamRegion = NULL;
+    size_t streamSize = 0U;
 
     do
     {
         /* Check input parameters */
         if ((socket == NULL) ||
-            (streamBuff == NULL) ||
-            (data == NULL) ||
-            (len == 0U))
+            (region == NULL) ||
+            (size == NULL))
         {
-            /* Input parameters are invalid */
             USHELL_SOCKET_ASSERT(0);
             status = USHELL_SOCKET_INVALID_ARGS_ERR;
             break;
         }
 
-        /* Loop to send the data in chunks */
-        while (remaining > 0U)
+        /* Check the type of the socket */
+        if (socket->cfg.type != USHELL_SOCKET_TYPE_WRITE)
         {
-            /* Calculate the chunk size */
-            chunkSize = (remaining < socket->cfg.size)
-                            ? remaining
-                            : socket->cfg.size;
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_TYPE_ERR;
+            break;
+        }
 
-            /* Write to the stream buffer */
-            chunkWriteCount = UShellOsalStreamBuffSend(osal,
-                                                       streamBuff,
-                                                       (void*) &ptr [totalSent],
-                                                       chunkSize,
-                                                       timeout);
-            /* Check if the write was successful */
-            if (chunkWriteCount == 0U)
+        /* The previous reservation must be committed */
+        if (socket->reserveRegion != NULL)
+        {
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Reserve the region inside the stream */
+        osalStatus = UShellOsalStreamBuffReserve(socket->osal,
+                                                 socket->stream,
+                                                 &streamRegion,
+                                                 &streamSize);
+        if (osalStatus == USHELL_OSAL_NO_ERR)
+        {
+            if ((streamRegion == NULL) ||
+                (streamSize == 0U))
             {
-                /* Send error */
-                USHELL_SOCKET_ASSERT(0);
-                status = USHELL_SOCKET_TIMEOUT_ERR;
+                status = USHELL_SOCKET_OVERFLOW_ERR;
                 break;
             }
 
-            /* Update the total sent bytes and remaining bytes */
-            totalSent += chunkWriteCount;
-            remaining -= chunkWriteCount;
-
-            /* Call callback function if available */
-            if (socket->cbTable->writeCb != NULL)
-            {
-                socket->cbTable->writeCb(socket, USHELL_SOCKET_CB_TYPE_WRITE, (void*) socket->parent);
-            }
+            socket->reserveRegion = (UShellSocketItem_t*) streamRegion;
+            socket->reserveSize = streamSize;
+        }
+        else if (osalStatus == USHELL_OSAL_PORT_SPECIFIC_ERR)
+        {
+            /* The port can not reserve, the staging region is used */
+            socket->reserveRegion = socket->reserve;
+            socket->reserveSize = sizeof(socket->reserve);
+        }
+        else
+        {
+            status = USHELL_SOCKET_PORT_ERR;
+            break;
         }
 
+        /* Set the result */
+        *region = socket->reserveRegion;
+        *size = socket->reserveSize;
+
     } while (0);
 
     return status;
 }
 
 /**
- * \brief Read a block of data from the uShell socket object in non-blocking mode
- * \note This function is non-blocking and will return immediately if no data is available.
- * \param[in] socket - uShell object to be read
- * \param[out] data - buffer to store the read data
- * \param[in] len - size of the buffer
- * \param[in] timeout - timeout in milliseconds
+ * \brief Commit the items written into the region reserved by UShellSocketWriteReserve
+ * \note The reservation is closed even if an error has occurred. The zero length only closes it.
+ * \param[in] socket - uShell object to be written
+ * \param[in] len - number of the items written from the start of the region
+ * \param[in] timeout - timeout in milliseconds (the staging region of the socket only)
  * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
  */
-static UShellSocketErr_e uShellSocketReadNonBlock(UShellSocket_s* const socket,
-                                                  char* data,
-                                                  size_t len,
-                                                  UShellSocketTimeMs_t timeout)
+UShellSocketErr_e UShellSocketWriteCommit(UShellSocket_s* const socket,
+                                          const size_t len,
+                                          const UShellSocketTimeMs_t timeout)
 {
     /* Local variable */
     UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
-    UShellOsalStreamBuffHandle_t streamBuff = socket->stream;
-    UShellOsal_s* const osal = (UShellOsal_s*) socket->osal;
-    uint8_t* ptr = (uint8_t*) data;
-    size_t totalReceived = 0U;
-    size_t remaining = len;
-    size_t chunkSize = 0U;
-    size_t chunkReadCount = 0U;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+
+    uShellSocketWriteLock(socket);
 
     do
     {
         /* Check input parameters */
-        if ((socket == NULL) ||
-            (streamBuff == NULL) ||
-            (data == NULL) ||
-            (len == 0U))
+        if (socket == NULL)
         {
-            /* Input parameters are invalid */
             USHELL_SOCKET_ASSERT(0);
             status = USHELL_SOCKET_INVALID_ARGS_ERR;
             break;
         }
 
-        /* Loop to read the data in chunks */
-        while (remaining > 0U)
+        /* Check the reservation */
+        if ((socket->reserveRegion == NULL) ||
+            (len > socket->reserveSize))
         {
-            /* Calculate the chunk size */
-            chunkSize = (remaining < socket->cfg.size)
-                            ? remaining
-                            : socket->cfg.size;
-
-            /* Read from the stream buffer */
-            chunkReadCount = UShellOsalStreamBuffReceive(osal,
-                                                         streamBuff,
-                                                         (void*) &ptr [totalReceived],
-                                                         chunkSize,
-                                                         timeout);
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_ARGS_ERR;
+            break;
+        }
 
-            /* Check if the read was successful */
-            if (chunkReadCount == 0U)
+        /* Commit the items */
+        if (len == 0U)
+        {
+            /* Nothing to commit */
+        }
+        else if (socket->reserveRegion == socket->reserve)
+        {
+            /* The staging region is sent by one send */
+            status = uShellSocketWriteBytesNonBlock(socket,
+                                                    socket->reserve,
+                                                    len,
+                                                    timeout);
+        }
+        else
+        {
+            /* The items are already in the stream */
+            osalStatus = UShellOsalStreamBuffCommit(socket->osal,
+                                                    socket->stream,
+                                                    len);
+            if (osalStatus != USHELL_OSAL_NO_ERR)
             {
-                /* No data received or timeout occurred */
-                status = USHELL_SOCKET_TIMEOUT_ERR;
-                break;
+                status = USHELL_SOCKET_PORT_ERR;
             }
-
-            /* Update the total received bytes and remaining bytes */
-            totalReceived += chunkReadCount;
-            remaining -= chunkReadCount;
-
-            /* Call callback function if available */
-            if (socket->cbTable->readCb != NULL)
+            else
             {
-                socket->cbTable->readCb(socket, USHELL_SOCKET_CB_TYPE_READ, (void*) socket->parent);
+                socket->writeCount += len;
+
+                /* Call callback function if available */
+                if (socket->cbTable->writeCb != NULL)
+                {
+                    socket->cbTable->writeCb(socket, USHELL_SOCKET_CB_TYPE_WRITE, (void*) socket->parent);
+                }
             }
         }
 
+        /* Close the reservation */
+        socket->reserveRegion = NULL;
+        socket->reserveSize = 0U;
+
     } while (0);
 
+    uShellSocketWriteUnlock(socket);
+
     return status;
 }
 
 /**
- * \brief Read a block of data from the uShell socket object in blocking mode
- * \note This function is blocking and will wait for the data to be read.
- * \param[in] socket - uShell object to be read
- * \param[out] data - buffer to store the read data
- * \param[in] len - size of the buffer
- * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ * \brief Format the string into the memory (the same format as UShellSocketPrint)
+ * \note The output is always terminated, the rest of the output which does not fit is truncated.
+ * \param[out] buff - buffer for the output
+ * \param[in] size - size of the buffer (including the terminator)
+ * \param[out] len - length of the output without the terminator (may be NULL)
+ * \param[in] format - format string
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred (USHELL_SOCKET_OVERFLOW_ERR - truncated);
  */
-UShellSocketErr_e uShellSocketReadBlocking(UShellSocket_s* const socket,
-                                           char* data,
-                                           size_t len)
+UShellSocketErr_e UShellSocketFormat(char* const buff,
+                                     const size_t size,
+                                     size_t* const len,
+                                     const char* const format,
+                                     ...)
 {
-    /* Local variable */
     UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
-    UShellOsalStreamBuffHandle_t streamBuff = socket->stream;
-    UShellOsal_s* const osal = (UShellOsal_s*) socket->osal;
-    uint8_t* ptr = (uint8_t*) data;
-    size_t totalReceived = 0U;
-    size_t remaining = len;
-    size_t chunkSize = 0U;
-    size_t chunkReadCount = 0U;
+    va_list args;
+    va_start(args, format);
+
+    status = UShellSocketFormatVaList(buff, size, len, format, args);
+
+    va_end(args);
+    return status;
+}
+
+/**
+ * \brief Format the string into the memory using va_list (the same format as UShellSocketPrint)
+ * \note The output is always terminated, the rest of the output which does not fit is truncated.
+ * \param[out] buff - buffer for the output
+ * \param[in] size - size of the buffer (including the terminator)
+ * \param[out] len - length of the output without the terminator (may be NULL)
+ * \param[in] format - format string
+ * \param[in] args - va_list of arguments
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred (USHELL_SOCKET_OVERFLOW_ERR - truncated);
+ */
+UShellSocketErr_e UShellSocketFormatVaList(char* const buff,
+                                           const size_t size,
+                                           size_t* const len,
+                                           const char* const format,
+                                           va_list args)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellSocketPrintBuff_s printBuff = {.socket = NULL, .buff = buff, .size = 0U, .len = 0U};
+
+    do
+    {
+        /* Check input parameters */
+        if ((buff == NULL) ||
+            (size == 0U) ||
+            (format == NULL))
+        {
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Keep the place for the terminator */
+        printBuff.size = size - 1U;
+        status = uShellSocketProcessFormat(&printBuff, format, args);
+        buff [printBuff.len] = '\0';
+
+        if (len != NULL)
+        {
+            *len = printBuff.len;
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Scan formatted input from the uShell socket object
+ * \note The input is taken from the stream in chunks, the items which are not consumed
+ *       stay in the socket for the next scan.
+ * \param[in] socket - uShell object to be scanned
+ * \param[in] timeout - time the input is waited for (milliseconds, the whole call)
+ * \param[out] count - number of the assigned conversions (may be NULL)
+ * \param[in] format - format string to be scanned
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+UShellSocketErr_e UShellSocketScanf(UShellSocket_s* const socket,
+                                    const UShellSocketTimeMs_t timeout,
+                                    size_t* const count,
+                                    const char* const format,
+                                    ...)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    va_list args;
+    va_start(args, format);
+
+    status = UShellSocketScanfVaList(socket, timeout, count, format, args);
+
+    va_end(args);
+
+    return status;
+}
+
+/**
+ * \brief Scan formatted input from the uShell socket object using va_list
+ * \param[in] socket - uShell object to be scanned
+ * \param[in] timeout - time the input is waited for (milliseconds, the whole call)
+ * \param[out] count - number of the assigned conversions (may be NULL)
+ * \param[in] format - format string to be scanned
+ * \param[in] args - va_list of the pointers to the results
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+UShellSocketErr_e UShellSocketScanfVaList(UShellSocket_s* const socket,
+                                          const UShellSocketTimeMs_t timeout,
+                                          size_t* const count,
+                                          const char* const format,
+                                          va_list args)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellSocketScan_s scan = {0};
+    size_t assigned = 0U;
+
+    do
+    {
+        /* Check input parameters */
+        if ((socket == NULL) ||
+            (format == NULL))
+        {
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Check the type of the socket */
+        if (socket->cfg.type != USHELL_SOCKET_TYPE_READ)
+        {
+            /* Type is invalid */
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_TYPE_ERR;
+            break;
+        }
+
+        /* The timeout is counted from here */
+        if (UShellOsalTimeMsGet(socket->osal, &scan.start) != USHELL_OSAL_NO_ERR)
+        {
+            status = USHELL_SOCKET_PORT_ERR;
+            break;
+        }
+        scan.socket = socket;
+        scan.timeout = timeout;
+
+        /* Scan the input */
+        status = uShellSocketProcessScan(&scan, format, args, &assigned);
+
+    } while (0);
+
+    if (count != NULL)
+    {
+        *count = assigned;
+    }
+
+    return status;
+}
+
+//============================================================================ [PRIVATE FUNCTIONS ]=================================================================================
+
+/**
+ * \brief Print a block of data to the uShell socket object.
+ * \param[in] socket   - uShell socket object.
+ * \param[in] data  - pointer to the data to be printed.
+ * \param[in] len   - length of the data to send.
+ * \return UShellSocketErr_e - error code. non-zero means an error occurred.
+ */
+static UShellSocketErr_e uShellSocketWriteBytesBlock(UShellSocket_s* const socket,
+                                                     const char* data,
+                                                     size_t len)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellOsalStreamBuffHandle_t streamBuff = socket->stream;
+    UShellOsal_s* const osal = (UShellOsal_s*) socket->osal;
+    uint8_t* ptr = (uint8_t*) data;
+    size_t totalSent = 0U;
+    size_t remaining = len;
+    size_t chunkSize = 0U;
+    size_t chunkWriteCount = 0U;
 
     do
     {
@@ -1024,7 +1561,7 @@ UShellSocketErr_e uShellSocketReadBlocking(UShellSocket_s* const socket,
             break;
         }
 
-        /* Loop to read the data in chunks */
+        /* Loop to send the data in chunks */
         while (remaining > 0U)
         {
             /* Calculate the chunk size */
@@ -1032,28 +1569,44 @@ UShellSocketErr_e uShellSocketReadBlocking(UShellSocket_s* const socket,
                             ? remaining
                             : socket->cfg.size;
 
-            /* Read from the stream buffer */
-            chunkReadCount = UShellOsalStreamBuffReceiveBlocking(osal,
-                                                                 streamBuff,
-                                                                 (void*) &ptr [totalReceived],
-                                                                 chunkSize);
+            /* Write to the stream buffer (the no wait socket takes only what fits) */
+            chunkWriteCount = (socket->cfg.noWait == true)
+                                  ? UShellOsalStreamBuffSend(osal,
+                                                             streamBuff,
+                                                             (void*) &ptr [totalSent],
+                                                             chunkSize,
+                                                             0U)
+                                  : UShellOsalStreamBuffSendBlocking(osal,
+                                                                     streamBuff,
+                                                                     (void*) &ptr [totalSent],
+                                                                     chunkSize);
+            /* Check if the write was successful */
+            if ((chunkWriteCount == 0U) &&
+                (socket->cfg.noWait == true))
+            {
+                /* The stream is full, drop the rest */
+                socket->dropCount += remaining;
+                status = USHELL_SOCKET_OVERFLOW_ERR;
+                break;
+            }
 
-            /* Check if the read was successful */
-            if (chunkReadCount == 0U)
+            if (chunkWriteCount == 0U)
             {
-                /* No data received or timeout occurred */
+                /* Send error */
+                USHELL_SOCKET_ASSERT(0);
                 status = USHELL_SOCKET_PORT_ERR;
                 break;
             }
 
-            /* Update the total received bytes and remaining bytes */
-            totalReceived += chunkReadCount;
-            remaining -= chunkReadCount;
+            /* Update the total sent bytes and remaining bytes */
+            totalSent += chunkWriteCount;
+            remaining -= chunkWriteCount;
+            socket->writeCount += chunkWriteCount;
 
             /* Call callback function if available */
-            if (socket->cbTable->readCb != NULL)
+            if (socket->cbTable->writeCb != NULL)
             {
-                socket->cbTable->readCb(socket, USHELL_SOCKET_CB_TYPE_READ, (void*) socket->parent);
+                socket->cbTable->writeCb(socket, USHELL_SOCKET_CB_TYPE_WRITE, (void*) socket->parent);
             }
         }
 
@@ -1063,126 +1616,1982 @@ UShellSocketErr_e uShellSocketReadBlocking(UShellSocket_s* const socket,
 }
 
 /**
- * \brief Process the format string and write to the uShell socket object
- * \param[in] socket - uShell object to be processed
- * \param[in] format - format string
- * \param[in] args - variable arguments list
+ * \brief Print a block of data to the uShell socket object in non-blocking mode
+ * \note This function is non-blocking and will return the timeout period.
+ * \param[in] socket - uShell object to be printed
+ * \param[in] data - item to be printed
+ * \param[in] len - size of the item to be printed
+ * \param[in] timeout - timeout in milliseconds
  * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
  */
-static UShellSocketErr_e uShellSocketProcessFormat(UShellSocket_s* const socket,
-                                                   const char* const format,
-                                                   va_list args)
+static UShellSocketErr_e uShellSocketWriteBytesNonBlock(UShellSocket_s* const socket,
+                                                        const char* data,
+                                                        size_t len,
+                                                        UShellSocketTimeMs_t timeout)
 {
+    /* Local variable */
     UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellOsalStreamBuffHandle_t streamBuff = socket->stream;
+    UShellOsal_s* const osal = (UShellOsal_s*) socket->osal;
+    uint8_t* ptr = (uint8_t*) data;
+    size_t totalSent = 0U;
+    size_t remaining = len;
+    size_t chunkSize = 0U;
+    size_t chunkWriteCount = 0U;
 
-    /* Iterate through the format string */
-    for (const char* p = format; *p != '\0'; p++)
+    do
     {
-        if (*p == '%')    // Handle format specifiers
+        /* Check input parameters */
+        if ((socket == NULL) ||
+            (streamBuff == NULL) ||
+            (data == NULL) ||
+            (len == 0U))
+        {
+            /* Input parameters are invalid */
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Loop to send the data in chunks */
+        while (remaining > 0U)
         {
-            p++;                           // Move to the next character
-            if (*p == 'd' || *p == 'i')    // Decimal integer
+            /* Calculate the chunk size */
+            chunkSize = (remaining < socket->cfg.size)
+                            ? remaining
+                            : socket->cfg.size;
+
+            /* Write to the stream buffer */
+            chunkWriteCount = UShellOsalStreamBuffSend(osal,
+                                                       streamBuff,
+                                                       (void*) &ptr [totalSent],
+                                                       chunkSize,
+                                                       timeout);
+            /* Check if the write was successful */
+            if (chunkWriteCount == 0U)
             {
-                int value = va_arg(args, int);
-                char numStr [12];    // Enough for a 32-bit integer
-                snprintf(numStr, sizeof(numStr), "%d", value);
-                for (char* np = numStr; *np != '\0'; np++)
-                {
-                    status = uShellSocketWriteBytesBlock(socket, np, 1);
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        return status;
-                    }
-                }
+                /* Send error */
+                USHELL_SOCKET_ASSERT(0);
+                status = USHELL_SOCKET_TIMEOUT_ERR;
+                break;
             }
-            else if (*p == 'u')    // Unsigned integer
+
+            /* Update the total sent bytes and remaining bytes */
+            totalSent += chunkWriteCount;
+            remaining -= chunkWriteCount;
+            socket->writeCount += chunkWriteCount;
+
+            /* Call callback function if available */
+            if (socket->cbTable->writeCb != NULL)
             {
-                unsigned int value = va_arg(args, unsigned int);
-                char uintStr [12];    // Enough for a 32-bit unsigned integer
-                snprintf(uintStr, sizeof(uintStr), "%u", value);
-                for (char* up = uintStr; *up != '\0'; up++)
-                {
-                    status = uShellSocketWriteBytesBlock(socket, up, 1);
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        return status;
-                    }
-                }
+                socket->cbTable->writeCb(socket, USHELL_SOCKET_CB_TYPE_WRITE, (void*) socket->parent);
             }
-            else if (*p == 'c')    // Character
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Write a block of data to the uShell socket object at once (all items or nothing)
+ * \note The free space of the stream is checked every USHELL_SOCKET_WRITEV_POLL_MS until the block fits it
+ *       or the timeout is over. The writers hold the lock of the socket and the reader only frees the space,
+ *       so the block which fits is sent completely.
+ * \param[in] socket - uShell object to be written
+ * \param[in] data - items to be written
+ * \param[in] len - number of the items
+ * \param[in] timeout - timeout in milliseconds
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred (USHELL_SOCKET_TIMEOUT_ERR - nothing is written);
+ */
+static UShellSocketErr_e uShellSocketWriteWhole(UShellSocket_s* const socket,
+                                                const char* data,
+                                                size_t len,
+                                                UShellSocketTimeMs_t timeout)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellOsal_s* const osal = (UShellOsal_s*) socket->osal;
+    UShellOsalTimeMs_t start = 0U;
+    UShellOsalTimeMs_t now = 0U;
+    size_t space = 0U;
+
+    do
+    {
+        /* The timeout is counted from here */
+        if (UShellOsalTimeMsGet(osal, &start) != USHELL_OSAL_NO_ERR)
+        {
+            status = USHELL_SOCKET_PORT_ERR;
+            break;
+        }
+
+        /* Wait for the room of the whole block */
+        while (status == USHELL_SOCKET_NO_ERR)
+        {
+            if (UShellOsalStreamBuffSpaceGet(osal, socket->stream, &space) != USHELL_OSAL_NO_ERR)
             {
-                char value = (char) va_arg(args, int);
-                status = uShellSocketWriteBytesBlock(socket, &value, 1);
-                if (status != USHELL_SOCKET_NO_ERR)
-                {
-                    return status;
-                }
+                status = USHELL_SOCKET_PORT_ERR;
+                break;
             }
-            else if (*p == 's')    // String
+
+            if (space >= len)
             {
-                const char* str = va_arg(args, const char*);
-                while (*str != '\0')
-                {
-                    status = uShellSocketWriteBytesBlock(socket, str, 1);
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        return status;
-                    }
-                    str++;
-                }
+                break;
             }
-            else if (*p == 'x' || *p == 'X')    // Hexadecimal
+
+            if (UShellOsalTimeMsGet(osal, &now) != USHELL_OSAL_NO_ERR)
             {
-                unsigned int value = va_arg(args, unsigned int);
-                char hexStr [9];    // Enough for a 32-bit hex number
-                snprintf(hexStr, sizeof(hexStr), "%X", value);
-                for (char* hp = hexStr; *hp != '\0'; hp++)
-                {
-                    status = uShellSocketWriteBytesBlock(socket, hp, 1);
-                    if (status != USHELL_SOCKET_NO_ERR)
-                    {
-                        return status;
-                    }
-                }
+                status = USHELL_SOCKET_PORT_ERR;
+                break;
+            }
+
+            if ((UShellSocketTimeMs_t) (UShellOsalTimeMs_t) (now - start) >= timeout)
+            {
+                status = USHELL_SOCKET_TIMEOUT_ERR;
+                break;
+            }
+
+            UShellOsalThreadDelay(osal, USHELL_SOCKET_WRITEV_POLL_MS);
+        }
+        if (status != USHELL_SOCKET_NO_ERR)
+        {
+            break;
+        }
+
+        /* The block fits the stream, it is sent without the wait */
+        status = uShellSocketWriteBytesNonBlock(socket, data, len, timeout);
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Take the lock of the writers of the socket (if it is set)
+ * \param[in] socket - uShell object to be written (may be NULL)
+ * \return none
+ */
+static void uShellSocketWriteLock(UShellSocket_s* const socket)
+{
+    if ((socket != NULL) &&
+        (socket->writeLock != NULL))
+    {
+        UShellOsalLock(socket->writeLockOsal, socket->writeLock);
+    }
+}
+
+/**
+ * \brief Release the lock of the writers of the socket (if it is set)
+ * \param[in] socket - uShell object to be written (may be NULL)
+ * \return none
+ */
+static void uShellSocketWriteUnlock(UShellSocket_s* const socket)
+{
+    if ((socket != NULL) &&
+        (socket->writeLock != NULL))
+    {
+        UShellOsalUnlock(socket->writeLockOsal, socket->writeLock);
+    }
+}
+
+/**
+ * \brief Read a block of data from the uShell socket object in non-blocking mode
+ * \note This function is non-blocking and will return immediately if no data is available.
+ * \param[in] socket - uShell object to be read
+ * \param[out] data - buffer to store the read data
+ * \param[in] len - size of the buffer
+ * \param[in] timeout - timeout in milliseconds
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketReadNonBlock(UShellSocket_s* const socket,
+                                                  char* data,
+                                                  size_t len,
+                                                  UShellSocketTimeMs_t timeout)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellOsalStreamBuffHandle_t streamBuff = socket->stream;
+    UShellOsal_s* const osal = (UShellOsal_s*) socket->osal;
+    uint8_t* ptr = (uint8_t*) data;
+    size_t totalReceived = 0U;
+    size_t remaining = len;
+    size_t chunkSize = 0U;
+    size_t chunkReadCount = 0U;
+
+    do
+    {
+        /* Check input parameters */
+        if ((socket == NULL) ||
+            (streamBuff == NULL) ||
+            (data == NULL) ||
+            (len == 0U))
+        {
+            /* Input parameters are invalid */
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Loop to read the data in chunks */
+        while (remaining > 0U)
+        {
+            /* Calculate the chunk size */
+            chunkSize = (remaining < socket->cfg.size)
+                            ? remaining
+                            : socket->cfg.size;
+
+            /* Read from the stream buffer */
+            chunkReadCount = UShellOsalStreamBuffReceive(osal,
+                                                         streamBuff,
+                                                         (void*) &ptr [totalReceived],
+                                                         chunkSize,
+                                                         timeout);
+
+            /* Check if the read was successful */
+            if (chunkReadCount == 0U)
+            {
+                /* No data received or timeout occurred */
+                status = USHELL_SOCKET_TIMEOUT_ERR;
+                break;
+            }
+
+            /* Update the total received bytes and remaining bytes */
+            totalReceived += chunkReadCount;
+            remaining -= chunkReadCount;
+
+            /* Call callback function if available */
+            if (socket->cbTable->readCb != NULL)
+            {
+                socket->cbTable->readCb(socket, USHELL_SOCKET_CB_TYPE_READ, (void*) socket->parent);
+            }
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Read a block of data from the uShell socket object in blocking mode
+ * \note This function is blocking and will wait for the data to be read.
+ * \param[in] socket - uShell object to be read
+ * \param[out] data - buffer to store the read data
+ * \param[in] len - size of the buffer
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+UShellSocketErr_e uShellSocketReadBlocking(UShellSocket_s* const socket,
+                                           char* data,
+                                           size_t len)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellOsalStreamBuffHandle_t streamBuff = socket->stream;
+    UShellOsal_s* const osal = (UShellOsal_s*) socket->osal;
+    uint8_t* ptr = (uint8_t*) data;
+    size_t totalReceived = 0U;
+    size_t remaining = len;
+    size_t chunkSize = 0U;
+    size_t chunkReadCount = 0U;
+
+    do
+    {
+        /* Check input parameters */
+        if ((socket == NULL) ||
+            (streamBuff == NULL) ||
+            (data == NULL) ||
+            (len == 0U))
+        {
+            /* Input parameters are invalid */
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Loop to read the data in chunks */
+        while (remaining > 0U)
+        {
+            /* Calculate the chunk size */
+            chunkSize = (remaining < socket->cfg.size)
+                            ? remaining
+                            : socket->cfg.size;
+
+            /* Read from the stream buffer (the no wait socket takes only what is there) */
+            chunkReadCount = (socket->cfg.noWait == true)
+                                 ? UShellOsalStreamBuffReceive(osal,
+                                                               streamBuff,
+                                                               (void*) &ptr [totalReceived],
+                                                               chunkSize,
+                                                               0U)
+                                 : UShellOsalStreamBuffReceiveBlocking(osal,
+                                                                       streamBuff,
+                                                                       (void*) &ptr [totalReceived],
+                                                                       chunkSize);
+
+            /* Check if the read was successful */
+            if (chunkReadCount == 0U)
+            {
+                /* No data received (the no wait socket is drained) */
+                status = (socket->cfg.noWait == true)
+                             ? USHELL_SOCKET_EMPTY_ERR
+                             : USHELL_SOCKET_PORT_ERR;
+                break;
+            }
+
+            /* Update the total received bytes and remaining bytes */
+            totalReceived += chunkReadCount;
+            remaining -= chunkReadCount;
+
+            /* Call callback function if available */
+            if (socket->cbTable->readCb != NULL)
+            {
+                socket->cbTable->readCb(socket, USHELL_SOCKET_CB_TYPE_READ, (void*) socket->parent);
+            }
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Read all available data (up to len) from the uShell socket object
+ * \param[in] socket - uShell object to be read
+ * \param[out] data - buffer to store the read data
+ * \param[in] len - size of the buffer
+ * \param[in] timeout - timeout in milliseconds (ignored in the blocking mode)
+ * \param[in] isBlocking - true to wait for the first item without timeout
+ * \param[out] readCount - number of the items read
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketReadAvailable(UShellSocket_s* const socket,
+                                                   char* data,
+                                                   size_t len,
+                                                   UShellSocketTimeMs_t timeout,
+                                                   bool isBlocking,
+                                                   size_t* const readCount)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellOsalStreamBuffHandle_t streamBuff = socket->stream;
+    UShellOsal_s* const osal = (UShellOsal_s*) socket->osal;
+    size_t chunkSize = 0U;
+
+    do
+    {
+        /* Check input parameters */
+        if ((socket == NULL) ||
+            (streamBuff == NULL) ||
+            (data == NULL) ||
+            (len == 0U) ||
+            (readCount == NULL))
+        {
+            /* Input parameters are invalid */
+            USHELL_SOCKET_ASSERT(0);
+            status = USHELL_SOCKET_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Calculate the chunk size */
+        chunkSize = (len < socket->cfg.size)
+                        ? len
+                        : socket->cfg.size;
+
+        /* The no wait socket does not wait even in the blocking mode */
+        isBlocking = (isBlocking == true) &&
+                     (socket->cfg.noWait == false);
+
+        /* One receive returns everything the stream holds (up to the chunk size) */
+        *readCount = (isBlocking == true)
+                         ? UShellOsalStreamBuffReceiveBlocking(osal,
+                                                               streamBuff,
+                                                               (void*) data,
+                                                               chunkSize)
+                         : UShellOsalStreamBuffReceive(osal,
+                                                       streamBuff,
+                                                       (void*) data,
+                                                       chunkSize,
+                                                       timeout);
+
+        /* Check if the read was successful */
+        if (*readCount == 0U)
+        {
+            /* No data received or timeout occurred */
+            status = (isBlocking == true)
+                         ? USHELL_SOCKET_PORT_ERR
+                         : (socket->cfg.noWait == true)
+                               ? USHELL_SOCKET_EMPTY_ERR
+                               : USHELL_SOCKET_TIMEOUT_ERR;
+            break;
+        }
+
+        /* Call callback function if available */
+        if (socket->cbTable->readCb != NULL)
+        {
+            socket->cbTable->readCb(socket, USHELL_SOCKET_CB_TYPE_READ, (void*) socket->parent);
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Process the format string and put the output into the staging buffer
+ * \note The caller flushes the staging buffer.
+ * \param[in] printBuff - staging buffer
+ * \param[in] format - format string
+ * \param[in] args - variable arguments list
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketProcessFormat(UShellSocketPrintBuff_s* const printBuff,
+                                                   const char* const format,
+                                                   va_list args)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellSocketFmtSpec_s spec = {0};
+    const char* literal = NULL;
+    char length = '\0';
+    int64_t sValue = 0;
+    uint64_t uValue = 0U;
+    char ch = '\0';
+    const char* str = NULL;
+    int strLen = 0;
+
+    /* Iterate through the format string */
+    for (const char* p = format; (*p != '\0') && (status == USHELL_SOCKET_NO_ERR); p++)
+    {
+        if (*p != '%')    // Regular characters
+        {
+            /* Take the whole run of the literal characters at once */
+            literal = p;
+            while ((p [1] != '\0') &&
+                   (p [1] != '%'))
+            {
+                p++;
+            }
+            status = uShellSocketPrintBuffPut(printBuff, literal, (size_t) (p - literal) + 1U);
+            continue;
+        }
+
+        /* Flags */
+        spec.flags = USHELL_SOCKET_FMT_FLAG_NONE;
+        for (p++;; p++)
+        {
+            if (*p == '-')
+            {
+                spec.flags |= USHELL_SOCKET_FMT_FLAG_LEFT;
+            }
+            else if (*p == '0')
+            {
+                spec.flags |= USHELL_SOCKET_FMT_FLAG_ZERO;
+            }
+            else if (*p == '+')
+            {
+                spec.flags |= USHELL_SOCKET_FMT_FLAG_PLUS;
+            }
+            else if (*p == ' ')
+            {
+                spec.flags |= USHELL_SOCKET_FMT_FLAG_SPACE;
+            }
+            else if (*p == '#')
+            {
+                spec.flags |= USHELL_SOCKET_FMT_FLAG_ALT;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        /* Width (the negative width from the argument means the left justify) */
+        spec.width = 0;
+        if (*p == '*')
+        {
+            spec.width = va_arg(args, int);
+            if (spec.width < 0)
+            {
+                spec.flags |= USHELL_SOCKET_FMT_FLAG_LEFT;
+                spec.width = -spec.width;
+            }
+            p++;
+        }
+        while ((*p >= '0') && (*p <= '9'))
+        {
+            spec.width = (spec.width * 10) + (*p - '0');
+            p++;
+        }
+
+        /* Precision (the negative precision from the argument means no precision) */
+        spec.precision = -1;
+        if (*p == '.')
+        {
+            p++;
+            spec.precision = 0;
+            if (*p == '*')
+            {
+                spec.precision = va_arg(args, int);
+                spec.precision = (spec.precision < 0) ? -1 : spec.precision;
+                p++;
+            }
+            while ((*p >= '0') && (*p <= '9'))
+            {
+                spec.precision = (spec.precision * 10) + (*p - '0');
+                p++;
+            }
+        }
+
+        /* Length (hh and ll are kept as 'H' and 'L') */
+        length = '\0';
+        if ((*p == 'h') || (*p == 'l') || (*p == 'z') || (*p == 'j') || (*p == 't'))
+        {
+            length = *p++;
+            if ((length == 'h') && (*p == 'h'))
+            {
+                length = 'H';
+                p++;
+            }
+            else if ((length == 'l') && (*p == 'l'))
+            {
+                length = 'L';
+                p++;
+            }
+        }
+
+        /* Conversion */
+        switch (*p)
+        {
+            case 'd' :
+            case 'i' :
+            {
+                /* Take the signed argument of the given length */
+                switch (length)
+                {
+                    case 'H' : sValue = (signed char) va_arg(args, int); break;
+                    case 'h' : sValue = (short) va_arg(args, int); break;
+                    case 'l' : sValue = va_arg(args, long); break;
+                    case 'L' : sValue = va_arg(args, long long); break;
+                    case 'z' : sValue = va_arg(args, ptrdiff_t); break;
+                    case 't' : sValue = va_arg(args, ptrdiff_t); break;
+                    case 'j' : sValue = va_arg(args, intmax_t); break;
+                    default : sValue = va_arg(args, int); break;
+                }
+
+                /* The absolute value of the minimum is taken in the unsigned type */
+                uValue = (sValue < 0) ? (0U - (uint64_t) sValue) : (uint64_t) sValue;
+                status = uShellSocketFmtInt(printBuff, &spec, uValue, (sValue < 0), 'd');
+                break;
+            }
+
+            case 'u' :
+            case 'x' :
+            case 'X' :
+            case 'o' :
+            case 'b' :
+            {
+                /* Take the unsigned argument of the given length */
+                switch (length)
+                {
+                    case 'H' : uValue = (unsigned char) va_arg(args, unsigned int); break;
+                    case 'h' : uValue = (unsigned short) va_arg(args, unsigned int); break;
+                    case 'l' : uValue = va_arg(args, unsigned long); break;
+                    case 'L' : uValue = va_arg(args, unsigned long long); break;
+                    case 'z' : uValue = va_arg(args, size_t); break;
+                    case 't' : uValue = (uint64_t) va_arg(args, ptrdiff_t); break;
+                    case 'j' : uValue = va_arg(args, uintmax_t); break;
+                    default : uValue = va_arg(args, unsigned int); break;
+                }
+
+                status = uShellSocketFmtInt(printBuff, &spec, uValue, false, *p);
+                break;
+            }
+
+            case 'p' :
+            {
+                uValue = (uint64_t) (uintptr_t) va_arg(args, void*);
+                status = uShellSocketFmtInt(printBuff, &spec, uValue, false, 'p');
+                break;
+            }
+
+            case 'c' :
+            {
+                ch = (char) va_arg(args, int);
+                spec.flags &= ~(uint32_t) USHELL_SOCKET_FMT_FLAG_ZERO;
+                status = uShellSocketFmtField(printBuff, &spec, NULL, &ch, 1, 0);
+                break;
+            }
+
+            case 's' :
+            {
+                /* The precision limits the number of the printed items */
+                str = va_arg(args, const char*);
+                str = (str == NULL) ? "(null)" : str;
+                strLen = 0;
+                while ((str [strLen] != '\0') &&
+                       ((spec.precision < 0) || (strLen < spec.precision)))
+                {
+                    strLen++;
+                }
+                spec.flags &= ~(uint32_t) USHELL_SOCKET_FMT_FLAG_ZERO;
+                status = uShellSocketFmtField(printBuff, &spec, NULL, str, strLen, 0);
+                break;
+            }
+
+            case 'f' :
+            case 'F' :
+            {
+                status = uShellSocketFmtFloat(printBuff, &spec, va_arg(args, double));
+                break;
+            }
+
+            case '%' :
+            {
+                status = uShellSocketPrintBuffPut(printBuff, p, 1U);
+                break;
+            }
+
+            default :
+            {
+                // Unsupported format specifier
+                USHELL_SOCKET_ASSERT(0);
+                status = USHELL_SOCKET_INVALID_ARGS_ERR;
+                break;
+            }
+        }
+
+        /* The format string ends inside the specification */
+        if (*p == '\0')
+        {
+            break;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * \brief Print formatted string to the socket through the staging buffer on the stack
+ * \param[in] socket - uShell object to be printed
+ * \param[in] format - format string
+ * \param[in] args - variable arguments list
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketPrintFormat(UShellSocket_s* const socket,
+                                                 const char* const format,
+                                                 va_list args)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    char buff [USHELL_SOCKET_PRINT_BUFF_SIZE];
+    UShellSocketPrintBuff_s printBuff = {.socket = socket, .buff = buff, .size = sizeof(buff), .len = 0U};
+
+    /* Collect the output */
+    status = uShellSocketProcessFormat(&printBuff, format, args);
+
+    /* Write the rest (what was collected before the error is written as well) */
+    if (status == USHELL_SOCKET_NO_ERR)
+    {
+        status = uShellSocketPrintBuffFlush(&printBuff);
+    }
+    else
+    {
+        uShellSocketPrintBuffFlush(&printBuff);
+    }
+
+    return status;
+}
+
+/**
+ * \brief Put the items into the staging buffer (the full buffer is written to the socket)
+ * \param[in] printBuff - staging buffer
+ * \param[in] data - items to be put
+ * \param[in] len - number of the items
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketPrintBuffPut(UShellSocketPrintBuff_s* const printBuff,
+                                                  const char* data,
+                                                  size_t len)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    size_t chunkLen = 0U;
+
+    while ((len > 0U) &&
+           (status == USHELL_SOCKET_NO_ERR))
+    {
+        /* Write the full buffer */
+        if (printBuff->len >= printBuff->size)
+        {
+            status = uShellSocketPrintBuffFlush(printBuff);
+            continue;
+        }
+
+        /* Copy as much as fits */
+        chunkLen = printBuff->size - printBuff->len;
+        chunkLen = (len < chunkLen) ? len : chunkLen;
+        memcpy(&printBuff->buff [printBuff->len], data, chunkLen);
+        printBuff->len += chunkLen;
+        data += chunkLen;
+        len -= chunkLen;
+    }
+
+    return status;
+}
+
+/**
+ * \brief Write the collected items of the staging buffer to the socket
+ * \param[in] printBuff - staging buffer
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketPrintBuffFlush(UShellSocketPrintBuff_s* const printBuff)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+
+    do
+    {
+        /* The memory output can not be flushed, the rest is truncated */
+        if (printBuff->socket == NULL)
+        {
+            status = (printBuff->len >= printBuff->size) ? USHELL_SOCKET_OVERFLOW_ERR : USHELL_SOCKET_NO_ERR;
+            break;
+        }
+
+        /* Check we have anything to write */
+        if (printBuff->len == 0U)
+        {
+            break;
+        }
+
+        status = uShellSocketWriteBytesBlock(printBuff->socket,
+                                             printBuff->buff,
+                                             printBuff->len);
+        printBuff->len = 0U;
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Put the same item into the staging buffer several times (the padding)
+ * \param[in] printBuff - staging buffer
+ * \param[in] item - item to be put
+ * \param[in] count - number of the items
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketPrintBuffFill(UShellSocketPrintBuff_s* const printBuff,
+                                                   const char item,
+                                                   int count)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+
+    while ((count > 0) &&
+           (status == USHELL_SOCKET_NO_ERR))
+    {
+        /* Write the full buffer */
+        if (printBuff->len >= printBuff->size)
+        {
+            status = uShellSocketPrintBuffFlush(printBuff);
+            continue;
+        }
+
+        printBuff->buff [printBuff->len++] = item;
+        count--;
+    }
+
+    return status;
+}
+
+/**
+ * \brief Put the converted field into the staging buffer with the padding of the specification
+ * \param[in] printBuff - staging buffer
+ * \param[in] spec - conversion specification
+ * \param[in] prefix - sign and/or base prefix (may be NULL)
+ * \param[in] digits - converted digits
+ * \param[in] digitsLen - number of the digits
+ * \param[in] zeros - number of the leading zeros required by the precision
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketFmtField(UShellSocketPrintBuff_s* const printBuff,
+                                              const UShellSocketFmtSpec_s* const spec,
+                                              const char* const prefix,
+                                              const char* const digits,
+                                              const int digitsLen,
+                                              const int zeros)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    int prefixLen = (prefix != NULL) ? (int) strlen(prefix) : 0;
+    int pad = spec->width - (prefixLen + zeros + digitsLen);
+    pad = (pad > 0) ? pad : 0;
+
+    do
+    {
+        /* Right justify by spaces */
+        if ((spec->flags & (USHELL_SOCKET_FMT_FLAG_LEFT | USHELL_SOCKET_FMT_FLAG_ZERO)) == 0U)
+        {
+            status = uShellSocketPrintBuffFill(printBuff, ' ', pad);
+            if (status != USHELL_SOCKET_NO_ERR)
+            {
+                break;
+            }
+        }
+
+        /* Sign and base prefix */
+        if (prefixLen > 0)
+        {
+            status = uShellSocketPrintBuffPut(printBuff, prefix, (size_t) prefixLen);
+            if (status != USHELL_SOCKET_NO_ERR)
+            {
+                break;
+            }
+        }
+
+        /* Right justify by zeros (after the prefix) */
+        if ((spec->flags & (USHELL_SOCKET_FMT_FLAG_LEFT | USHELL_SOCKET_FMT_FLAG_ZERO)) == USHELL_SOCKET_FMT_FLAG_ZERO)
+        {
+            status = uShellSocketPrintBuffFill(printBuff, '0', pad);
+            if (status != USHELL_SOCKET_NO_ERR)
+            {
+                break;
+            }
+        }
+
+        /* Zeros of the precision and the digits */
+        status = uShellSocketPrintBuffFill(printBuff, '0', zeros);
+        if ((status != USHELL_SOCKET_NO_ERR) ||
+            ((digitsLen > 0) &&
+             ((status = uShellSocketPrintBuffPut(printBuff, digits, (size_t) digitsLen)) != USHELL_SOCKET_NO_ERR)))
+        {
+            break;
+        }
+
+        /* Left justify */
+        if ((spec->flags & USHELL_SOCKET_FMT_FLAG_LEFT) != 0U)
+        {
+            status = uShellSocketPrintBuffFill(printBuff, ' ', pad);
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Convert the unsigned value to the decimal digits (two digits per step)
+ * \param[in] value - value to be converted
+ * \param[in] end - end of the buffer (the digits are written backward)
+ * \return char* - first digit
+ */
+static char* uShellSocketFmtDec(uint64_t value,
+                                char* end)
+{
+    /* Local variable */
+    uint32_t value32 = 0U;
+    uint32_t pair = 0U;
+
+    /* The wide division is used only while the value does not fit 32 bits */
+    while (value > UINT32_MAX)
+    {
+        pair = (uint32_t) (value % 100U);
+        value /= 100U;
+        *--end = uShellSocketFmtDigitPairs [(pair * 2U) + 1U];
+        *--end = uShellSocketFmtDigitPairs [pair * 2U];
+    }
+
+    /* Two digits per step */
+    value32 = (uint32_t) value;
+    while (value32 >= 100U)
+    {
+        pair = value32 % 100U;
+        value32 /= 100U;
+        *--end = uShellSocketFmtDigitPairs [(pair * 2U) + 1U];
+        *--end = uShellSocketFmtDigitPairs [pair * 2U];
+    }
+
+    /* The last one or two digits */
+    if (value32 >= 10U)
+    {
+        *--end = uShellSocketFmtDigitPairs [(value32 * 2U) + 1U];
+        *--end = uShellSocketFmtDigitPairs [value32 * 2U];
+    }
+    else
+    {
+        *--end = (char) ('0' + value32);
+    }
+
+    return end;
+}
+
+/**
+ * \brief Convert the unsigned value to the digits of the power of two base (no division)
+ * \param[in] value - value to be converted
+ * \param[in] shift - bits per digit (1 - binary, 3 - octal, 4 - hexadecimal)
+ * \param[in] upper - upper case digits
+ * \param[in] end - end of the buffer (the digits are written backward)
+ * \return char* - first digit
+ */
+static char* uShellSocketFmtPow2(uint64_t value,
+                                 const uint8_t shift,
+                                 const bool upper,
+                                 char* end)
+{
+    /* Local variable */
+    const char* digits = (upper == true) ? uShellSocketFmtDigitsUpper : uShellSocketFmtDigitsLower;
+    const uint64_t mask = (1U << shift) - 1U;
+
+    do
+    {
+        *--end = digits [value & mask];
+        value >>= shift;
+    } while (value != 0U);
+
+    return end;
+}
+
+/**
+ * \brief Put the integer into the staging buffer
+ * \param[in] printBuff - staging buffer
+ * \param[in] spec - conversion specification
+ * \param[in] value - absolute value
+ * \param[in] isNegative - the value is negative (only for the signed conversions)
+ * \param[in] type - type of the conversion (d, u, x, X, o, b, p)
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketFmtInt(UShellSocketPrintBuff_s* const printBuff,
+                                            const UShellSocketFmtSpec_s* const spec,
+                                            const uint64_t value,
+                                            const bool isNegative,
+                                            const char type)
+{
+    /* Local variable */
+    UShellSocketFmtSpec_s fieldSpec = *spec;
+    char num [USHELL_SOCKET_FMT_NUM_SIZE];
+    char* const end = &num [sizeof(num)];
+    char* digits = end;
+    char prefix [4] = {0};
+    size_t prefixLen = 0U;
+    int digitsLen = 0;
+    int zeros = 0;
+
+    /* The pointer is printed as 0x... in the hexadecimal */
+    if (type == 'p')
+    {
+        fieldSpec.flags |= USHELL_SOCKET_FMT_FLAG_ALT;
+    }
+
+    /* The zero with the zero precision has no digits */
+    if ((value != 0U) ||
+        (fieldSpec.precision != 0))
+    {
+        switch (type)
+        {
+            case 'x' :
+            case 'p' :
+                digits = uShellSocketFmtPow2(value, 4U, false, end);
+                break;
+            case 'X' :
+                digits = uShellSocketFmtPow2(value, 4U, true, end);
+                break;
+            case 'o' :
+                digits = uShellSocketFmtPow2(value, 3U, false, end);
+                break;
+            case 'b' :
+                digits = uShellSocketFmtPow2(value, 1U, false, end);
+                break;
+            default :
+                digits = uShellSocketFmtDec(value, end);
+                break;
+        }
+    }
+    digitsLen = (int) (end - digits);
+
+    /* Sign */
+    if (isNegative == true)
+    {
+        prefix [prefixLen++] = '-';
+    }
+    else if ((type == 'd') &&
+             ((fieldSpec.flags & USHELL_SOCKET_FMT_FLAG_PLUS) != 0U))
+    {
+        prefix [prefixLen++] = '+';
+    }
+    else if ((type == 'd') &&
+             ((fieldSpec.flags & USHELL_SOCKET_FMT_FLAG_SPACE) != 0U))
+    {
+        prefix [prefixLen++] = ' ';
+    }
+
+    /* Base prefix of the alternative form */
+    if ((fieldSpec.flags & USHELL_SOCKET_FMT_FLAG_ALT) != 0U)
+    {
+        if (((type == 'x') || (type == 'X') || (type == 'p') || (type == 'b')) &&
+            (value != 0U))
+        {
+            prefix [prefixLen++] = '0';
+            prefix [prefixLen++] = (type == 'p') ? 'x' : type;
+        }
+        else if ((type == 'o') &&
+                 ((digitsLen == 0) || (*digits != '0')) &&
+                 (fieldSpec.precision <= digitsLen))
+        {
+            /* The octal number starts with zero */
+            zeros = 1;
+        }
+    }
+
+    /* The precision gives the minimum number of digits, the zero flag is ignored then */
+    if (fieldSpec.precision >= 0)
+    {
+        zeros = (fieldSpec.precision > digitsLen) ? (fieldSpec.precision - digitsLen) : zeros;
+        fieldSpec.flags &= ~(uint32_t) USHELL_SOCKET_FMT_FLAG_ZERO;
+    }
+
+    return uShellSocketFmtField(printBuff, &fieldSpec, prefix, digits, digitsLen, zeros);
+}
+
+/**
+ * \brief Put the floating point value into the staging buffer (fixed point notation)
+ * \note Only USHELL_SOCKET_FMT_FLOAT_PREC_MAX fraction digits are converted (the rest are zeros),
+ *       the values out of the uint64_t range are converted by uShellSocketFmtFloatBig.
+ * \param[in] printBuff - staging buffer
+ * \param[in] spec - conversion specification
+ * \param[in] value - value to be put
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketFmtFloat(UShellSocketPrintBuff_s* const printBuff,
+                                              const UShellSocketFmtSpec_s* const spec,
+                                              double value)
+{
+    /* Local variable */
+    static const uint32_t pow10 [USHELL_SOCKET_FMT_FLOAT_PREC_MAX + 1] =
+        {1U, 10U, 100U, 1000U, 10000U, 100000U, 1000000U, 10000000U, 100000000U, 1000000000U};
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellSocketFmtSpec_s fieldSpec = *spec;
+    char num [USHELL_SOCKET_FMT_NUM_SIZE];
+    char* const end = &num [sizeof(num)];
+    char* digits = end;
+    const char* prefix = NULL;
+    int precision = (spec->precision < 0) ? 6 : spec->precision;
+    int extraZeros = 0;
+    uint64_t intPart = 0U;
+    uint32_t fracPart = 0U;
+    double frac = 0.0;
+    bool isNegative = (value < 0.0) || ((value == 0.0) && ((1.0 / value) < 0.0));    // Negative zero as well
+
+    do
+    {
+        /* Sign */
+        value = (isNegative == true) ? -value : value;
+        if (isNegative == true)
+        {
+            prefix = "-";
+        }
+        else if ((spec->flags & USHELL_SOCKET_FMT_FLAG_PLUS) != 0U)
+        {
+            prefix = "+";
+        }
+        else if ((spec->flags & USHELL_SOCKET_FMT_FLAG_SPACE) != 0U)
+        {
+            prefix = " ";
+        }
+
+        /* Not a number and the infinity */
+        if ((value != value) ||
+            (value > DBL_MAX))
+        {
+            fieldSpec.flags &= ~(uint32_t) USHELL_SOCKET_FMT_FLAG_ZERO;
+            status = uShellSocketFmtField(printBuff,
+                                          &fieldSpec,
+                                          (value != value) ? NULL : prefix,
+                                          (value != value) ? "nan" : "inf",
+                                          3,
+                                          0);
+            break;
+        }
+
+        /* The digits after the limit of the precision are zeros */
+        precision = (precision > USHELL_SOCKET_FMT_FLOAT_PREC_LIMIT) ? USHELL_SOCKET_FMT_FLOAT_PREC_LIMIT : precision;
+
+        /* The values which do not fit the integer part */
+        if (value >= 18446744073709551616.0)
+        {
+            status = uShellSocketFmtFloatBig(printBuff, spec, prefix, value, precision);
+            break;
+        }
+
+        if (precision > USHELL_SOCKET_FMT_FLOAT_PREC_MAX)
+        {
+            extraZeros = precision - USHELL_SOCKET_FMT_FLOAT_PREC_MAX;
+            precision = USHELL_SOCKET_FMT_FLOAT_PREC_MAX;
+        }
+        while ((end - digits) < extraZeros)
+        {
+            *--digits = '0';
+        }
+
+        /* Split and round the value */
+        intPart = (uint64_t) value;
+        frac = (value - (double) intPart) * (double) pow10 [precision];
+        fracPart = (uint32_t) frac;
+        frac -= (double) fracPart;
+        if ((frac > 0.5) ||
+            ((frac == 0.5) && (((precision > 0) ? (fracPart & 1U) : (uint32_t) (intPart & 1U)) != 0U)))
+        {
+            /* Round half to even (the last digit is the integer one without the fraction digits) */
+            fracPart++;
+        }
+        if (fracPart >= pow10 [precision])
+        {
+            fracPart -= pow10 [precision];
+            intPart++;
+        }
+
+        /* Fraction digits (with the leading zeros), the point and the integer digits */
+        if (precision > 0)
+        {
+            digits = uShellSocketFmtDec(fracPart, digits);
+            while ((end - digits) < (precision + extraZeros))
+            {
+                *--digits = '0';
+            }
+        }
+        if (((precision + extraZeros) > 0) ||
+            ((spec->flags & USHELL_SOCKET_FMT_FLAG_ALT) != 0U))
+        {
+            *--digits = '.';
+        }
+        digits = uShellSocketFmtDec(intPart, digits);
+
+        status = uShellSocketFmtField(printBuff, &fieldSpec, prefix, digits, (int) (end - digits), 0);
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Put the floating point value out of the uint64_t range into the staging buffer (fixed point notation)
+ * \note The value is an integer there (the fraction digits are zeros). It is split to the mantissa and the power of two,
+ *       the mantissa is shifted by the power in the base 10^9 limbs and the limbs are put from the most significant one.
+ * \param[in] printBuff - staging buffer
+ * \param[in] spec - conversion specification
+ * \param[in] prefix - sign prefix (may be NULL)
+ * \param[in] value - absolute value (finite, not less than 2^64)
+ * \param[in] precision - number of the fraction digits
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketFmtFloatBig(UShellSocketPrintBuff_s* const printBuff,
+                                                 const UShellSocketFmtSpec_s* const spec,
+                                                 const char* const prefix,
+                                                 double value,
+                                                 const int precision)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellSocketFmtSpec_s fieldSpec = *spec;
+    uint32_t limbs [USHELL_SOCKET_FMT_FLOAT_LIMB_NUM] = {0};
+    int limbNum = 0;
+    char num [USHELL_SOCKET_FMT_NUM_SIZE];
+    char* const end = &num [sizeof(num)];
+    char* digits = end;
+    uint64_t mantissa = 0U;
+    uint64_t carry = 0U;
+    int exp = 0;
+    int shift = 0;
+    int topLen = 0;
+    int restLen = 0;
+    bool hasPoint = (precision > 0) || ((spec->flags & USHELL_SOCKET_FMT_FLAG_ALT) != 0U);
+
+    do
+    {
+        /* Split the value to the mantissa (the scaling by two is exact) */
+        while (value >= 18446744073709551616.0)
+        {
+            value *= 0.5;
+            exp++;
+        }
+        mantissa = (uint64_t) value;
+        while (mantissa > 0U)
+        {
+            limbs [limbNum++] = (uint32_t) (mantissa % USHELL_SOCKET_FMT_FLOAT_LIMB_BASE);
+            mantissa /= USHELL_SOCKET_FMT_FLOAT_LIMB_BASE;
+        }
+
+        /* Shift the limbs by the power of two (29 bits at most, the product fits uint64_t) */
+        while (exp > 0)
+        {
+            shift = (exp > 29) ? 29 : exp;
+            exp -= shift;
+            carry = 0U;
+            for (int ind = 0; ind < limbNum; ind++)
+            {
+                carry += (uint64_t) limbs [ind] << shift;
+                limbs [ind] = (uint32_t) (carry % USHELL_SOCKET_FMT_FLOAT_LIMB_BASE);
+                carry /= USHELL_SOCKET_FMT_FLOAT_LIMB_BASE;
+            }
+            if (carry > 0U)
+            {
+                limbs [limbNum++] = (uint32_t) carry;
+            }
+        }
+
+        /* The length of the digits after the most significant limb gives the padding */
+        digits = uShellSocketFmtDec(limbs [limbNum - 1], end);
+        topLen = (int) (end - digits);
+        restLen = ((limbNum - 1) * USHELL_SOCKET_FMT_FLOAT_LIMB_DIGITS) + ((hasPoint == true) ? 1 : 0) + precision;
+        if ((spec->flags & USHELL_SOCKET_FMT_FLAG_LEFT) != 0U)
+        {
+            fieldSpec.flags &= ~(uint32_t) (USHELL_SOCKET_FMT_FLAG_LEFT | USHELL_SOCKET_FMT_FLAG_ZERO);
+            fieldSpec.width = 0;
+        }
+        else
+        {
+            fieldSpec.width = spec->width - restLen;
+        }
+
+        /* Right justify and the sign, then the most significant limb */
+        status = uShellSocketFmtField(printBuff, &fieldSpec, prefix, digits, topLen, 0);
+        if (status != USHELL_SOCKET_NO_ERR)
+        {
+            break;
+        }
+
+        /* The rest of the limbs (with the leading zeros) */
+        for (int ind = limbNum - 2; ind >= 0; ind--)
+        {
+            digits = uShellSocketFmtDec(limbs [ind], end);
+            while ((end - digits) < USHELL_SOCKET_FMT_FLOAT_LIMB_DIGITS)
+            {
+                *--digits = '0';
+            }
+            status = uShellSocketPrintBuffPut(printBuff, digits, (size_t) (end - digits));
+            if (status != USHELL_SOCKET_NO_ERR)
+            {
+                break;
+            }
+        }
+        if (status != USHELL_SOCKET_NO_ERR)
+        {
+            break;
+        }
+
+        /* The point and the fraction zeros */
+        if (hasPoint == true)
+        {
+            status = uShellSocketPrintBuffPut(printBuff, ".", 1U);
+            if (status != USHELL_SOCKET_NO_ERR)
+            {
+                break;
+            }
+        }
+        status = uShellSocketPrintBuffFill(printBuff, '0', precision);
+        if (status != USHELL_SOCKET_NO_ERR)
+        {
+            break;
+        }
+
+        /* Left justify */
+        if ((spec->flags & USHELL_SOCKET_FMT_FLAG_LEFT) != 0U)
+        {
+            status = uShellSocketPrintBuffFill(printBuff,
+                                               ' ',
+                                               spec->width - (topLen + restLen + ((prefix != NULL) ? (int) strlen(prefix) : 0)));
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Process the scan format string and assign the results
+ * \param[in] scan - input of the scan
+ * \param[in] format - format string
+ * \param[in] args - variable arguments list (pointers to the results)
+ * \param[out] count - number of the assigned conversions
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketProcessScan(UShellSocketScan_s* const scan,
+                                                 const char* const format,
+                                                 va_list args,
+                                                 size_t* const count)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellSocket_s* const socket = scan->socket;
+    bool isSuppressed = false;
+    size_t width = 0U;
+    char length = '\0';
+    uint8_t base = 0U;
+    uint64_t uValue = 0U;
+    int64_t sValue = 0;
+    bool isNegative = false;
+    double fValue = 0.0;
+    char* str = NULL;
+    size_t strLen = 0U;
+    char ch = '\0';
+
+    /* Iterate through the format string */
+    for (const char* p = format; (*p != '\0') && (status == USHELL_SOCKET_NO_ERR); p++)
+    {
+        /* The white space matches any white space the input already holds */
+        if (uShellSocketScanIsSpace(*p) == true)
+        {
+            status = uShellSocketScanSpace(scan, false);
+            status = ((status == USHELL_SOCKET_TIMEOUT_ERR) || (status == USHELL_SOCKET_EMPTY_ERR))
+                         ? USHELL_SOCKET_NO_ERR
+                         : status;
+            continue;
+        }
+
+        /* Regular characters (and %%) match themselves */
+        if ((*p != '%') || (p [1] == '%'))
+        {
+            p = (*p == '%') ? (p + 1) : p;
+            status = uShellSocketScanPeek(scan, &ch, true);
+            if (status != USHELL_SOCKET_NO_ERR)
+            {
+                break;
+            }
+            if (ch != *p)
+            {
+                status = USHELL_SOCKET_MATCH_ERR;
+                break;
+            }
+            socket->scanPos++;
+            scan->consumed++;
+            continue;
+        }
+
+        /* Assignment suppression */
+        p++;
+        isSuppressed = false;
+        if (*p == '*')
+        {
+            isSuppressed = true;
+            p++;
+        }
+
+        /* Width (0 - not limited) */
+        width = 0U;
+        while ((*p >= '0') && (*p <= '9'))
+        {
+            width = (width * 10U) + (size_t) (*p - '0');
+            p++;
+        }
+
+        /* Length (hh and ll are kept as 'H' and 'L') */
+        length = '\0';
+        if ((*p == 'h') || (*p == 'l') || (*p == 'z') || (*p == 'j') || (*p == 't'))
+        {
+            length = *p++;
+            if ((length == 'h') && (*p == 'h'))
+            {
+                length = 'H';
+                p++;
+            }
+            else if ((length == 'l') && (*p == 'l'))
+            {
+                length = 'L';
+                p++;
+            }
+        }
+
+        /* Conversion */
+        switch (*p)
+        {
+            case 'd' :
+            case 'i' :
+            {
+                status = uShellSocketScanInt(scan, width, (*p == 'd') ? 10U : 0U, &uValue, &isNegative);
+                if ((status != USHELL_SOCKET_NO_ERR) ||
+                    (isSuppressed == true))
+                {
+                    break;
+                }
+
+                /* Saturate the value to the signed range */
+                if (isNegative == false)
+                {
+                    sValue = (uValue > (uint64_t) INT64_MAX) ? INT64_MAX : (int64_t) uValue;
+                }
+                else
+                {
+                    sValue = (uValue == 0U)                           ? 0
+                             : (uValue > ((uint64_t) INT64_MAX + 1U)) ? INT64_MIN
+                                                                      : (-(int64_t) (uValue - 1U) - 1);
+                }
+
+                /* Put the result of the given length */
+                switch (length)
+                {
+                    case 'H' : *va_arg(args, signed char*) = (signed char) sValue; break;
+                    case 'h' : *va_arg(args, short*) = (short) sValue; break;
+                    case 'l' : *va_arg(args, long*) = (long) sValue; break;
+                    case 'L' : *va_arg(args, long long*) = (long long) sValue; break;
+                    case 'z' : *va_arg(args, ptrdiff_t*) = (ptrdiff_t) sValue; break;
+                    case 't' : *va_arg(args, ptrdiff_t*) = (ptrdiff_t) sValue; break;
+                    case 'j' : *va_arg(args, intmax_t*) = (intmax_t) sValue; break;
+                    default : *va_arg(args, int*) = (int) sValue; break;
+                }
+                (*count)++;
+                break;
+            }
+
+            case 'u' :
+            case 'x' :
+            case 'X' :
+            case 'o' :
+            case 'b' :
+            {
+                base = (*p == 'u') ? 10U : (*p == 'o') ? 8U : (*p == 'b') ? 2U : 16U;
+                status = uShellSocketScanInt(scan, width, base, &uValue, &isNegative);
+                if ((status != USHELL_SOCKET_NO_ERR) ||
+                    (isSuppressed == true))
+                {
+                    break;
+                }
+
+                /* The minus sign negates the value in the unsigned type */
+                uValue = (isNegative == true) ? (0U - uValue) : uValue;
+
+                /* Put the result of the given length */
+                switch (length)
+                {
+                    case 'H' : *va_arg(args, unsigned char*) = (unsigned char) uValue; break;
+                    case 'h' : *va_arg(args, unsigned short*) = (unsigned short) uValue; break;
+                    case 'l' : *va_arg(args, unsigned long*) = (unsigned long) uValue; break;
+                    case 'L' : *va_arg(args, unsigned long long*) = (unsigned long long) uValue; break;
+                    case 'z' : *va_arg(args, size_t*) = (size_t) uValue; break;
+                    case 't' : *va_arg(args, ptrdiff_t*) = (ptrdiff_t) uValue; break;
+                    case 'j' : *va_arg(args, uintmax_t*) = (uintmax_t) uValue; break;
+                    default : *va_arg(args, unsigned int*) = (unsigned int) uValue; break;
+                }
+                (*count)++;
+                break;
+            }
+
+            case 'f' :
+            case 'F' :
+            case 'e' :
+            case 'E' :
+            case 'g' :
+            case 'G' :
+            {
+                status = uShellSocketScanFloat(scan, width, &fValue);
+                if ((status != USHELL_SOCKET_NO_ERR) ||
+                    (isSuppressed == true))
+                {
+                    break;
+                }
+
+                /* The l length is the double */
+                if (length == 'l')
+                {
+                    *va_arg(args, double*) = fValue;
+                }
+                else
+                {
+                    *va_arg(args, float*) = (float) fValue;
+                }
+                (*count)++;
+                break;
+            }
+
+            case 's' :
+            {
+                /* The word ends by the white space (the width is the size of the buffer without the terminator) */
+                str = (isSuppressed == true) ? NULL : va_arg(args, char*);
+                width = (width == 0U) ? SIZE_MAX : width;
+                status = uShellSocketScanSpace(scan, true);
+                for (strLen = 0U; (status == USHELL_SOCKET_NO_ERR) && (strLen < width); strLen++)
+                {
+                    status = uShellSocketScanPeek(scan, &ch, true);
+                    if ((status != USHELL_SOCKET_NO_ERR) ||
+                        (uShellSocketScanIsSpace(ch) == true))
+                    {
+                        break;
+                    }
+                    if (str != NULL)
+                    {
+                        str [strLen] = ch;
+                    }
+                    socket->scanPos++;
+                    scan->consumed++;
+                }
+
+                /* The end of the input ends the word */
+                if ((strLen > 0U) &&
+                    ((status == USHELL_SOCKET_TIMEOUT_ERR) || (status == USHELL_SOCKET_EMPTY_ERR)))
+                {
+                    status = USHELL_SOCKET_NO_ERR;
+                }
+                if ((status != USHELL_SOCKET_NO_ERR) ||
+                    (str == NULL))
+                {
+                    break;
+                }
+                str [strLen] = '\0';
+                (*count)++;
+                break;
             }
-            else if (*p == 'f')    // Float
+
+            case 'c' :
             {
-                double value = va_arg(args, double);
-                char floatStr [32];    // Enough for a double
-                snprintf(floatStr, sizeof(floatStr), "%f", value);
-                for (char* fp = floatStr; *fp != '\0'; fp++)
+                /* Exactly width items (1 by default) including the white space, without the terminator */
+                str = (isSuppressed == true) ? NULL : va_arg(args, char*);
+                width = (width == 0U) ? 1U : width;
+                for (strLen = 0U; strLen < width; strLen++)
                 {
-                    status = uShellSocketWriteBytesBlock(socket, fp, 1);
+                    status = uShellSocketScanPeek(scan, &ch, true);
                     if (status != USHELL_SOCKET_NO_ERR)
                     {
-                        return status;
+                        break;
+                    }
+                    if (str != NULL)
+                    {
+                        str [strLen] = ch;
                     }
+                    socket->scanPos++;
+                    scan->consumed++;
+                }
+                if ((status == USHELL_SOCKET_NO_ERR) &&
+                    (str != NULL))
+                {
+                    (*count)++;
                 }
+                break;
             }
-            else if (*p == '%')    // Literal '%'
+
+            case 'n' :
             {
-                status = uShellSocketWriteBytesBlock(socket, p, 1);
-                if (status != USHELL_SOCKET_NO_ERR)
+                /* Number of the consumed items (it is not counted) */
+                if (isSuppressed == false)
                 {
-                    return status;
+                    *va_arg(args, int*) = (int) scan->consumed;
                 }
+                break;
             }
-            else
+
+            default :
             {
-                // Unsupported format specifier
+                /* Unsupported format specifier */
                 USHELL_SOCKET_ASSERT(0);
-                return USHELL_SOCKET_INVALID_ARGS_ERR;
+                status = USHELL_SOCKET_INVALID_ARGS_ERR;
+                break;
             }
         }
-        else    // Regular character
+
+        /* The format ends inside the conversion */
+        if (*p == '\0')
         {
-            status = uShellSocketWriteBytesBlock(socket, p, 1);
-            if (status != USHELL_SOCKET_NO_ERR)
+            break;
+        }
+    }
+
+    return status;
+}
+
+/**
+ * \brief Take the next item of the input without consuming it
+ * \note The lookahead is refilled by one chunk of the stream when it is drained.
+ * \param[in] scan - input of the scan
+ * \param[out] ch - next item
+ * \param[in] isWaiting - true to wait for the item up to the end of the timeout
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred (USHELL_SOCKET_TIMEOUT_ERR - no input);
+ */
+static UShellSocketErr_e uShellSocketScanPeek(UShellSocketScan_s* const scan,
+                                              char* const ch,
+                                              const bool isWaiting)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellSocket_s* const socket = scan->socket;
+    UShellOsalTimeMs_t now = 0U;
+    UShellSocketTimeMs_t wait = 0U;
+    size_t readCount = 0U;
+
+    do
+    {
+        /* The lookahead holds the item */
+        if (socket->scanPos < socket->scanLen)
+        {
+            *ch = socket->scan [socket->scanPos];
+            break;
+        }
+
+        /* The rest of the timeout */
+        if (isWaiting == true)
+        {
+            if (UShellOsalTimeMsGet(socket->osal, &now) != USHELL_OSAL_NO_ERR)
             {
-                return status;
+                status = USHELL_SOCKET_PORT_ERR;
+                break;
             }
+            wait = (UShellSocketTimeMs_t) (UShellOsalTimeMs_t) (now - scan->start);
+            wait = (wait < scan->timeout) ? (scan->timeout - wait) : 0U;
+        }
+
+        /* Take the chunk of the stream */
+        socket->scanPos = 0U;
+        socket->scanLen = 0U;
+        status = uShellSocketReadAvailable(socket,
+                                           socket->scan,
+                                           sizeof(socket->scan),
+                                           wait,
+                                           false,
+                                           &readCount);
+        if (status != USHELL_SOCKET_NO_ERR)
+        {
+            break;
         }
+        socket->scanLen = readCount;
+        *ch = socket->scan [0];
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Skip the white space of the input
+ * \param[in] scan - input of the scan
+ * \param[in] isWaiting - true to wait for the first item which is not the white space
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred (USHELL_SOCKET_TIMEOUT_ERR - no input);
+ */
+static UShellSocketErr_e uShellSocketScanSpace(UShellSocketScan_s* const scan,
+                                               const bool isWaiting)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    char ch = '\0';
+
+    for (;;)
+    {
+        status = uShellSocketScanPeek(scan, &ch, isWaiting);
+        if ((status != USHELL_SOCKET_NO_ERR) ||
+            (uShellSocketScanIsSpace(ch) == false))
+        {
+            break;
+        }
+        scan->socket->scanPos++;
+        scan->consumed++;
     }
 
     return status;
+}
+
+/**
+ * \brief Scan the integer
+ * \param[in] scan - input of the scan
+ * \param[in] width - maximum number of the items to be consumed
+ * \param[in] base - base of the number (0 - by the prefix: 0x, 0b, 0 or decimal)
+ * \param[out] value - absolute value (saturated)
+ * \param[out] isNegative - the minus sign is given
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketScanInt(UShellSocketScan_s* const scan,
+                                             size_t width,
+                                             uint8_t base,
+                                             uint64_t* const value,
+                                             bool* const isNegative)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellSocket_s* const socket = scan->socket;
+    uint64_t result = 0U;
+    size_t digits = 0U;
+    uint8_t digit = 0U;
+    bool isOverflow = false;
+    char ch = '\0';
+
+    do
+    {
+        /* The leading white space is skipped */
+        width = (width == 0U) ? SIZE_MAX : width;
+        *isNegative = false;
+        status = uShellSocketScanSpace(scan, true);
+        if (status != USHELL_SOCKET_NO_ERR)
+        {
+            break;
+        }
+
+        /* Sign (the white space is skipped, so the item is in the lookahead) */
+        ch = socket->scan [socket->scanPos];
+        if ((ch == '-') || (ch == '+'))
+        {
+            *isNegative = (ch == '-');
+            socket->scanPos++;
+            scan->consumed++;
+            width--;
+        }
+
+        /* Prefix (the zero of the prefix is the digit itself) */
+        if ((width > 0U) &&
+            ((base == 0U) || (base == 2U) || (base == 16U)))
+        {
+            status = uShellSocketScanPeek(scan, &ch, true);
+            if ((status == USHELL_SOCKET_NO_ERR) && (ch == '0'))
+            {
+                socket->scanPos++;
+                scan->consumed++;
+                width--;
+                digits++;
+
+                status = (width > 0U) ? uShellSocketScanPeek(scan, &ch, true) : status;
+                ch = (char) (ch | 0x20);
+                if ((width > 0U) && (status == USHELL_SOCKET_NO_ERR) &&
+                    (((ch == 'x') && (base != 2U)) || ((ch == 'b') && (base != 16U))))
+                {
+                    base = (ch == 'x') ? 16U : 2U;
+                    socket->scanPos++;
+                    scan->consumed++;
+                    width--;
+                }
+                base = (base == 0U) ? 8U : base;
+            }
+        }
+        base = (base == 0U) ? 10U : base;
+
+        /* Digits (the value is saturated) */
+        for (; width > 0U; width--)
+        {
+            status = uShellSocketScanPeek(scan, &ch, true);
+            if (status != USHELL_SOCKET_NO_ERR)
+            {
+                break;
+            }
+            digit = uShellSocketScanDigit(ch);
+            if (digit >= base)
+            {
+                break;
+            }
+
+            if (result > ((UINT64_MAX - digit) / base))
+            {
+                isOverflow = true;
+            }
+            result = (result * base) + digit;
+            socket->scanPos++;
+            scan->consumed++;
+            digits++;
+        }
+
+        /* The end of the input ends the number */
+        if ((digits > 0U) &&
+            ((status == USHELL_SOCKET_TIMEOUT_ERR) || (status == USHELL_SOCKET_EMPTY_ERR)))
+        {
+            status = USHELL_SOCKET_NO_ERR;
+        }
+        if (status != USHELL_SOCKET_NO_ERR)
+        {
+            break;
+        }
+        if (digits == 0U)
+        {
+            status = USHELL_SOCKET_MATCH_ERR;
+            break;
+        }
+
+        *value = (isOverflow == true) ? UINT64_MAX : result;
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Scan the floating point number ([sign]digits[.digits][e[sign]digits])
+ * \note The result is exact for up to 15 significant digits and the decimal exponent up to 22.
+ * \param[in] scan - input of the scan
+ * \param[in] width - maximum number of the items to be consumed
+ * \param[out] value - scanned value
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellSocketErr_e uShellSocketScanFloat(UShellSocketScan_s* const scan,
+                                               size_t width,
+                                               double* const value)
+{
+    /* Local variable */
+    UShellSocketErr_e status = USHELL_SOCKET_NO_ERR;
+    UShellSocket_s* const socket = scan->socket;
+    uint64_t mantissa = 0U;
+    int exponent = 0;
+    int expValue = 0;
+    size_t digits = 0U;
+    uint8_t digit = 0U;
+    bool isNegative = false;
+    bool isExpNegative = false;
+    bool isFraction = false;
+    double result = 0.0;
+    char ch = '\0';
+
+    do
+    {
+        /* The leading white space is skipped */
+        width = (width == 0U) ? SIZE_MAX : width;
+        status = uShellSocketScanSpace(scan, true);
+        if (status != USHELL_SOCKET_NO_ERR)
+        {
+            break;
+        }
+
+        /* Sign (the white space is skipped, so the item is in the lookahead) */
+        ch = socket->scan [socket->scanPos];
+        if ((ch == '-') || (ch == '+'))
+        {
+            isNegative = (ch == '-');
+            socket->scanPos++;
+            scan->consumed++;
+            width--;
+        }
+
+        /* Mantissa (the digits which do not fit are dropped, the integer ones are kept in the exponent) */
+        for (; width > 0U; width--)
+        {
+            status = uShellSocketScanPeek(scan, &ch, true);
+            if (status != USHELL_SOCKET_NO_ERR)
+            {
+                break;
+            }
+
+            if ((ch == '.') && (isFraction == false))
+            {
+                isFraction = true;
+            }
+            else
+            {
+                digit = uShellSocketScanDigit(ch);
+                if (digit >= 10U)
+                {
+                    break;
+                }
+
+                if (mantissa <= ((UINT64_MAX - 9U) / 10U))
+                {
+                    mantissa = (mantissa * 10U) + digit;
+                    exponent -= (isFraction == true) ? 1 : 0;
+                }
+                else
+                {
+                    exponent += (isFraction == true) ? 0 : 1;
+                }
+                digits++;
+            }
+            socket->scanPos++;
+            scan->consumed++;
+        }
+
+        /* Exponent (the value is saturated, the empty exponent is zero) */
+        if ((status == USHELL_SOCKET_NO_ERR) &&
+            (digits > 0U) &&
+            (width > 0U) &&
+            ((ch == 'e') || (ch == 'E')))
+        {
+            socket->scanPos++;
+            scan->consumed++;
+            width--;
+
+            status = (width > 0U) ? uShellSocketScanPeek(scan, &ch, true) : status;
+            if ((width > 0U) && (status == USHELL_SOCKET_NO_ERR) &&
+                ((ch == '-') || (ch == '+')))
+            {
+                isExpNegative = (ch == '-');
+                socket->scanPos++;
+                scan->consumed++;
+                width--;
+            }
+
+            for (; (width > 0U) && (status == USHELL_SOCKET_NO_ERR); width--)
+            {
+                status = uShellSocketScanPeek(scan, &ch, true);
+                digit = uShellSocketScanDigit(ch);
+                if ((status != USHELL_SOCKET_NO_ERR) ||
+                    (digit >= 10U))
+                {
+                    break;
+                }
+                expValue = (expValue < 10000) ? ((expValue * 10) + digit) : expValue;
+                socket->scanPos++;
+                scan->consumed++;
+            }
+            exponent += (isExpNegative == true) ? -expValue : expValue;
+        }
+
+        /* The end of the input ends the number */
+        if ((digits > 0U) &&
+            ((status == USHELL_SOCKET_TIMEOUT_ERR) || (status == USHELL_SOCKET_EMPTY_ERR)))
+        {
+            status = USHELL_SOCKET_NO_ERR;
+        }
+        if (status != USHELL_SOCKET_NO_ERR)
+        {
+            break;
+        }
+        if (digits == 0U)
+        {
+            status = USHELL_SOCKET_MATCH_ERR;
+            break;
+        }
+
+        /* Scale the mantissa by the exact powers of ten */
+        result = (double) mantissa;
+        while ((exponent > 22) && (result != 0.0) && (result <= DBL_MAX))
+        {
+            result *= uShellSocketScanPow10 [22];
+            exponent -= 22;
+        }
+        while ((exponent < -22) && (result != 0.0))
+        {
+            result /= uShellSocketScanPow10 [22];
+            exponent += 22;
+        }
+        if ((exponent >= -22) && (exponent <= 22))
+        {
+            result = (exponent >= 0)
+                         ? (result * uShellSocketScanPow10 [exponent])
+                         : (result / uShellSocketScanPow10 [-exponent]);
+        }
+
+        *value = (isNegative == true) ? -result : result;
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Check the item is the white space
+ * \param[in] ch - item to be checked
+ * \return true - the item is the white space
+ */
+static bool uShellSocketScanIsSpace(const char ch)
+{
+    return (ch == ' ') || ((ch >= '\t') && (ch <= '\r'));
+}
+
+/**
+ * \brief Take the value of the digit (bases up to 16)
+ * \param[in] ch - item to be converted
+ * \return value of the digit, 0xFF - the item is not a digit
+ */
+static uint8_t uShellSocketScanDigit(const char ch)
+{
+    /* Local variable */
+    uint8_t digit = 0xFFU;
+    uint8_t lower = (uint8_t) (ch | 0x20);
+
+    if ((uint8_t) (ch - '0') < 10U)
+    {
+        digit = (uint8_t) (ch - '0');
+    }
+    else if ((uint8_t) (lower - 'a') < 6U)
+    {
+        digit = (uint8_t) (lower - 'a' + 10U);
+    }
+
+    return digit;
 }
\ No newline at end of file
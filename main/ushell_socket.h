@@ -20,6 +20,46 @@ extern "C" {
 
 /*===========================================================[MACRO DEFINITIONS]============================================*/
 
+/**
+ * \brief Size of the staging buffer of the formatted print (it is on the stack of the caller).
+ * \note The formatted output is sent to the stream once per fill of the buffer and once at the end of the call.
+ */
+#ifndef USHELL_SOCKET_PRINT_BUFF_SIZE
+    #define USHELL_SOCKET_PRINT_BUFF_SIZE 64U
+#endif
+
+/**
+ * \brief Size of the gather buffer of UShellSocketWriteV (it is on the stack of the caller).
+ * \note The message up to this size is committed to the stream by one send.
+ *       The log line (USHELL_LOG_LINE_SIZE) must fit it.
+ */
+#ifndef USHELL_SOCKET_WRITEV_BUFF_SIZE
+    #define USHELL_SOCKET_WRITEV_BUFF_SIZE 256U
+#endif
+
+/**
+ * \brief Period of the check of the free space of the stream by UShellSocketWriteV (milliseconds)
+ */
+#ifndef USHELL_SOCKET_WRITEV_POLL_MS
+    #define USHELL_SOCKET_WRITEV_POLL_MS 1U
+#endif
+
+/**
+ * \brief Size of the staging region of UShellSocketWriteReserve (it is inside the socket object).
+ * \note It is used only if the OSAL port can not reserve the region inside the stream.
+ */
+#ifndef USHELL_SOCKET_RESERVE_SIZE
+    #define USHELL_SOCKET_RESERVE_SIZE 64U
+#endif
+
+/**
+ * \brief Size of the scan lookahead (it is inside the socket object).
+ * \note The scan takes the input from the stream by chunks up to this size.
+ */
+#ifndef USHELL_SOCKET_SCAN_BUFF_SIZE
+    #define USHELL_SOCKET_SCAN_BUFF_SIZE 32U
+#endif
+
 /*========================================================[DATA TYPES DEFINITIONS]==========================================*/
 
 /**
@@ -34,6 +74,8 @@ typedef enum
     USHELL_SOCKET_PORT_ERR,            ///< Exit: error - port error (e.g. port layer error)
     USHELL_SOCKET_TIMEOUT_ERR,         ///< Exit: error - timeout error
     USHELL_SOCKET_EMPTY_ERR,           ///< Exit: error - empty buffer error
+    USHELL_SOCKET_OVERFLOW_ERR,        ///< Exit: error - no space in the buffer (the data is dropped)
+    USHELL_SOCKET_MATCH_ERR,           ///< Exit: error - the input does not match the format (scan)
 
 } UShellSocketErr_e;
 
@@ -47,6 +89,16 @@ typedef char UShellSocketItem_t;
  */
 typedef size_t UShellSocketTimeMs_t;
 
+/**
+ * \brief Describe one fragment of the message (UShellSocketWriteV)
+ */
+typedef struct
+{
+    const UShellSocketItem_t* base;    ///< First item of the fragment
+    size_t len;                        ///< Number of the items
+
+} UShellSocketIoVec_s;
+
 /**
  * \brief Enumeration of possible socket types
  * \note This is used to identify the type of socket (e.g. scan or print)
@@ -66,6 +118,7 @@ typedef struct
 {
     UShellSocketType_e type;    ///< Type of the socket (input or output)
     size_t size;                ///< Size of the item in the socket
+    bool noWait;                ///< Blocking calls do not wait (writes drop the rest, reads of the empty stream fail)
 
 } UShellSocketCfg_s;
 
@@ -115,6 +168,22 @@ typedef struct
     /* Internal use */
     UShellSocketCfg_s cfg;             ///< Type of the socket (input or output)
     UShellSocketCbTable_s* cbTable;    ///< Callback table for the socket
+    size_t dropCount;                  ///< Number of the items dropped by the no wait writes
+    size_t writeCount;                 ///< Number of the items written (the users take the difference)
+
+    /* Writers */
+    UShellOsal_s* writeLockOsal;            ///< OSAL object of the lock of the writers
+    UShellOsalLockObjHandle_t writeLock;    ///< Lock of the writers (NULL - the socket has one writer)
+
+    /* Write reservation */
+    UShellSocketItem_t* reserveRegion;                          ///< Reserved region (NULL - nothing is reserved)
+    size_t reserveSize;                                         ///< Size of the reserved region
+    UShellSocketItem_t reserve [USHELL_SOCKET_RESERVE_SIZE];    ///< Staging region (the OSAL port without the reservation)
+
+    /* Scan lookahead */
+    UShellSocketItem_t scan [USHELL_SOCKET_SCAN_BUFF_SIZE];    ///< Items taken from the stream and not consumed by the scan yet
+    size_t scanLen;                                             ///< Number of the items in the lookahead
+    size_t scanPos;                                             ///< Next item of the lookahead
 
 } UShellSocket_s;
 
@@ -194,6 +263,64 @@ UShellSocketErr_e UShellSocketWrite(UShellSocket_s* const socket,
                                     const size_t size,
                                     const UShellSocketTimeMs_t timeout);
 
+/**
+ * \brief Write several fragments to the uShell socket object as one message
+ * \note The fragments are gathered and committed to the stream by one send with one write callback
+ *       under the lock of the writers, so the message is not split by the other writers. The gathered items are
+ *       sent when the stream has the room for all of them: on the timeout nothing is written.
+ *       The message longer than USHELL_SOCKET_WRITEV_BUFF_SIZE is committed by one send per
+ *       USHELL_SOCKET_WRITEV_BUFF_SIZE items.
+ * \param[in] socket - uShell object to be written
+ * \param[in] vec - fragments of the message (the empty fragments are skipped)
+ * \param[in] num - number of the fragments
+ * \param[in] timeout - timeout in milliseconds
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+UShellSocketErr_e UShellSocketWriteV(UShellSocket_s* const socket,
+                                     const UShellSocketIoVec_s* const vec,
+                                     const size_t num,
+                                     const UShellSocketTimeMs_t timeout);
+
+/**
+ * \brief Set the lock of the writers of the uShell socket object
+ * \note The lock is taken by every write and print of the socket, so the writes of the several threads
+ *       are not interleaved. The socket without the lock has one writer.
+ * \param[in] socket - uShell object to be written
+ * \param[in] osal - OSAL object of the lock
+ * \param[in] lock - lock of the writers (NULL - no lock)
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+UShellSocketErr_e UShellSocketWriteLockSet(UShellSocket_s* const socket,
+                                           UShellOsal_s* const osal,
+                                           const UShellOsalLockObjHandle_t lock);
+
+/**
+ * \brief Reserve the contiguous region to be written in place (zero-copy write)
+ * \note The region is inside the stream when the OSAL port supports it (UShellOsalStreamBuffReserve),
+ *       otherwise it is the staging region of the socket (USHELL_SOCKET_RESERVE_SIZE items)
+ *       which is committed by one send. One reservation per socket is open at a time,
+ *       it is closed by UShellSocketWriteCommit.
+ * \param[in] socket - uShell object to be written
+ * \param[out] region - start of the reserved region
+ * \param[out] size - size of the reserved region (number of the items)
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred (USHELL_SOCKET_OVERFLOW_ERR - the stream is full);
+ */
+UShellSocketErr_e UShellSocketWriteReserve(UShellSocket_s* const socket,
+                                           UShellSocketItem_t** const region,
+                                           size_t* const size);
+
+/**
+ * \brief Commit the items written into the region reserved by UShellSocketWriteReserve
+ * \note The reservation is closed even if an error has occurred. The zero length only closes it.
+ * \param[in] socket - uShell object to be written
+ * \param[in] len - number of the items written from the start of the region
+ * \param[in] timeout - timeout in milliseconds (the staging region of the socket only)
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+UShellSocketErr_e UShellSocketWriteCommit(UShellSocket_s* const socket,
+                                          const size_t len,
+                                          const UShellSocketTimeMs_t timeout);
+
 /**
  * \brief Scan character from the uShell socket object in non-blocking mode
  * \note This function is non-blocking and will return immediately.
@@ -218,6 +345,37 @@ UShellSocketErr_e UShellSocketReadBlocking(UShellSocket_s* const socket,
                                            UShellSocketItem_t* const item,
                                            const size_t size);
 
+/**
+ * \brief Read all available items (up to size) from the uShell socket object
+ * \note The function waits up to timeout for the first item and does not wait for the rest.
+ * \note This function will return USHELL_SOCKET_TIMEOUT_ERR if no item is available.
+ * \param[in] socket - socket object to be read
+ * \param[out] item - buffer to store the items
+ * \param[in] size - size of the buffer
+ * \param[in] timeout - timeout in milliseconds
+ * \param[out] readCount - number of the items read
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+UShellSocketErr_e UShellSocketReadChunk(UShellSocket_s* const socket,
+                                        UShellSocketItem_t* const item,
+                                        const size_t size,
+                                        const UShellSocketTimeMs_t timeout,
+                                        size_t* const readCount);
+
+/**
+ * \brief Read all available items (up to size) from the uShell socket object
+ * \note This function is blocking and will wait for the first item to be read.
+ * \param[in] socket - socket object to be read
+ * \param[out] item - buffer to store the items
+ * \param[in] size - size of the buffer
+ * \param[out] readCount - number of the items read
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+UShellSocketErr_e UShellSocketReadChunkBlocking(UShellSocket_s* const socket,
+                                                UShellSocketItem_t* const item,
+                                                const size_t size,
+                                                size_t* const readCount);
+
 /**
  * \brief Check if the socket is empty
  * \param[in] socket - socket object to be checked
@@ -230,6 +388,8 @@ UShellSocketErr_e UShellSocketIsEmpty(UShellSocket_s* const socket,
 /**
  * \brief Print formatted string to the uShell socket object
  * \note This function is blocking and will wait for the string to be written.
+ * \note The format is %[flags][width][.precision][length]type: flags "-0+ #", width and precision (or *),
+ *       length hh, h, l, ll, z, j, t and types d, i, u, x, X, o, b (binary), c, s, p, f, %.
  * \param[in] socket - uShell object to be printed
  * \param[in] format - format string to be printed
  * \param[out] none
@@ -252,16 +412,72 @@ UShellSocketErr_e UShellSocketPrintVaList(UShellSocket_s* const socket,
                                           va_list args);
 
 /**
- * \brief Scan formatted string from the uShell socket object
+ * \brief Format the string into the memory (the same format as UShellSocketPrint)
+ * \note The output is always terminated, the rest of the output which does not fit is truncated.
+ * \param[out] buff - buffer for the output
+ * \param[in] size - size of the buffer (including the terminator)
+ * \param[out] len - length of the output without the terminator (may be NULL)
+ * \param[in] format - format string
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred (USHELL_SOCKET_OVERFLOW_ERR - truncated);
+ */
+UShellSocketErr_e UShellSocketFormat(char* const buff,
+                                     const size_t size,
+                                     size_t* const len,
+                                     const char* const format,
+                                     ...);
+
+/**
+ * \brief Format the string into the memory using va_list (the same format as UShellSocketPrint)
+ * \note The output is always terminated, the rest of the output which does not fit is truncated.
+ * \param[out] buff - buffer for the output
+ * \param[in] size - size of the buffer (including the terminator)
+ * \param[out] len - length of the output without the terminator (may be NULL)
+ * \param[in] format - format string
+ * \param[in] args - va_list of arguments
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred (USHELL_SOCKET_OVERFLOW_ERR - truncated);
+ */
+UShellSocketErr_e UShellSocketFormatVaList(char* const buff,
+                                           const size_t size,
+                                           size_t* const len,
+                                           const char* const format,
+                                           va_list args);
+
+/**
+ * \brief Scan formatted input from the uShell socket object
+ * \note The input is taken from the stream in chunks, the items which are not consumed
+ *       stay in the socket for the next scan (the other reads do not see them).
+ * \note The format is %[*][width][length]type: * - no assignment, length hh, h, l, ll, z, j, t and
+ *       types d, i (0x, 0b, 0 prefixes), u, x, X, o, b (binary), f, e, g (float*, l - double*), c, s, n, %.
+ *       The white space of the format skips the white space the input already holds (it does not wait).
+ *       Give the width of %s (size of the buffer without the terminator).
  * \param[in] socket - uShell object to be scanned
+ * \param[in] timeout - time the input is waited for (milliseconds, the whole call)
+ * \param[out] count - number of the assigned conversions (may be NULL)
  * \param[in] format - format string to be scanned
- * \param[out] none
- * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred
+ *         (USHELL_SOCKET_MATCH_ERR - the input does not match, USHELL_SOCKET_TIMEOUT_ERR - no input in time);
  */
 UShellSocketErr_e UShellSocketScanf(UShellSocket_s* const socket,
+                                    const UShellSocketTimeMs_t timeout,
+                                    size_t* const count,
                                     const char* const format,
                                     ...);
 
+/**
+ * \brief Scan formatted input from the uShell socket object using va_list (the same format as UShellSocketScanf)
+ * \param[in] socket - uShell object to be scanned
+ * \param[in] timeout - time the input is waited for (milliseconds, the whole call)
+ * \param[out] count - number of the assigned conversions (may be NULL)
+ * \param[in] format - format string to be scanned
+ * \param[in] args - va_list of the pointers to the results
+ * \return UShellSocketErr_e - error code. non-zero = an error has occurred;
+ */
+UShellSocketErr_e UShellSocketScanfVaList(UShellSocket_s* const socket,
+                                          const UShellSocketTimeMs_t timeout,
+                                          size_t* const count,
+                                          const char* const format,
+                                          va_list args);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
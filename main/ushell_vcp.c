@@ -41,6 +41,7 @@ typedef enum
     USHELL_VCP_EVENT_RX_EVENT = USHELL_OSAL_EVENT_GROUP_BIT_1,    ///< Rx event
     USHELL_VCP_EVENT_TX_EVENT = USHELL_OSAL_EVENT_GROUP_BIT_2,    ///< Tx event
     USHELL_VCP_EVENT_INSPECT = USHELL_OSAL_EVENT_GROUP_BIT_3,     ///< Inspect event
+    USHELL_VCP_EVENT_READY = USHELL_OSAL_EVENT_GROUP_BIT_4,       ///< Ready state (it is never cleared by the worker)
 
 } UShellVcpEvent_e;
 
@@ -125,18 +126,22 @@ static UShellVcpErr_e uShellVcpRtEnvDeInit(UShellVcp_s* const vcp);
 /**
  * \brief Initialize the runtime environment HAL
  * \param vcp - vcp object
+ * \param port - port of the hal object
  * \param hal - hal object
  * \return USHELL_VCP_NO_ERR if success, otherwise error code
  */
 static UShellVcpErr_e uShellVcpRtEnvHalInit(UShellVcp_s* const vcp,
+                                            UShellVcpPort_s* const port,
                                             UShellHal_s* const hal);
 
 /**
  * \brief Deinitialize the runtime environment HAL
  * \param vcp - vcp object
+ * \param port - port of the hal object
  * \return USHELL_VCP_NO_ERR if success, otherwise error code
  */
-static UShellVcpErr_e uShellVcpRtEnvHalDeInit(UShellVcp_s* const vcp);
+static UShellVcpErr_e uShellVcpRtEnvHalDeInit(UShellVcp_s* const vcp,
+                                              UShellVcpPort_s* const port);
 
 /**
  * \brief Initialize the runtime environment OSAL
@@ -180,7 +185,7 @@ static UShellVcpErr_e uShellVcpEventSend(UShellVcp_s* const vcp,
 /**
  * \brief Wait for message event from the vcp object (blocked )
  * \param vcp - vcp object
- * \param msgEvent - message event to be waited
+ * \param msgEvent - mask of the received events (all of them are cleared)
  * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
  */
 static UShellVcpErr_e uShellVcpEventWait(UShellVcp_s* const vcp,
@@ -215,30 +220,58 @@ static UShellVcpErr_e uShellVcpMsgXferPend(UShellVcp_s* const vcp,
 /**
  * \brief Read from the port
  * \param vcp - vcp object
+ * \param port - port to read from
  * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
  */
-static UShellVcpErr_e uShellVcpReadFromPort(UShellVcp_s* const vcp);
+static UShellVcpErr_e uShellVcpReadFromPort(UShellVcp_s* const vcp,
+                                            UShellVcpPort_s* const port);
 
 /**
  * \brief Write to the port
  * \param vcp - vcp object
+ * \param port - port to write to
  * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
  */
-static UShellVcpErr_e uShellVcpWriteToPort(UShellVcp_s* const vcp);
+static UShellVcpErr_e uShellVcpWriteToPort(UShellVcp_s* const vcp,
+                                           UShellVcpPort_s* const port);
 
+/**
+ * \brief Get the highest priority of the write sessions which have the whole writes
+ * \param vcp - vcp object
+ * \param port - port of the write sessions
+ * \param priority - the highest priority
+ * \param isTxReady - true if any write session has the data
+ * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellVcpErr_e uShellVcpTxPriorityGet(UShellVcp_s* const vcp,
+                                             UShellVcpPort_s* const port,
+                                             uint8_t* const priority,
+                                             bool* const isTxReady);
+
+/**
+ * \brief Wait for tx complete of the buffer sent by the hal
+ * \param vcp - vcp object
+ * \param isTxBusy - true if the buffer is being sent (it is cleared)
+ * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellVcpErr_e uShellVcpTxCompleteWait(UShellVcp_s* const vcp,
+                                              bool* const isTxBusy);
+
+#if (USHELL_VCP_WATCHDOG_ENABLE == TRUE)
 /**
  * \brief Inspect the vcp object
  * \param vcp - vcp object to be inspected
  * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
  */
 static UShellVcpErr_e uShellVcpInspect(UShellVcp_s* const vcp);
+#endif
 
 /**
- * \brief Flush the buffer of the vcp object
- * \param vcp - vcp object to be flushed
+ * \brief Flush the buffer of the port
+ * \param port - port to be flushed
  * \return none
  */
-static inline void uShellVcpIoBuffFlush(UShellVcp_s* const vcp);
+static inline void uShellVcpIoBuffFlush(UShellVcpPort_s* const port);
 
 /**
  * \brief Flush the rx buffer of the vcp object
@@ -253,23 +286,25 @@ static inline void uShellVcpStreamRxFlush(UShellVcp_s* const vcp);
 static inline void uShellVcpStreamTxFlush(UShellVcp_s* const vcp);
 
 /**
- * \brief Set tx direction of the vcp object
- * \param[in] vcp - vcp object to be set
+ * \brief Set tx direction of the port
+ * \param[in] port - port to be set
  */
-static inline void uShellVcpDirectTxSet(UShellVcp_s* const vcp);
+static inline void uShellVcpDirectTxSet(UShellVcpPort_s* const port);
 
 /**
- * \brief Set rx direction of the vcp  object
- * \param[in] vcp - vcp object to be set
+ * \brief Set rx direction of the port
+ * \param[in] port - port to be set
  */
-static inline void uShellVcpDirectRxSet(UShellVcp_s* const vcp);
+static inline void uShellVcpDirectRxSet(UShellVcpPort_s* const port);
 
+#if (USHELL_VCP_WATCHDOG_ENABLE == TRUE)
 /**
  * \brief Callback function for the timer expiration
  * \param timerParam - parameter for the timer expiration callback
  * \return none
  */
 static void uShellVcpTimerExpiredCb(void* const timerParam);
+#endif
 
 /**
  * \brief UShell VCP socket read callback function
@@ -440,6 +475,90 @@ UShellVcpErr_e UShellVcpDeInit(UShellVcp_s* const vcp)
     return status;
 }
 
+/**
+ * \brief Add one more hal port to the uShell vcp object (it is served by the same worker)
+ * \param[in] vcp - vcp object
+ * \param[in] hal - hal object of the port
+ * \param[out] port - index of the port (it is given to the sessions in UShellVcpSessionParam_s)
+ * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
+ */
+UShellVcpErr_e UShellVcpPortAdd(UShellVcp_s* const vcp,
+                                const UShellHal_s* const hal,
+                                size_t* const port)
+{
+    /* Local variable */
+    UShellVcpErr_e status = USHELL_VCP_NO_ERR;
+    size_t freePortSlot = 0;
+    bool slotFind = false;
+
+    do
+    {
+        /* Check input parameters */
+        if ((vcp == NULL) ||
+            (vcp->osal == NULL) ||
+            (hal == NULL) ||
+            (port == NULL))
+        {
+            /* Input parameters are invalid */
+            USHELL_VCP_ASSERT(0);
+            status = USHELL_VCP_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Lock */
+        uShellVcpLock(vcp);
+
+        /* Thread safe code */
+        do
+        {
+            /* Find free port slot (the hal can be served only once) */
+            for (size_t slot = 0; slot < USHELL_VCP_PORT_MAX; slot++)
+            {
+                if (vcp->port [slot].hal == hal)
+                {
+                    slotFind = false;
+                    break;
+                }
+                if ((vcp->port [slot].hal == NULL) &&
+                    (slotFind == false))
+                {
+                    freePortSlot = slot;
+                    slotFind = true;
+                }
+            }
+
+            /* Check we find slot */
+            if (slotFind == false)
+            {
+                /* No free port slot */
+                USHELL_VCP_ASSERT(0);
+                status = USHELL_VCP_SESSION_SLOT_ERR;
+                break;
+            }
+
+            /* Open the hal, its callbacks wake the worker of the vcp */
+            status = uShellVcpRtEnvHalInit(vcp, &vcp->port [freePortSlot], (UShellHal_s*) hal);
+            if (status != USHELL_VCP_NO_ERR)
+            {
+                /* HAL initialization failed */
+                USHELL_VCP_ASSERT(0);
+                memset(&vcp->port [freePortSlot], 0, sizeof(UShellVcpPort_s));
+                break;
+            }
+
+            /* Return the index of the port */
+            *port = freePortSlot;
+
+        } while (0);
+
+        /* Unlock */
+        uShellVcpUnlock(vcp);
+
+    } while (0);
+
+    return status;
+}
+
 /**
  * \brief Open a session for the uShell vcp object
  * \param[in] vcp - uShell object to be opened
@@ -458,6 +577,7 @@ UShellVcpErr_e UShellVcpSessionOpen(UShellVcp_s* const vcp,
     UShellOsal_s* osal = (UShellOsal_s*) vcp->osal;
     UShellOsalStreamBuffHandle_t streamBuff = NULL;
     UShellSocketCfg_s socketCfg = {0};
+    UShellVcpPort_s* port = NULL;
     size_t freeSessionSlot = 0;
     bool slotFind = false;
 
@@ -485,6 +605,17 @@ UShellVcpErr_e UShellVcpSessionOpen(UShellVcp_s* const vcp,
             break;
         }
 
+        /* Check the port of the session */
+        if ((param.port >= USHELL_VCP_PORT_MAX) ||
+            (vcp->port [param.port].hal == NULL))
+        {
+            /* Port is invalid */
+            USHELL_VCP_ASSERT(0);
+            status = USHELL_VCP_INVALID_ARGS_ERR;
+            break;
+        }
+        port = &vcp->port [param.port];
+
         /* lock */
         uShellVcpLock(vcp);
 
@@ -494,8 +625,8 @@ UShellVcpErr_e UShellVcpSessionOpen(UShellVcp_s* const vcp,
             /* Find free session slot */
             for (freeSessionSlot = 0; freeSessionSlot < USHELL_VCP_ACTIVE_SESSION_MAX; freeSessionSlot++)
             {
-                if ((vcp->session [freeSessionSlot].param.owner == NULL) &&
-                    (vcp->session [freeSessionSlot].used == false))
+                if ((port->session [freeSessionSlot].param.owner == NULL) &&
+                    (port->session [freeSessionSlot].used == false))
                 {
                     slotFind = true;
                     break;
@@ -512,11 +643,11 @@ UShellVcpErr_e UShellVcpSessionOpen(UShellVcp_s* const vcp,
             }
 
             /* Save param to the session slot */
-            vcp->session [freeSessionSlot].param = param;
+            port->session [freeSessionSlot].param = param;
 
             /* Create stream buffer handle */
             osalStatus = UShellOsalStreamBuffCreate(osal,
-                                                    USHELL_VCP_BUFFER_SIZE,
+                                                    (param.size == 0U) ? USHELL_VCP_BUFFER_SIZE : param.size,
                                                     1U,
                                                     &streamBuff);
             if (osalStatus != USHELL_OSAL_NO_ERR)
@@ -528,16 +659,16 @@ UShellVcpErr_e UShellVcpSessionOpen(UShellVcp_s* const vcp,
             }
 
             /* Save the stream buffer handle to the session slot */
-            vcp->session [freeSessionSlot].stream = streamBuff;
+            port->session [freeSessionSlot].stream = streamBuff;
 
             /* Prepare socket cfg */
-            socketCfg.size = USHELL_VCP_BUFFER_SIZE;
+            socketCfg.size = (param.size == 0U) ? USHELL_VCP_BUFFER_SIZE : param.size;
             socketCfg.type = (param.type == USHELL_VCP_DIR_READ)
                                  ? USHELL_SOCKET_TYPE_READ
                                  : USHELL_SOCKET_TYPE_WRITE;
 
             /* Init the socket object */
-            socketStatus = UShellSocketInit(&vcp->session [freeSessionSlot].socket,
+            socketStatus = UShellSocketInit(&port->session [freeSessionSlot].socket,
                                             osal,
                                             streamBuff,
                                             socketCfg,
@@ -553,10 +684,10 @@ UShellVcpErr_e UShellVcpSessionOpen(UShellVcp_s* const vcp,
             }
 
             /* Return the socket object */
-            *socket = &vcp->session [freeSessionSlot].socket;
+            *socket = &port->session [freeSessionSlot].socket;
 
             /* Set the session slot as used */
-            vcp->session [freeSessionSlot].used = true;
+            port->session [freeSessionSlot].used = true;
 
         } while (0);
 
@@ -565,13 +696,15 @@ UShellVcpErr_e UShellVcpSessionOpen(UShellVcp_s* const vcp,
 
     } while (0);
 
-    if (status != USHELL_VCP_NO_ERR)
+    if ((status != USHELL_VCP_NO_ERR) &&
+        (port != NULL) &&
+        (slotFind == true))
     {
         /* Deinitialize the session slot */
-        if (vcp->session [freeSessionSlot].stream != NULL)
+        if (port->session [freeSessionSlot].stream != NULL)
         {
             osalStatus = UShellOsalStreamBuffDelete(osal,
-                                                    vcp->session [freeSessionSlot].stream);
+                                                    port->session [freeSessionSlot].stream);
             if (osalStatus != USHELL_OSAL_NO_ERR)
             {
                 /* Stream buffer deletion failed */
@@ -580,11 +713,11 @@ UShellVcpErr_e UShellVcpSessionOpen(UShellVcp_s* const vcp,
         }
 
         /* Deinitialize the socket object */
-        socketStatus = UShellSocketDeInit(&vcp->session [freeSessionSlot].socket);
+        socketStatus = UShellSocketDeInit(&port->session [freeSessionSlot].socket);
         USHELL_VCP_ASSERT(socketStatus == USHELL_SOCKET_NO_ERR);
 
         /* Clear the session slot */
-        memset(&vcp->session [freeSessionSlot], 0, sizeof(UShellVcpSession_s));
+        memset(&port->session [freeSessionSlot], 0, sizeof(UShellVcpSession_s));
     }
 
     return status;
@@ -604,6 +737,7 @@ UShellVcpErr_e UShellVcpSessionClose(UShellVcp_s* const vcp,
     UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
     UShellSocketErr_e socketStatus = USHELL_SOCKET_NO_ERR;
     UShellOsal_s* osal = (UShellOsal_s*) vcp->osal;
+    UShellVcpPort_s* port = NULL;
     size_t sessionSlot = 0;
     bool slotFind = false;
 
@@ -620,6 +754,17 @@ UShellVcpErr_e UShellVcpSessionClose(UShellVcp_s* const vcp,
             break;
         }
 
+        /* Check the port of the session */
+        if ((param.port >= USHELL_VCP_PORT_MAX) ||
+            (vcp->port [param.port].hal == NULL))
+        {
+            /* Port is invalid */
+            USHELL_VCP_ASSERT(0);
+            status = USHELL_VCP_INVALID_ARGS_ERR;
+            break;
+        }
+        port = &vcp->port [param.port];
+
         /* Lock the vcp object */
         uShellVcpLock(vcp);
 
@@ -629,8 +774,8 @@ UShellVcpErr_e UShellVcpSessionClose(UShellVcp_s* const vcp,
             /* Find session slot */
             for (sessionSlot = 0; sessionSlot < USHELL_VCP_ACTIVE_SESSION_MAX; sessionSlot++)
             {
-                if ((vcp->session [sessionSlot].param.owner == param.owner) &&
-                    (vcp->session [sessionSlot].used == true))
+                if ((port->session [sessionSlot].param.owner == param.owner) &&
+                    (port->session [sessionSlot].used == true))
                 {
                     slotFind = true;
                     break;
@@ -647,7 +792,7 @@ UShellVcpErr_e UShellVcpSessionClose(UShellVcp_s* const vcp,
             }
 
             /* Deinitialize the socket object */
-            socketStatus = UShellSocketDeInit(&vcp->session [sessionSlot].socket);
+            socketStatus = UShellSocketDeInit(&port->session [sessionSlot].socket);
             if (socketStatus != USHELL_SOCKET_NO_ERR)
             {
                 /* Socket deinitialization failed */
@@ -658,7 +803,7 @@ UShellVcpErr_e UShellVcpSessionClose(UShellVcp_s* const vcp,
 
             /* Remove stream buffer handle */
             osalStatus = UShellOsalStreamBuffDelete(osal,
-                                                    vcp->session [sessionSlot].stream);
+                                                    port->session [sessionSlot].stream);
             if (osalStatus != USHELL_OSAL_NO_ERR)
             {
                 /* Stream buffer deletion failed */
@@ -668,8 +813,8 @@ UShellVcpErr_e UShellVcpSessionClose(UShellVcp_s* const vcp,
             }
 
             /* Clear the session slot */
-            memset(&vcp->session [sessionSlot], 0, sizeof(UShellVcpSession_s));
-            vcp->session [sessionSlot].used = false;
+            memset(&port->session [sessionSlot], 0, sizeof(UShellVcpSession_s));
+            port->session [sessionSlot].used = false;
 
         } while (0);
 
@@ -681,6 +826,131 @@ UShellVcpErr_e UShellVcpSessionClose(UShellVcp_s* const vcp,
     return status;
 }
 
+/**
+ * \brief Wait until the vcp object is ready (the hal is open and the worker serves the sessions)
+ * \note This function is blocking, it returns at once if the vcp object is already ready.
+ * \param[in] vcp - vcp object
+ * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
+ */
+UShellVcpErr_e UShellVcpReadyWait(UShellVcp_s* const vcp)
+{
+    /* Local variable */
+    UShellVcpErr_e status = USHELL_VCP_NO_ERR;
+    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
+    UShellOsal_s* osal = NULL;
+    UShellOsalEventGroupHandle_t eventHandle = NULL;
+    UShellOsalEventGroupBits_e receivedBit = 0U;
+
+    do
+    {
+        /* Check input parameters */
+        if ((vcp == NULL) ||
+            (vcp->osal == NULL))
+        {
+            /* Input parameters are invalid */
+            USHELL_VCP_ASSERT(0);
+            status = USHELL_VCP_INVALID_ARGS_ERR;
+            break;
+        }
+
+        osal = (UShellOsal_s*) vcp->osal;
+
+        /* Get the event handle */
+        osalStatus = UShellOsalEventGroupHandleGet(osal, 0U, &eventHandle);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (eventHandle == NULL))
+        {
+            /* Event is invalid */
+            USHELL_VCP_ASSERT(0);
+            status = USHELL_VCP_PORT_ERR;
+            break;
+        }
+
+        /* Wait for the ready state (the bit is kept for the other users) */
+        osalStatus = UShellEventGroupBitsWait(osal,
+                                              eventHandle,
+                                              (UShellOsalEventGroupBits_e) USHELL_VCP_EVENT_READY,
+                                              &receivedBit,
+                                              false,
+                                              true);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            ((receivedBit & USHELL_VCP_EVENT_READY) == 0U))
+        {
+            /* Wait error */
+            USHELL_VCP_ASSERT(0);
+            status = USHELL_VCP_PORT_ERR;
+            break;
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Get the number of the received items lost by the read session (its stream was full)
+ * \note The counter is not cleared, the users take the difference.
+ * \param[in] vcp - vcp object
+ * \param[in] param - session parameter object (owner of the read session)
+ * \param[out] overrun - number of the lost items
+ * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
+ */
+UShellVcpErr_e UShellVcpSessionOverrunGet(UShellVcp_s* const vcp,
+                                          const UShellVcpSessionParam_s param,
+                                          size_t* const overrun)
+{
+    /* Local variable */
+    UShellVcpErr_e status = USHELL_VCP_SESSION_SLOT_ERR;
+    UShellVcpPort_s* port = NULL;
+
+    do
+    {
+        /* Check input parameters */
+        if ((vcp == NULL) ||
+            (param.owner == NULL) ||
+            (overrun == NULL))
+        {
+            /* Input parameters are invalid */
+            USHELL_VCP_ASSERT(0);
+            status = USHELL_VCP_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Check the port of the session */
+        if ((param.port >= USHELL_VCP_PORT_MAX) ||
+            (vcp->port [param.port].hal == NULL))
+        {
+            /* Port is invalid */
+            USHELL_VCP_ASSERT(0);
+            status = USHELL_VCP_INVALID_ARGS_ERR;
+            break;
+        }
+        port = &vcp->port [param.port];
+
+        /* Lock the vcp object */
+        uShellVcpLock(vcp);
+
+        /* Find the read session of the owner */
+        for (size_t sessionSlot = 0; sessionSlot < USHELL_VCP_ACTIVE_SESSION_MAX; sessionSlot++)
+        {
+            if ((port->session [sessionSlot].used == true) &&
+                (port->session [sessionSlot].param.owner == param.owner) &&
+                (port->session [sessionSlot].param.type == USHELL_VCP_DIR_READ))
+            {
+                *overrun = port->session [sessionSlot].overrunCount;
+                status = USHELL_VCP_NO_ERR;
+                break;
+            }
+        }
+
+        /* Unlock the vcp object */
+        uShellVcpUnlock(vcp);
+
+    } while (0);
+
+    return status;
+}
+
 //============================================================================ [PRIVATE FUNCTIONS ]=================================================================================
 
 /**
@@ -700,6 +970,10 @@ static void uShellWorker(void* const arg)
     UShellVcpErr_e status = USHELL_VCP_NO_ERR;
     UShellVcpEvent_e msgEvent = USHELL_VCP_EVENT_NONE;
 
+    /* The hal is open and the thread serves the sessions, so the users can start */
+    status = uShellVcpEventSend(vcp, USHELL_VCP_EVENT_READY);
+    USHELL_VCP_ASSERT(status == USHELL_VCP_NO_ERR);
+
     /* Main loop */
     while (1)
     {
@@ -710,78 +984,77 @@ static void uShellWorker(void* const arg)
             continue;
         }
 
-        /* Process the msg */
-        switch (msgEvent)
+        /* Process the error (the streams are flushed, the rest of the events are processed anyway) */
+        if (msgEvent & USHELL_VCP_EVENT_ERROR)
         {
+            status = uShellVcpMsgXferFlush(vcp);
+            USHELL_VCP_ASSERT(status == USHELL_VCP_NO_ERR);
 
-            /* Process the received data */
-            case USHELL_VCP_EVENT_RX_EVENT :
+            /* Flush the rx stream buffers */
+            uShellVcpStreamRxFlush(vcp);
 
-                /* Process the received data */
-                status = uShellVcpReadFromPort(vcp);
-                if (status != USHELL_VCP_NO_ERR)
+            /* Flush the tx stream buffers */
+            uShellVcpStreamTxFlush(vcp);
+
+            /* Flush the buffers and set the rx mode in hal of every port */
+            for (size_t port = 0; port < USHELL_VCP_PORT_MAX; port++)
+            {
+                if (vcp->port [port].hal == NULL)
                 {
-                    /* Send error msg */
-                    uShellVcpEventSend(vcp, USHELL_VCP_EVENT_ERROR);
-                    USHELL_VCP_ASSERT(0);
+                    continue;
                 }
-                break;
+                uShellVcpIoBuffFlush(&vcp->port [port]);
+                uShellVcpDirectRxSet(&vcp->port [port]);
+            }
+        }
 
-            /* Process the transmitted data */
-            case USHELL_VCP_EVENT_TX_EVENT :
+        /* The event mask is shared by the ports, so every port is served (the idle one is only checked) */
+        for (size_t port = 0; port < USHELL_VCP_PORT_MAX; port++)
+        {
+            if (vcp->port [port].hal == NULL)
+            {
+                continue;
+            }
 
-                /* Process the transmitted data */
-                status = uShellVcpWriteToPort(vcp);
+            /* Process the received data */
+            if (msgEvent & USHELL_VCP_EVENT_RX_EVENT)
+            {
+                status = uShellVcpReadFromPort(vcp, &vcp->port [port]);
                 if (status != USHELL_VCP_NO_ERR)
                 {
                     /* Send error msg */
                     uShellVcpEventSend(vcp, USHELL_VCP_EVENT_ERROR);
                     USHELL_VCP_ASSERT(0);
                 }
+            }
 
-                break;
-
-            /* Process the error */
-            case USHELL_VCP_EVENT_ERROR :
-
-                /* Process the error */
-                status = uShellVcpMsgXferFlush(vcp);
-                USHELL_VCP_ASSERT(status == USHELL_VCP_NO_ERR);
-
-                /* Flush the rx stream buffers */
-                uShellVcpStreamRxFlush(vcp);
-
-                /* Flush the tx stream buffers */
-                uShellVcpStreamTxFlush(vcp);
-
-                /* Flush the buffer */
-                uShellVcpIoBuffFlush(vcp);
-
-                /* Set the rx mode in hal */
-                uShellVcpDirectRxSet(vcp);
-
-                break;
-
-            /* Process the inspect event */
-            case USHELL_VCP_EVENT_INSPECT :
+            /* Process the transmitted data */
+            if (msgEvent & USHELL_VCP_EVENT_TX_EVENT)
             {
-                status = uShellVcpInspect(vcp);
+                status = uShellVcpWriteToPort(vcp, &vcp->port [port]);
                 if (status != USHELL_VCP_NO_ERR)
                 {
                     /* Send error msg */
                     uShellVcpEventSend(vcp, USHELL_VCP_EVENT_ERROR);
                     USHELL_VCP_ASSERT(0);
                 }
-                break;
             }
+        }
+
+#if (USHELL_VCP_WATCHDOG_ENABLE == TRUE)
 
-            /* None is none */
-            case USHELL_VCP_EVENT_NONE :
-            default :
+        /* Process the inspect event */
+        if (msgEvent & USHELL_VCP_EVENT_INSPECT)
+        {
+            status = uShellVcpInspect(vcp);
+            if (status != USHELL_VCP_NO_ERR)
             {
-                break;
+                /* Send error msg */
+                uShellVcpEventSend(vcp, USHELL_VCP_EVENT_ERROR);
+                USHELL_VCP_ASSERT(0);
             }
         }
+#endif
     }
 }
 
@@ -932,7 +1205,7 @@ static UShellVcpErr_e uShellVcpRtEnvInit(UShellVcp_s* const vcp,
         }
 
         /* Initialize the runtime environment HAL */
-        status = uShellVcpRtEnvHalInit(vcp, hal);
+        status = uShellVcpRtEnvHalInit(vcp, &vcp->port [0], hal);
         if (status != USHELL_VCP_NO_ERR)
         {
             /* HAL initialization failed */
@@ -986,8 +1259,14 @@ static UShellVcpErr_e uShellVcpRtEnvDeInit(UShellVcp_s* const vcp)
         /* Deinitialize the runtime environment OSAL */
         uShellVcpRtEnvOsalDeInit(vcp);
 
-        /* Deinitialize the runtime environment HAL */
-        uShellVcpRtEnvHalDeInit(vcp);
+        /* Deinitialize the runtime environment HAL of every port */
+        for (size_t port = 0; port < USHELL_VCP_PORT_MAX; port++)
+        {
+            if (vcp->port [port].hal != NULL)
+            {
+                uShellVcpRtEnvHalDeInit(vcp, &vcp->port [port]);
+            }
+        }
 
     } while (0);
 
@@ -997,10 +1276,12 @@ static UShellVcpErr_e uShellVcpRtEnvDeInit(UShellVcp_s* const vcp)
 /**
  * \brief Initialize the runtime environment HAL
  * \param vcp - vcp object
+ * \param port - port of the hal object
  * \param hal - hal object
  * \return USHELL_VCP_NO_ERR if success, otherwise error code
  */
 static UShellVcpErr_e uShellVcpRtEnvHalInit(UShellVcp_s* const vcp,
+                                            UShellVcpPort_s* const port,
                                             UShellHal_s* const hal)
 {
     /* Local variables */
@@ -1012,6 +1293,7 @@ static UShellVcpErr_e uShellVcpRtEnvHalInit(UShellVcp_s* const vcp,
     {
         /* Check input parameter */
         if ((vcp == NULL) ||
+            (port == NULL) ||
             (hal == NULL))
         {
             /* Input parameters are invalid */
@@ -1021,9 +1303,9 @@ static UShellVcpErr_e uShellVcpRtEnvHalInit(UShellVcp_s* const vcp,
         }
 
         /* Save the hal object */
-        vcp->hal = hal;
+        port->hal = hal;
 
-        /* Attach the parent object */
+        /* Attach the parent object (the callbacks of all the ports wake the same worker) */
         halStatus = UShellHalParentSet(hal, vcp);
         if (halStatus != USHELL_HAL_NO_ERR)
         {
@@ -1087,21 +1369,24 @@ static UShellVcpErr_e uShellVcpRtEnvHalInit(UShellVcp_s* const vcp,
 /**
  * \brief Deinitialize the runtime environment HAL
  * \param vcp - vcp object
+ * \param port - port of the hal object
  * \return USHELL_VCP_NO_ERR if success, otherwise error code
  */
-static UShellVcpErr_e uShellVcpRtEnvHalDeInit(UShellVcp_s* const vcp)
+static UShellVcpErr_e uShellVcpRtEnvHalDeInit(UShellVcp_s* const vcp,
+                                              UShellVcpPort_s* const port)
 {
     /* Local variables */
     UShellVcpErr_e status = USHELL_VCP_NO_ERR;
     UShellHalErr_e halStatus = USHELL_HAL_NO_ERR;
-    UShellHal_s* hal = (UShellHal_s*) vcp->hal;
+    UShellHal_s* hal = (UShellHal_s*) port->hal;
 
     /* Deinit the runtime environment HAL */
     do
     {
         /* Check input parameter */
         if ((vcp == NULL) ||
-            (vcp->hal == NULL))
+            (port == NULL) ||
+            (port->hal == NULL))
         {
             /* Input parameters are invalid */
             USHELL_VCP_ASSERT(0);
@@ -1163,7 +1448,7 @@ static UShellVcpErr_e uShellVcpRtEnvHalDeInit(UShellVcp_s* const vcp)
         }
 
         /* Remove the hal object */
-        vcp->hal = NULL;
+        port->hal = NULL;
 
     } while (0);
 
@@ -1281,7 +1566,10 @@ static UShellVcpErr_e uShellVcpRtEnvOsalInit(UShellVcp_s* const vcp,
         }
 #endif
 
-        /* Create timer for inspect the state*/
+#if (USHELL_VCP_WATCHDOG_ENABLE == TRUE)
+
+        /* Create the watchdog timer for inspect the state (the events are sent without it) */
+        vcp->inspectPeriodMs = USHELL_VCP_TIMER_INSPECT_PERIOD_MS;
         UShellOsalTimerHandle_t timer = NULL;
         UShellOsalTimerCfg_s timerCfg =
             {
@@ -1310,6 +1598,7 @@ static UShellVcpErr_e uShellVcpRtEnvOsalInit(UShellVcp_s* const vcp,
             status = USHELL_VCP_PORT_ERR;
             break;
         }
+#endif
 
         /* : Create task */
         UShellOsalThreadHandle_t thread = NULL;
@@ -1623,6 +1912,10 @@ static UShellVcpErr_e uShellVcpEventSend(UShellVcp_s* const vcp,
         {
             eventExist = true;
         }
+        if (msgEvent & USHELL_VCP_EVENT_READY)
+        {
+            eventExist = true;
+        }
 
         if (!eventExist)
         {
@@ -1659,7 +1952,7 @@ static UShellVcpErr_e uShellVcpEventSend(UShellVcp_s* const vcp,
 /**
  * \brief Wait for message event from the vcp object (blocked )
  * \param vcp - vcp object
- * \param msgEvent - message event to be waited
+ * \param msgEvent - mask of the received events (all of them are cleared)
  * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
  */
 static UShellVcpErr_e uShellVcpEventWait(UShellVcp_s* const vcp,
@@ -1717,23 +2010,9 @@ static UShellVcpErr_e uShellVcpEventWait(UShellVcp_s* const vcp,
             break;
         }
 
-        if (receivedBit & USHELL_VCP_EVENT_RX_EVENT)
-        {
-            *msgEvent = USHELL_VCP_EVENT_RX_EVENT;
-        }
-        else if (receivedBit & USHELL_VCP_EVENT_TX_EVENT)
-        {
-            *msgEvent = USHELL_VCP_EVENT_TX_EVENT;
-        }
-        else if (receivedBit & USHELL_VCP_EVENT_ERROR)
-        {
-            *msgEvent = USHELL_VCP_EVENT_ERROR;
-        }
-        else if (receivedBit & USHELL_VCP_EVENT_INSPECT)
-        {
-            *msgEvent = USHELL_VCP_EVENT_INSPECT;
-        }
-        else
+        /* All the received events are returned (they are cleared together, so none of them can be lost) */
+        *msgEvent = (UShellVcpEvent_e) (receivedBit & bitsToWait);
+        if (*msgEvent == USHELL_VCP_EVENT_NONE)
         {
             /* No event */
             USHELL_VCP_ASSERT(0);
@@ -1946,22 +2225,25 @@ static UShellVcpErr_e uShellVcpMsgXferPend(UShellVcp_s* const vcp,
 /**
  * \brief Read from the port
  * \param vcp - vcp object
+ * \param port - port to read from
  * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
  */
-static UShellVcpErr_e uShellVcpReadFromPort(UShellVcp_s* const vcp)
+static UShellVcpErr_e uShellVcpReadFromPort(UShellVcp_s* const vcp,
+                                            UShellVcpPort_s* const port)
 {
     /* Local variable */
     UShellVcpErr_e status = USHELL_VCP_NO_ERR;
     UShellHalErr_e halStatus = USHELL_HAL_NO_ERR;
     size_t sendByte = 0U;
     UShellOsal_s* osal = (UShellOsal_s*) vcp->osal;
-    UShellHal_s* hal = (UShellHal_s*) vcp->hal;
+    UShellHal_s* hal = (UShellHal_s*) port->hal;
 
     /* Read from the port */
     do
     {
         /* Check input parameters */
         if ((vcp == NULL) ||
+            (port == NULL) ||
             (osal == NULL) ||
             (hal == NULL))
         {
@@ -1978,10 +2260,10 @@ static UShellVcpErr_e uShellVcpReadFromPort(UShellVcp_s* const vcp)
         do
         {
             /* Flush the buffer */
-            uShellVcpIoBuffFlush(vcp);
+            uShellVcpIoBuffFlush(port);
 
             /* Read from hal */
-            halStatus = UShellHalRead(hal, vcp->io.buffer, USHELL_VCP_BUFFER_SIZE, &vcp->io.ind);
+            halStatus = UShellHalRead(hal, port->io.buffer, USHELL_VCP_BUFFER_SIZE, &port->io.ind);
             if (halStatus != USHELL_HAL_NO_ERR)
             {
                 /* Read error */
@@ -1991,7 +2273,7 @@ static UShellVcpErr_e uShellVcpReadFromPort(UShellVcp_s* const vcp)
             }
 
             /* Check we have to send */
-            if (vcp->io.ind <= 0U)
+            if (port->io.ind <= 0U)
             {
                 break;
             }
@@ -2000,24 +2282,31 @@ static UShellVcpErr_e uShellVcpReadFromPort(UShellVcp_s* const vcp)
             for (size_t session = 0; session < USHELL_VCP_ACTIVE_SESSION_MAX; session++)
             {
                 /* Check if the session is active */
-                if ((vcp->session [session].used == false) ||
-                    (vcp->session [session].param.type != USHELL_VCP_DIR_READ) ||
-                    (vcp->session [session].stream == NULL))
+                if ((port->session [session].used == false) ||
+                    (port->session [session].param.type != USHELL_VCP_DIR_READ) ||
+                    (port->session [session].stream == NULL))
                 {
                     continue;
                 }
 
                 /* Send to stream buffer */
                 sendByte = UShellOsalStreamBuffSend(osal,
-                                                    vcp->session [session].stream,
-                                                    vcp->io.buffer,
-                                                    vcp->io.ind,
+                                                    port->session [session].stream,
+                                                    port->io.buffer,
+                                                    port->io.ind,
                                                     0U);
 
-                if (sendByte != vcp->io.ind)
+                if (sendByte != port->io.ind)
                 {
-                    /* Send error */
-                    continue;
+                    /* The stream is full, the rest is lost for the session (it is reported by the overrun counter) */
+                    port->session [session].overrunCount += port->io.ind - sendByte;
+                }
+
+                /* Tell the owner the input has arrived */
+                if ((sendByte > 0U) &&
+                    (port->session [session].param.rxCb != NULL))
+                {
+                    port->session [session].param.rxCb(port->session [session].param.owner);
                 }
             }
 
@@ -2035,25 +2324,34 @@ static UShellVcpErr_e uShellVcpReadFromPort(UShellVcp_s* const vcp)
 /**
  * \brief Write to the port
  * \param vcp - vcp object
+ * \param port - port to write to
  * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
  */
-static UShellVcpErr_e uShellVcpWriteToPort(UShellVcp_s* const vcp)
+static UShellVcpErr_e uShellVcpWriteToPort(UShellVcp_s* const vcp,
+                                           UShellVcpPort_s* const port)
 {
     /* Local variable */
     UShellVcpErr_e status = USHELL_VCP_NO_ERR;
-    UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
     UShellHalErr_e halStatus = USHELL_HAL_NO_ERR;
     UShellOsal_s* osal = (UShellOsal_s*) vcp->osal;
-    UShellHal_s* hal = (UShellHal_s*) vcp->hal;
-    UShellVcpMsgXfer_e msgTxLocal = USHELL_VCP_MSG_TX_NONE;
-    bool streamIsEmpty = false;
-
-    /* Read from the port */
-
+    UShellHal_s* hal = (UShellHal_s*) port->hal;
+    UShellVcpItem_t* const txBuffer [2] = {port->io.buffer, port->io.txBuffer};
+    UShellVcpSession_s* session = NULL;
+    size_t txInd = 0U;
+    size_t txLen = 0U;
+    size_t ready = 0U;
+    size_t ind = 0U;
+    bool isTxBusy = false;
+    bool isTxReady = false;
+    uint8_t priority = 0U;
+    size_t quantum = 0U;
+
+    /* Write to the port (one turn of one session per call) */
     do
     {
         /* Check input parameters */
         if ((vcp == NULL) ||
+            (port == NULL) ||
             (osal == NULL))
         {
             /* Input parameters are invalid */
@@ -2065,55 +2363,82 @@ static UShellVcpErr_e uShellVcpWriteToPort(UShellVcp_s* const vcp)
         /* Lock */
         uShellVcpLock(vcp);
 
-        /* Open tx mode */
-        uShellVcpDirectTxSet(vcp);
-
         /* Process send */
         do
         {
-            /* Go over all the session */
-            for (size_t session = 0; session < USHELL_VCP_ACTIVE_SESSION_MAX; session++)
+            /* Only the highest priority which has the whole writes is served */
+            status = uShellVcpTxPriorityGet(vcp, port, &priority, &isTxReady);
+            if ((status != USHELL_VCP_NO_ERR) ||
+                (isTxReady == false))
             {
-                /* Check if the session is active */
-                if ((vcp->session [session].used == false) ||
-                    (vcp->session [session].param.type != USHELL_VCP_DIR_WRITE) ||
-                    (vcp->session [session].stream == NULL))
+                break;
+            }
+
+            /* Round robin: the turn goes to the next session of the priority */
+            for (ind = 0U; ind < USHELL_VCP_ACTIVE_SESSION_MAX; ind++)
+            {
+                session = &port->session [(port->txNext + ind) % USHELL_VCP_ACTIVE_SESSION_MAX];
+                if ((session->used == true) &&
+                    (session->param.type == USHELL_VCP_DIR_WRITE) &&
+                    (session->param.priority == priority) &&
+                    (session->stream != NULL) &&
+                    (session->socket.writeCount != session->txCount))
                 {
-                    continue;
+                    break;
                 }
-
-                /* Check we have data in the stream buffer tx */
-                osalStatus = UShellOsalStreamBuffIsEmpty(osal,
-                                                         vcp->session [session].stream,
-                                                         &streamIsEmpty);
-                if (osalStatus != USHELL_OSAL_NO_ERR)
+            }
+            if (ind >= USHELL_VCP_ACTIVE_SESSION_MAX)
+            {
+                break;
+            }
+            port->txNext = (port->txNext + ind + 1U) % USHELL_VCP_ACTIVE_SESSION_MAX;
+
+            /* The turn adds the quantum to the deficit left by the previous turn of the session */
+            quantum = (session->param.weight == 0U) ? 1U : session->param.weight;
+            quantum *= USHELL_VCP_TX_QUANTUM;
+            session->txDeficit += quantum;
+
+            /* Open tx mode */
+            uShellVcpDirectTxSet(port);
+
+            /* Send the whole writes while they fit the deficit, the rest waits for the next turn.
+             * The socket counts the items after they are put into the stream, so the write count is at the end
+             * of a write (or of a chunk of the write longer than the stream, it cannot be in the stream whole).
+             * The stream holds no more than its size, so the deficit reaches the written items in a few turns.
+             * One buffer is sent by the hal while the other one is filled */
+            while (status == USHELL_VCP_NO_ERR)
+            {
+                ready = session->socket.writeCount - session->txCount;
+                if (ready == 0U)
                 {
-                    /* Stream buffer is invalid */
-                    USHELL_VCP_ASSERT(0);
-                    status = USHELL_VCP_PORT_ERR;
+                    /* Nothing is left to send, the deficit is not kept for the later writes */
+                    session->txDeficit = 0U;
                     break;
                 }
-
-                /* Check we have data in the stream buffer tx */
-                if (streamIsEmpty == true)
+                if (ready > session->txDeficit)
                 {
-                    continue;
+                    break;
                 }
 
-                do
+                while (ready > 0U)
                 {
-                    /* Flush the buffer */
-                    uShellVcpIoBuffFlush(vcp);
-
-                    /* Read from stream buffer */
-                    vcp->io.ind = UShellOsalStreamBuffReceive(osal,
-                                                              vcp->session [session].stream,
-                                                              vcp->io.buffer,
-                                                              USHELL_VCP_BUFFER_SIZE,
-                                                              0U);
-
-                    /* Check we have to send */
-                    if (vcp->io.ind <= 0U)
+                    /* Fill the free buffer from the stream buffer */
+                    txLen = UShellOsalStreamBuffReceive(osal,
+                                                        session->stream,
+                                                        txBuffer [txInd],
+                                                        (ready < USHELL_VCP_BUFFER_SIZE) ? ready : USHELL_VCP_BUFFER_SIZE,
+                                                        0U);
+                    if (txLen == 0U)
+                    {
+                        /* The counted items are not in the stream */
+                        USHELL_VCP_ASSERT(0);
+                        status = USHELL_VCP_PORT_ERR;
+                        break;
+                    }
+
+                    /* Wait for tx complete of the other buffer */
+                    status = uShellVcpTxCompleteWait(vcp, &isTxBusy);
+                    if (status != USHELL_VCP_NO_ERR)
                     {
                         break;
                     }
@@ -2129,7 +2454,7 @@ static UShellVcpErr_e uShellVcpWriteToPort(UShellVcp_s* const vcp)
                     }
 
                     /* Send to hal */
-                    halStatus = UShellHalWrite(hal, vcp->io.buffer, vcp->io.ind);
+                    halStatus = UShellHalWrite(hal, txBuffer [txInd], txLen);
                     if (halStatus != USHELL_HAL_NO_ERR)
                     {
                         /* Send error */
@@ -2138,30 +2463,39 @@ static UShellVcpErr_e uShellVcpWriteToPort(UShellVcp_s* const vcp)
                         break;
                     }
 
-                    /* Wait for tx complete */
-                    status = uShellVcpMsgXferPend(vcp, &msgTxLocal, USHELL_VCP_TX_TIMEOUT_MS);
-                    if ((msgTxLocal != USHELL_VCP_MSG_TX_COMPLETE) ||
-                        (status != USHELL_VCP_NO_ERR))
-                    {
-                        /* Wait error */
-                        USHELL_VCP_ASSERT(0);
-                        status = USHELL_VCP_PORT_ERR;
-                        break;
-                    }
+                    /* The next chunk goes to the other buffer */
+                    isTxBusy = true;
+                    txInd ^= 1U;
+                    ready -= txLen;
+                    session->txCount += txLen;
+                    session->txDeficit -= txLen;
+                }
+            }
 
-                } while (1);
+            /* Wait for the last chunk */
+            if (status == USHELL_VCP_NO_ERR)
+            {
+                status = uShellVcpTxCompleteWait(vcp, &isTxBusy);
+            }
 
-                /* Check if we have an error */
-                if (status != USHELL_VCP_NO_ERR)
-                {
-                    break;
-                }
+            /* Set rx mode */
+            uShellVcpDirectRxSet(port);
+
+            /* Check if we have an error */
+            if (status != USHELL_VCP_NO_ERR)
+            {
+                break;
             }
 
-        } while (0);
+            /* The rest is sent by the next turn, the worker serves the rx before it */
+            status = uShellVcpTxPriorityGet(vcp, port, &priority, &isTxReady);
+            if ((status == USHELL_VCP_NO_ERR) &&
+                (isTxReady == true))
+            {
+                status = uShellVcpEventSend(vcp, USHELL_VCP_EVENT_TX_EVENT);
+            }
 
-        /* Set rx mode */
-        uShellVcpDirectRxSet(vcp);
+        } while (0);
 
         /* Unlock */
         uShellVcpUnlock(vcp);
@@ -2171,10 +2505,105 @@ static UShellVcpErr_e uShellVcpWriteToPort(UShellVcp_s* const vcp)
     return status;
 }
 
+/**
+ * \brief Get the highest priority of the write sessions which have the whole writes
+ * \param vcp - vcp object
+ * \param port - port of the write sessions
+ * \param priority - the highest priority
+ * \param isTxReady - true if any write session has the data
+ * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellVcpErr_e uShellVcpTxPriorityGet(UShellVcp_s* const vcp,
+                                             UShellVcpPort_s* const port,
+                                             uint8_t* const priority,
+                                             bool* const isTxReady)
+{
+    /* Local variable */
+    UShellVcpErr_e status = USHELL_VCP_NO_ERR;
+
+    *isTxReady = false;
+
+    do
+    {
+        /* Check input parameters */
+        if ((vcp == NULL) ||
+            (port == NULL))
+        {
+            /* Input parameters are invalid */
+            USHELL_VCP_ASSERT(0);
+            status = USHELL_VCP_INVALID_ARGS_ERR;
+            break;
+        }
+
+        /* Go over all the session */
+        for (size_t session = 0; session < USHELL_VCP_ACTIVE_SESSION_MAX; session++)
+        {
+            /* Check if the session is active */
+            if ((port->session [session].used == false) ||
+                (port->session [session].param.type != USHELL_VCP_DIR_WRITE) ||
+                (port->session [session].stream == NULL))
+            {
+                continue;
+            }
+
+            /* Take the highest priority which has the whole writes (a write being put into the stream waits) */
+            if ((port->session [session].socket.writeCount != port->session [session].txCount) &&
+                ((*isTxReady == false) || (port->session [session].param.priority > *priority)))
+            {
+                *priority = port->session [session].param.priority;
+                *isTxReady = true;
+            }
+        }
+
+    } while (0);
+
+    return status;
+}
+
+/**
+ * \brief Wait for tx complete of the buffer sent by the hal
+ * \param vcp - vcp object
+ * \param isTxBusy - true if the buffer is being sent (it is cleared)
+ * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
+ */
+static UShellVcpErr_e uShellVcpTxCompleteWait(UShellVcp_s* const vcp,
+                                              bool* const isTxBusy)
+{
+    /* Local variable */
+    UShellVcpErr_e status = USHELL_VCP_NO_ERR;
+    UShellVcpMsgXfer_e msgTxLocal = USHELL_VCP_MSG_TX_NONE;
+
+    do
+    {
+        /* Nothing is being sent */
+        if (*isTxBusy == false)
+        {
+            break;
+        }
+        *isTxBusy = false;
+
+        /* Wait for tx complete */
+        status = uShellVcpMsgXferPend(vcp, &msgTxLocal, USHELL_VCP_TX_TIMEOUT_MS);
+        if ((msgTxLocal != USHELL_VCP_MSG_TX_COMPLETE) ||
+            (status != USHELL_VCP_NO_ERR))
+        {
+            /* Wait error */
+            USHELL_VCP_ASSERT(0);
+            status = USHELL_VCP_PORT_ERR;
+            break;
+        }
+
+    } while (0);
+
+    return status;
+}
+
+#if (USHELL_VCP_WATCHDOG_ENABLE == TRUE)
 /**
  * \brief Inspect the vcp object
  * \param vcp - vcp object to be inspected
  * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
+ * \note The period of the watchdog is set to the shortest one when the lost data is found, otherwise it is doubled.
  */
 static UShellVcpErr_e uShellVcpInspect(UShellVcp_s* const vcp)
 {
@@ -2182,18 +2611,21 @@ static UShellVcpErr_e uShellVcpInspect(UShellVcp_s* const vcp)
     UShellVcpErr_e status = USHELL_VCP_NO_ERR;
     UShellOsalErr_e osalStatus = USHELL_OSAL_NO_ERR;
     UShellHalErr_e halStatus = USHELL_HAL_NO_ERR;
-    UShellHal_s* hal = (UShellHal_s*) vcp->hal;
+    UShellHal_s* hal = NULL;
     UShellOsal_s* osal = (UShellOsal_s*) vcp->osal;
+    UShellOsalTimerHandle_t timer = NULL;
+    UShellOsalTimeMs_t periodMs = 0U;
 
     bool isRxDataAvailable = false;
+    bool isLost = false;
+    bool isTxLost = false;
 
     do
     {
 
         /* Check input parameters */
         if ((vcp == NULL) ||
-            (osal == NULL) ||
-            (hal == NULL))
+            (osal == NULL))
         {
             /* Input parameters are invalid */
             USHELL_VCP_ASSERT(0);
@@ -2202,12 +2634,17 @@ static UShellVcpErr_e uShellVcpInspect(UShellVcp_s* const vcp)
         }
 
         /* Check we have data in hal */
-        do
+        for (size_t port = 0; port < USHELL_VCP_PORT_MAX; port++)
         {
+            /* Check the port is used */
+            hal = (UShellHal_s*) vcp->port [port].hal;
+            if (hal == NULL)
+            {
+                continue;
+            }
 
             /* Get handle of rx stream */
             halStatus = UShellHalIsReadDataAvailable(hal, &isRxDataAvailable);
-            USHELL_VCP_ASSERT(halStatus == USHELL_HAL_NO_ERR);
             if ((halStatus != USHELL_HAL_NO_ERR))
             {
                 /* Hal error */
@@ -2217,32 +2654,22 @@ static UShellVcpErr_e uShellVcpInspect(UShellVcp_s* const vcp)
             }
 
             /* Check we have data in hal */
-            if (isRxDataAvailable == false)
+            if (isRxDataAvailable == true)
             {
-                break;
+                isLost = true;
             }
-
-            /* Set the rx event */
-            status = uShellVcpEventSend(vcp, USHELL_VCP_EVENT_RX_EVENT);
-            if (status != USHELL_VCP_NO_ERR)
-            {
-                /* Send error */
-                USHELL_VCP_ASSERT(0);
-                break;
-            }
-
-        } while (0);
+        }
 
         /* Check we have data in the stream buffer tx */
-        do
+        for (size_t port = 0; (port < USHELL_VCP_PORT_MAX) && (status == USHELL_VCP_NO_ERR); port++)
         {
             /* Go over all the session */
             for (size_t session = 0; session < USHELL_VCP_ACTIVE_SESSION_MAX; session++)
             {
                 /* Check if the session is active */
-                if ((vcp->session [session].used == false) ||
-                    (vcp->session [session].param.type != USHELL_VCP_DIR_WRITE) ||
-                    (vcp->session [session].stream == NULL))
+                if ((vcp->port [port].session [session].used == false) ||
+                    (vcp->port [port].session [session].param.type != USHELL_VCP_DIR_WRITE) ||
+                    (vcp->port [port].session [session].stream == NULL))
                 {
                     continue;
                 }
@@ -2250,7 +2677,7 @@ static UShellVcpErr_e uShellVcpInspect(UShellVcp_s* const vcp)
                 /* Check we have data in the stream buffer tx */
                 bool streamIsEmpty = false;
                 osalStatus = UShellOsalStreamBuffIsEmpty(osal,
-                                                         vcp->session [session].stream,
+                                                         vcp->port [port].session [session].stream,
                                                          &streamIsEmpty);
                 if (osalStatus != USHELL_OSAL_NO_ERR)
                 {
@@ -2261,49 +2688,102 @@ static UShellVcpErr_e uShellVcpInspect(UShellVcp_s* const vcp)
                 }
 
                 /* Check we have data in the stream buffer tx */
-                if (streamIsEmpty == true)
+                if (streamIsEmpty == false)
                 {
-                    continue;
+                    isTxLost = true;
                 }
+            }
+        }
 
-                /* Set the tx event */
-                status = uShellVcpEventSend(vcp, USHELL_VCP_EVENT_TX_EVENT);
-                if (status != USHELL_VCP_NO_ERR)
-                {
-                    /* Send error */
-                    USHELL_VCP_ASSERT(0);
-                    break;
-                }
+        /* Check if we have an error */
+        if (status != USHELL_VCP_NO_ERR)
+        {
+            break;
+        }
 
+        /* Set the rx event (all the ports are read) */
+        if (isLost == true)
+        {
+            status = uShellVcpEventSend(vcp, USHELL_VCP_EVENT_RX_EVENT);
+            if (status != USHELL_VCP_NO_ERR)
+            {
+                /* Send error */
+                USHELL_VCP_ASSERT(0);
                 break;
             }
-        } while (0);
+        }
+
+        /* Set the tx event (all the ports are written) */
+        if (isTxLost == true)
+        {
+            isLost = true;
+            status = uShellVcpEventSend(vcp, USHELL_VCP_EVENT_TX_EVENT);
+            if (status != USHELL_VCP_NO_ERR)
+            {
+                /* Send error */
+                USHELL_VCP_ASSERT(0);
+                break;
+            }
+        }
+
+        /* Adapt the period of the watchdog (the events work, so the timer wakes the thread less and less) */
+        periodMs = (isLost == true) ? USHELL_VCP_TIMER_INSPECT_PERIOD_MS : (UShellOsalTimeMs_t) (vcp->inspectPeriodMs * 2U);
+        if (periodMs > USHELL_VCP_TIMER_INSPECT_PERIOD_MAX_MS)
+        {
+            periodMs = USHELL_VCP_TIMER_INSPECT_PERIOD_MAX_MS;
+        }
+        if (periodMs == vcp->inspectPeriodMs)
+        {
+            break;
+        }
+
+        osalStatus = UShellOsalTimerHandleGet(osal, 0U, &timer);
+        if ((osalStatus != USHELL_OSAL_NO_ERR) ||
+            (timer == NULL))
+        {
+            /* Timer is invalid */
+            USHELL_VCP_ASSERT(0);
+            status = USHELL_VCP_PORT_ERR;
+            break;
+        }
+
+        osalStatus = UShellOsalTimerPeriodChange(osal, timer, periodMs);
+        if (osalStatus != USHELL_OSAL_NO_ERR)
+        {
+            /* Timer error */
+            USHELL_VCP_ASSERT(0);
+            status = USHELL_VCP_PORT_ERR;
+            break;
+        }
+        vcp->inspectPeriodMs = periodMs;
 
     } while (0);
 
     return status;
 }
+#endif
 
 /**
- * \brief Flush the buffer of the vcp object
- * \param vcp - vcp object to be flushed
+ * \brief Flush the buffer of the port
+ * \param port - port to be flushed
  * \return none
  */
-static inline void uShellVcpIoBuffFlush(UShellVcp_s* const vcp)
+static inline void uShellVcpIoBuffFlush(UShellVcpPort_s* const port)
 {
     /* Flush the buffer */
     do
     {
         /* Check input parameters */
-        if (vcp == NULL)
+        if (port == NULL)
         {
             /* Input parameters are invalid */
             USHELL_VCP_ASSERT(0);
             break;
         }
 
-        /* Flush the buffer */
-        memset(&vcp->io, 0, sizeof(UShellVcpIo_s));
+        /* Flush the buffer (the transmit buffers are overwritten by the next chunk) */
+        memset(port->io.buffer, 0, sizeof(port->io.buffer));
+        port->io.ind = 0U;
 
     } while (0);
 }
@@ -2399,13 +2879,13 @@ static inline void uShellVcpStreamTxFlush(UShellVcp_s* const vcp)
 }
 
 /**
- * \brief Set tx direction of the vcp object
- * \param[in] vcp - vcp object to be set
+ * \brief Set tx direction of the port
+ * \param[in] port - port to be set
  */
-static inline void uShellVcpDirectTxSet(UShellVcp_s* const vcp)
+static inline void uShellVcpDirectTxSet(UShellVcpPort_s* const port)
 {
     /* Local variable */
-    UShellHal_s* hal = (UShellHal_s*) vcp->hal;
+    UShellHal_s* hal = (UShellHal_s*) port->hal;
     UShellHalErr_e halStatus = USHELL_HAL_NO_ERR;
 
     do
@@ -2431,13 +2911,13 @@ static inline void uShellVcpDirectTxSet(UShellVcp_s* const vcp)
 }
 
 /**
- * \brief Set rx direction of the vcp  object
- * \param[in] vcp - vcp object to be set
+ * \brief Set rx direction of the port
+ * \param[in] port - port to be set
  */
-static inline void uShellVcpDirectRxSet(UShellVcp_s* const vcp)
+static inline void uShellVcpDirectRxSet(UShellVcpPort_s* const port)
 {
     /* Local variable */
-    UShellHal_s* hal = (UShellHal_s*) vcp->hal;
+    UShellHal_s* hal = (UShellHal_s*) port->hal;
     UShellHalErr_e halStatus = USHELL_HAL_NO_ERR;
 
     do
@@ -2462,6 +2942,7 @@ static inline void uShellVcpDirectRxSet(UShellVcp_s* const vcp)
     } while (0);
 }
 
+#if (USHELL_VCP_WATCHDOG_ENABLE == TRUE)
 /**
  * \brief Callback function for the timer expiration
  * \param timerParam - parameter for the timer expiration callback
@@ -2492,6 +2973,7 @@ static void uShellVcpTimerExpiredCb(void* const timerParam)
 
     } while (0);
 }
+#endif
 
 /**
  * \brief UShell VCP socket read callback function
@@ -66,6 +66,16 @@ extern "C" {
     #define USHELL_VCP_REDIRECT_STDIO TRUE
 #endif
 
+/**
+ * \brief Enable the watchdog timer of the uShell VCP.
+ *
+ * The rx/tx events are sent by the hal callbacks and the sockets, the timer only inspects
+ * the hal and the write streams for the data whose event has been lost (e.g. the port without the rx callback).
+ */
+#ifndef USHELL_VCP_WATCHDOG_ENABLE
+    #define USHELL_VCP_WATCHDOG_ENABLE TRUE
+#endif
+
 /**
  * \brief Timer period for the uShell VCP.
  *
@@ -78,12 +88,21 @@ extern "C" {
 /**
  * \brief Timer period for the uShell VCP.
  *
- * This macro defines the timer period used in the uShell VCP for inspection.
+ * This macro defines the shortest period of the watchdog timer (it is set again when the inspection finds the lost data).
  */
 #ifndef USHELL_VCP_TIMER_INSPECT_PERIOD_MS
     #define USHELL_VCP_TIMER_INSPECT_PERIOD_MS 1000U
 #endif
 
+/**
+ * \brief The longest period of the watchdog timer.
+ *
+ * The period is doubled up to this value every time the inspection finds nothing.
+ */
+#ifndef USHELL_VCP_TIMER_INSPECT_PERIOD_MAX_MS
+    #define USHELL_VCP_TIMER_INSPECT_PERIOD_MAX_MS 16000U
+#endif
+
 /**
  * \brief Maximum number of active sockets in the uShell VCP for write operations.
  */
@@ -91,6 +110,29 @@ extern "C" {
     #define USHELL_VCP_ACTIVE_SESSION_MAX 6U
 #endif
 
+/**
+ * \brief Maximum number of the hal ports served by one uShell VCP.
+ *
+ * All the ports share the thread, the event group, the queue and the timer of the uShell VCP,
+ * so every next port costs only its sessions and buffers.
+ */
+#ifndef USHELL_VCP_PORT_MAX
+    #define USHELL_VCP_PORT_MAX 1U
+#endif
+
+/**
+ * \brief Number of the items the write session of the weight 1 sends per turn of the tx scheduler.
+ *
+ * The sessions of the same priority take turns by this quantum (multiplied by the weight), deficit round robin:
+ * every turn adds the quantum to the deficit of the session, the turn sends the written items while they fit
+ * the deficit and the rest of the deficit is carried to the next turn (it is dropped when the session has no more).
+ * The items are sent up to the end of a write (only a write longer than the stream is split by its chunks),
+ * and the rx is served after every turn.
+ */
+#ifndef USHELL_VCP_TX_QUANTUM
+    #define USHELL_VCP_TX_QUANTUM 64U
+#endif
+
 /*========================================================[DATA TYPES DEFINITIONS]==========================================*/
 
 /**
@@ -130,8 +172,9 @@ typedef enum
  */
 typedef struct
 {
-    UShellVcpItem_t buffer [USHELL_VCP_BUFFER_SIZE];    ///< Buffer for commands
-    size_t ind;                                         ///< Size of the buffer
+    UShellVcpItem_t buffer [USHELL_VCP_BUFFER_SIZE];      ///< Buffer for commands (the first transmit buffer)
+    size_t ind;                                           ///< Size of the buffer
+    UShellVcpItem_t txBuffer [USHELL_VCP_BUFFER_SIZE];    ///< Second transmit buffer (it is filled while the first one is sent)
 
 } UShellVcpIo_s;
 
@@ -143,6 +186,11 @@ typedef struct
 {
     void* owner;               ///< Owner of the session
     UShellVcpDirect_e type;    ///< Type of the socket (input or/and output)
+    uint8_t priority;          ///< Priority of the write session (the lower one waits while the higher one has the data)
+    uint8_t weight;            ///< Weight of the write session among the same priority (0 is 1), the quantum is weight * USHELL_VCP_TX_QUANTUM
+    size_t port;               ///< Index of the port of the session (0 is the port given to UShellVcpInit)
+    size_t size;               ///< Size of the stream of the session (0 is USHELL_VCP_BUFFER_SIZE), the write up to it is sent in one piece
+    void (*rxCb)(void* const owner);    ///< Called by the vcp thread when the input is put to the read session (NULL - not called)
 
 } UShellVcpSessionParam_s;
 
@@ -156,9 +204,25 @@ typedef struct
     UShellOsalStreamBuffHandle_t stream;    ///< Stream object for the uShell VCP object
     UShellSocket_s socket;                  ///< Read socket object
     bool used;                              ///< Flag to indicate if the session is used
+    size_t overrunCount;                    ///< Number of the received items lost because the stream was full (read session)
+    size_t txCount;                         ///< Number of the items taken from the stream (write session, compared to the write count of the socket)
+    size_t txDeficit;                       ///< Number of the items the write session may send by its next turn (deficit round robin)
 
 } UShellVcpSession_s;
 
+/**
+ * \brief Description of the uShell VCP port object
+ * \note This object is used to store the hal object and the sessions served on it
+ */
+typedef struct
+{
+    const UShellHal_s* hal;                                        ///< HAL object (NULL - the port is free)
+    UShellVcpSession_s session [USHELL_VCP_ACTIVE_SESSION_MAX];    ///< Session object for the port
+    UShellVcpIo_s io;                                              ///< IO object
+    size_t txNext;                                                 ///< Session checked first by the next turn of the tx scheduler
+
+} UShellVcpPort_s;
+
 /**
  * \brief Description of the uShell VCP object
  * \note This object is used to store the uShell VCP object
@@ -171,12 +235,11 @@ typedef struct
 
     /* Dependencies */
     const UShellOsal_s* osal;    ///< OSAL object
-    const UShellHal_s* hal;      ///< HAL object
 
     /* Internal use  */
-    UShellVcpSession_s session [USHELL_VCP_ACTIVE_SESSION_MAX];    ///< Session object for the uShell VCP object
-    UShellVcpIo_s io;                                              ///< IO object
-    bool usedForStdIO;                                             ///< Flag to indicate
+    UShellVcpPort_s port [USHELL_VCP_PORT_MAX];    ///< Ports served by the worker of the uShell VCP
+    bool usedForStdIO;                             ///< Flag to indicate
+    UShellOsalTimeMs_t inspectPeriodMs;            ///< Current period of the watchdog timer
 
 } UShellVcp_s;
 
@@ -208,6 +271,17 @@ UShellVcpErr_e UShellVcpInit(UShellVcp_s* const vcp,
  */
 UShellVcpErr_e UShellVcpDeInit(UShellVcp_s* const vcp);
 
+/**
+ * \brief Add one more hal port to the uShell vcp object (it is served by the same worker)
+ * \param[in] vcp - vcp object
+ * \param[in] hal - hal object of the port
+ * \param[out] port - index of the port (it is given to the sessions in UShellVcpSessionParam_s)
+ * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
+ */
+UShellVcpErr_e UShellVcpPortAdd(UShellVcp_s* const vcp,
+                                const UShellHal_s* const hal,
+                                size_t* const port);
+
 /**
  * \brief Open a session for the uShell vcp object
  * \param[in] vcp - uShell object to be opened
@@ -228,6 +302,26 @@ UShellVcpErr_e UShellVcpSessionOpen(UShellVcp_s* const vcp,
 UShellVcpErr_e UShellVcpSessionClose(UShellVcp_s* const vcp,
                                      const UShellVcpSessionParam_s param);
 
+/**
+ * \brief Wait until the vcp object is ready (the hal is open and the worker serves the sessions)
+ * \note This function is blocking, it returns at once if the vcp object is already ready.
+ * \param[in] vcp - vcp object
+ * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
+ */
+UShellVcpErr_e UShellVcpReadyWait(UShellVcp_s* const vcp);
+
+/**
+ * \brief Get the number of the received items lost by the read session (its stream was full)
+ * \note The counter is not cleared, the users take the difference.
+ * \param[in] vcp - vcp object
+ * \param[in] param - session parameter object (owner of the read session)
+ * \param[out] overrun - number of the lost items
+ * \return UShellVcpErr_e - error code. non-zero = an error has occurred;
+ */
+UShellVcpErr_e UShellVcpSessionOverrunGet(UShellVcp_s* const vcp,
+                                          const UShellVcpSessionParam_s param,
+                                          size_t* const overrun);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
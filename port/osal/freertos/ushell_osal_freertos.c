@@ -281,6 +281,13 @@ static UShellOsalErr_e uShellOsalFreertosStreamBuffIsEmpty(void* const osalFreer
                                                            const UShellOsalStreamBuffHandle_t streamBuffHandle,
                                                            bool* const isEmpty);
 
+/**
+ * \brief Get the free space of the stream buffer
+ */
+static UShellOsalErr_e uShellOsalFreertosStreamBuffSpaceGet(void* const osalFreertos,
+                                                            const UShellOsalStreamBuffHandle_t streamBuffHandle,
+                                                            size_t* const space);
+
 /**
  * \brief Reset a stream buffer to its initial empty state
  */
@@ -532,6 +539,9 @@ static const UShellOsalPortable_s FreeRtosPortable =
         .streamBuffReceiveBlocking = uShellOsalFreertosStreamBuffReceiveBlocking,
         .streamBuffSendBlocking = uShellOsalFreertosStreamBuffSendBlocking,
         .streamBuffIsEmpty = uShellOsalFreertosStreamBuffIsEmpty,
+        .streamBuffSpaceGet = uShellOsalFreertosStreamBuffSpaceGet,
+        .streamBuffReserve = NULL,    // The FreeRTOS stream buffer does not expose its storage
+        .streamBuffCommit = NULL,
         .timerCreate = uShellOsalFreertosTimerCreate,
         .timerDelete = uShellOsalFreertosTimerDelete,
         .timerStart = uShellOsalFreertosTimerStart,
@@ -2045,6 +2055,35 @@ static UShellOsalErr_e uShellOsalFreertosStreamBuffIsEmpty(void* const osalFreer
     return USHELL_OSAL_NO_ERR;    // Exit: no errors
 }
 
+/**
+ * \brief Get the free space of the stream buffer
+ */
+static UShellOsalErr_e uShellOsalFreertosStreamBuffSpaceGet(void* const osalFreertos,
+                                                            const UShellOsalStreamBuffHandle_t streamBuffHandle,
+                                                            size_t* const space)
+{
+    // Must be validated by the caller
+    USHELL_OSAL_FREERTOS_ASSERT(NULL != osalFreertos);
+    USHELL_OSAL_FREERTOS_ASSERT(NULL != streamBuffHandle);
+
+    // Find handle
+    uint16_t streamBuffIndexNum = uShellOsalFreertosFindStreamBuffHandle(osalFreertos, streamBuffHandle);
+    if (0 == streamBuffIndexNum)
+    {
+        return USHELL_OSAL_INVALID_ARGS;
+    }
+
+    if (USHELL_OSAL_STREAM_BUFF_SLOTS_NUM < streamBuffIndexNum)
+    {
+        return USHELL_OSAL_PORT_SPECIFIC_ERR;
+    }
+
+    // Return the free space
+    *space = xStreamBufferSpacesAvailable((UShellOsalStreamBuffHandle_t) streamBuffHandle);
+
+    return USHELL_OSAL_NO_ERR;    // Exit: no errors
+}
+
 /**
  * \brief Find the queue handle in the queue handles table
  * \param[in] osalFreeRtos - pointer to FreeRTOS osal instance
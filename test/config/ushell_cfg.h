@@ -17,11 +17,31 @@ extern "C" {
 
 // UShell configuration macros
 // Maximum number of commands in the UShell
-#define USHELL_MAX_CMD                          15
+#define USHELL_MAX_CMD                          64
 // UShell update time in milliseconds
 #define USHELL_UPD_TIME_MS                      100U
+// UShell worker waits for the input instead of polling
+#define USHELL_WORKER_EVENT_DRIVEN              TRUE
 // Size of the buffer in the UShell
 #define USHELL_BUFFER_SIZE                      256
+// Maximum number of input symbols taken from the read socket at once
+#define USHELL_INP_CHUNK_SIZE                   64U
+// Terminal width in columns
+#define USHELL_TERM_WIDTH                       80U
+// Maximum number of sessions (consoles) sharing one command registry
+#define USHELL_SESSION_MAX                      1U
+// Number of the threads executing the commands
+#define USHELL_CMD_WORKER_NUM                   1U
+// Size of the pipe buffer (output of the left command of "cmd | cmd")
+#define USHELL_PIPE_BUFFER_SIZE                 256U
+// Size of the input buffer of the running command (console input forwarded by the session)
+#define USHELL_CMD_INP_BUFFER_SIZE              256U
+// Size of the input typed ahead while the command which does not read the console runs
+#define USHELL_INP_TYPE_AHEAD_SIZE              256U
+// Maximum size of the machine mode frame (decoded)
+#define USHELL_MACHINE_FRAME_SIZE               128U
+// Number of the machine mode requests in flight per session
+#define USHELL_MACHINE_REQ_NUM                  4U
 // Password for authentication
 #define USHELL_AUTH_PASSWORD                    "admin"
 // UShell thread name
@@ -42,6 +62,10 @@ extern "C" {
 #define USHELL_AUTH_FAIL_MSG                    "Authentication FAIL \n"
 // Command not found message
 #define USHELL_CMD_NOT_FOUND_MSG                "Command not found \n"
+// Too many arguments message
+#define USHELL_CMD_ARGS_OVERFLOW_MSG            "Too many arguments \n"
+// Unterminated quote message
+#define USHELL_CMD_ARGS_SYNTAX_MSG              "Unterminated quote \n"
 
 // UShell VCP configuration macros
 // Maximum size of the buffer in the UShell VCP
@@ -56,10 +80,18 @@ extern "C" {
 #define USHELL_VCP_TX_TIMEOUT_MS                3000U
 // Redirect standard input/output to the uShell VCP
 #define USHELL_VCP_REDIRECT_STDIO               TRUE
+// Enable the watchdog timer which inspects the uShell VCP for the lost rx/tx events
+#define USHELL_VCP_WATCHDOG_ENABLE              TRUE
 // Timer name for the uShell VCP
 #define USHELL_VCP_TIMER_INSPECT_NAME           "USHELL_VCP_TIMER"
 // Timer period for the uShell VCP
 #define USHELL_VCP_TIMER_INSPECT_PERIOD_MS      1000U
+// The longest timer period for the uShell VCP (it is doubled while the inspection finds nothing)
+#define USHELL_VCP_TIMER_INSPECT_PERIOD_MAX_MS  16000U
+// Maximum number of the hal ports served by one uShell VCP (one thread for all of them)
+#define USHELL_VCP_PORT_MAX                     1U
+// Items sent per round by the write session of the weight 1 (tx scheduler quantum)
+#define USHELL_VCP_TX_QUANTUM                   64U
 
 // UShell history configuration macros
 // Maximum number of command strings stored in the history buffer
@@ -70,14 +102,28 @@ extern "C" {
 // UShell CMD configuration macros
 // Maximum number of arguments in the UShell command
 #define USHELL_CMD_MAX_ARGV                     5
+// Number of the buckets of the command duration histogram (stats)
+#define USHELL_CMD_STATS_BUCKET_NUM             16U
+
+// UShell Socket configuration macros
+// Size of the staging buffer of the formatted print (one stream send per fill)
+#define USHELL_SOCKET_PRINT_BUFF_SIZE           64U
+// Size of the gather buffer of the scatter-gather write (one stream send per message up to the size)
+#define USHELL_SOCKET_WRITEV_BUFF_SIZE          256U
+// Period of the check of the free space of the stream by the scatter-gather write (ms)
+#define USHELL_SOCKET_WRITEV_POLL_MS            1U
+// Size of the staging region of the reserved write (the OSAL port without the zero-copy stream)
+#define USHELL_SOCKET_RESERVE_SIZE              64U
+// Size of the scan lookahead (one stream receive per refill)
+#define USHELL_SOCKET_SCAN_BUFF_SIZE            32U
 
 // UShell OSAL configuration macros
 // Number of queue slots in the UShell OSAL
 #define USHELL_OSAL_QUEUE_SLOTS_NUM             (2)
 // Number of lock objects in the UShell OSAL
-#define USHELL_OSAL_LOCK_OBJS_NUM               (2)
+#define USHELL_OSAL_LOCK_OBJS_NUM               (3)
 // Number of threads in the UShell OSAL
-#define USHELL_OSAL_THREADS_NUM                 (1)
+#define USHELL_OSAL_THREADS_NUM                 (3)
 // Number of stream buffer slots in the UShell OSAL
 #define USHELL_OSAL_STREAM_BUFF_SLOTS_NUM       (6)
 // Number of timers in the UShell OSAL